@@ -0,0 +1,85 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  testCMCFastTarget.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDE
+#include <OpenSim/Common/Storage.h>
+#include <OpenSim/Tools/CMCTool.h>
+
+#include <catch2/catch_all.hpp>
+
+using namespace OpenSim;
+
+namespace {
+// Run CMC on the arm26 model over a short time range, and return the path
+// prefix of the result files.
+std::string runArm26(const std::string& name, bool useOnePassConstraintMatrix,
+        bool useActiveSetSolver) {
+    CMCTool cmc("arm26_Setup_CMC.xml");
+    cmc.setName(name);
+    cmc.setResultsDir("Results_" + name);
+    cmc.setFinalTime(0.5);
+    cmc.setUseFastTarget(true);
+    cmc.setUseOnePassConstraintMatrix(useOnePassConstraintMatrix);
+    cmc.setUseActiveSetSolver(useActiveSetSolver);
+    cmc.run();
+    return "Results_" + name + "/" + name;
+}
+
+void compareResults(const std::string& actualPrefix,
+        const std::string& expectedPrefix, const std::string& suffix,
+        double tolerance) {
+    const Storage actual(actualPrefix + suffix);
+    const Storage expected(expectedPrefix + suffix);
+    std::vector<std::string> columns;
+    std::vector<double> rmsErrors;
+    actual.compareWithStandard(expected, columns, rmsErrors);
+    REQUIRE(!columns.empty());
+    for (int i = 0; i < (int)columns.size(); ++i) {
+        INFO(suffix << " column " << columns[i]);
+        CHECK(rmsErrors[i] < tolerance);
+    }
+}
+} // anonymous namespace
+
+TEST_CASE("CMC fast target constraint matrix and active-set solver") {
+    // The arm26 tasks all track coordinates, so the fast target computes its
+    // constraint matrix in one pass unless told otherwise.
+    const std::string perturbation =
+            runArm26("arm26_perturbation", false, false);
+    const std::string onePass = runArm26("arm26_one_pass", true, false);
+    const std::string activeSet = runArm26("arm26_active_set", true, true);
+
+    // The constraint matrices are the same up to roundoff, so the optimizer
+    // finds the same controls.
+    compareResults(onePass, perturbation, "_controls.sto", 1e-4);
+    compareResults(onePass, perturbation, "_states.sto", 1e-4);
+
+    // The active-set method solves the same quadratic program as the
+    // optimizer, to within the optimizer's convergence tolerance.
+    compareResults(activeSet, onePass, "_controls.sto", 1e-2);
+    compareResults(activeSet, onePass, "_states.sto", 1e-2);
+
+    // Each time window of CMC is timed.
+    const Storage timing(onePass + "_timing.sto");
+    CHECK(timing.getSize() > 0);
+    CHECK(timing.getColumnLabels().getSize() == 6);
+}
@@ -70,6 +70,18 @@ int main()
             "testGait failed");
         cout << "testGait passed" << endl;
 
+        // Solving the time frames concurrently must not change the results.
+        InverseDynamicsTool id22("subject01_Setup_InverseDynamics.xml");
+        id22.setNumThreads(4);
+        id22.setOutputGenForceFileName(
+                "subject01_InverseDynamics_parallel.sto");
+        id22.run();
+        Storage result22("Results/subject01_InverseDynamics_parallel.sto");
+        CHECK_STORAGE_AGAINST_STANDARD(result2, result22,
+                std::vector<double>(23, 1e-8), __FILE__, __LINE__,
+                "testGait with multiple threads failed");
+        cout << "testGait with multiple threads passed" << endl;
+
         testThoracoscapularShoulderModel();
         cout << "testThoracoscapularShoulderModel passed" << endl;
         // Commented out testBallJoint due to sporadic crash in Model destructor
@@ -23,13 +23,16 @@
 
 
 // INCLUDES
+#include <OpenSim/Common/LogSink.h>
 #include <OpenSim/Common/Storage.h>
 #include "OpenSim/Common/STOFileAdapter.h"
 #include "OpenSim/Common/TRCFileAdapter.h"
 #include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Common/Stopwatch.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/OrientationsReference.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Tools/InverseKinematicsTool.h>
 #include <OpenSim/Tools/IKTaskSet.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
@@ -42,6 +45,12 @@ void checkMarkersReferenceConsistencyFromTool(InverseKinematicsTool& ik);
 
 void testInverseKinematicsSolverWithOrientations();
 void testInverseKinematicsSolverWithEulerAnglesFromFile();
+// Verify that sparse tracking matches tracking with the SimTK::Assembler, and
+// report the time taken by each.
+void testSparseTrackingGait2354();
+// Verify that sparse tracking converges, and matches the SimTK::Assembler,
+// when a clamped coordinate is held at the bound of its range.
+void testSparseTrackingWithClamp();
 
 int main()
 {
@@ -106,6 +115,24 @@ int main()
         failures.push_back("testInverseKinematicsGait2354_GUI_workflow");
     }
 
+    try {
+        ++itc;
+        testSparseTrackingGait2354();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testSparseTrackingGait2354");
+    }
+
+    try {
+        ++itc;
+        testSparseTrackingWithClamp();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testSparseTrackingWithClamp");
+    }
+
     try {
         InverseKinematicsTool ik3("constraintTest_setup_ik.xml");
         ik3.run();
@@ -489,3 +516,115 @@ void testInverseKinematicsSolverWithEulerAnglesFromFile()
     const TimeSeriesTable standard("std_subject01_walk1_ik.mot");
     compareMotionTables(report, standard);
 }
+
+void testSparseTrackingGait2354()
+{
+    InverseKinematicsTool ik("subject01_Setup_InverseKinematics.xml");
+    ik.setOutputMotionFileName("subject01_walk1_ik_assembler.mot");
+    Stopwatch watch;
+    ik.run();
+    const double assemblerTime = watch.getElapsedTime();
+
+    InverseKinematicsTool ikSparse("subject01_Setup_InverseKinematics.xml");
+    ikSparse.set_use_sparse_tracking(true);
+    ikSparse.setOutputMotionFileName("subject01_walk1_ik_sparse.mot");
+    watch.reset();
+    ikSparse.run();
+    const double sparseTime = watch.getElapsedTime();
+    cout << "testSparseTrackingGait2354: SimTK::Assembler took "
+         << assemblerTime << " s; sparse tracking took " << sparseTime
+         << " s." << endl;
+
+    // Both solvers minimize the same objective to the same accuracy.
+    Storage assembler(ik.getOutputMotionFileName());
+    Storage sparse(ikSparse.getOutputMotionFileName());
+    CHECK_STORAGE_AGAINST_STANDARD(sparse, assembler,
+            std::vector<double>(24, 0.05), __FILE__, __LINE__,
+            "testSparseTrackingGait2354 failed");
+    Storage standard("std_subject01_walk1_ik.mot");
+    CHECK_STORAGE_AGAINST_STANDARD(sparse, standard,
+            std::vector<double>(24, 0.2), __FILE__, __LINE__,
+            "testSparseTrackingGait2354 failed to match the standard");
+    cout << "testSparseTrackingGait2354 passed" << endl;
+}
+
+void testSparseTrackingWithClamp()
+{
+    // A double pendulum whose first coordinate is clamped to [0, 0.5] rad.
+    Model model;
+    model.setName("clamped_double_pendulum");
+    auto* upper = new OpenSim::Body("upper", 1, SimTK::Vec3(0, -0.5, 0),
+            SimTK::Inertia(0.1));
+    auto* lower = new OpenSim::Body("lower", 1, SimTK::Vec3(0, -0.5, 0),
+            SimTK::Inertia(0.1));
+    auto* shoulder = new PinJoint("shoulder", model.getGround(),
+            SimTK::Vec3(0), SimTK::Vec3(0), *upper, SimTK::Vec3(0),
+            SimTK::Vec3(0));
+    auto* elbow = new PinJoint("elbow", *upper, SimTK::Vec3(0, -1, 0),
+            SimTK::Vec3(0), *lower, SimTK::Vec3(0), SimTK::Vec3(0));
+    model.addBody(upper);
+    model.addBody(lower);
+    model.addJoint(shoulder);
+    model.addJoint(elbow);
+    Coordinate& clamped = shoulder->updCoordinate();
+    clamped.setRangeMin(0);
+    clamped.setRangeMax(0.5);
+    clamped.setDefaultClamped(true);
+    model.addMarker(new Marker("elbow", *upper, SimTK::Vec3(0, -1, 0)));
+    model.addMarker(new Marker("tip", *lower, SimTK::Vec3(0, -1, 0)));
+
+    // The markers are placed with the first coordinate outside its range.
+    SimTK::State state = model.initSystem();
+    std::vector<double> times{0, 0.1, 0.2};
+    TimeSeriesTable_<SimTK::Vec3> markerData;
+    markerData.setColumnLabels({"elbow", "tip"});
+    for (double time : times) {
+        shoulder->getCoordinate().setValue(state, 0.8 + time, false);
+        elbow->getCoordinate().setValue(state, 0.3 - time, false);
+        model.realizePosition(state);
+        const auto& markers = model.getMarkerSet();
+        markerData.appendRow(time,
+                {markers.get("elbow").getLocationInGround(state),
+                 markers.get("tip").getLocationInGround(state)});
+    }
+
+    const auto solve = [&](bool useSparseTracking) {
+        auto markersRef = std::make_shared<MarkersReference>(
+                markerData, Set<MarkerWeight>());
+        SimTK::Array_<CoordinateReference> coordinateRefs;
+        InverseKinematicsSolver ikSolver(
+                model, markersRef, nullptr, coordinateRefs);
+        ikSolver.setUseSparseTracking(useSparseTracking);
+        ikSolver.setAccuracy(1e-6);
+        SimTK::State s = model.initSystem();
+        std::vector<SimTK::Vec2> solution;
+        s.updTime() = times[0];
+        ikSolver.assemble(s);
+        for (double time : times) {
+            s.updTime() = time;
+            ikSolver.track(s);
+            solution.emplace_back(shoulder->getCoordinate().getValue(s),
+                    elbow->getCoordinate().getValue(s));
+        }
+        return solution;
+    };
+
+    auto sink = std::make_shared<StringLogSink>();
+    Logger::addSink(sink);
+    const auto sparse = solve(true);
+    Logger::removeSink(sink);
+    const auto assembler = solve(false);
+
+    OPENSIM_THROW_IF(sink->getString().find("did not converge") !=
+                             std::string::npos,
+            Exception,
+            "testSparseTrackingWithClamp: sparse tracking did not converge.");
+    for (int i = 0; i < (int)times.size(); ++i) {
+        ASSERT_EQUAL(0.5, sparse[i][0], 1e-10, __FILE__, __LINE__,
+                "testSparseTrackingWithClamp: the clamp is not active.");
+        ASSERT_EQUAL(assembler[i][1], sparse[i][1], 1e-4, __FILE__, __LINE__,
+                "testSparseTrackingWithClamp: sparse tracking does not match "
+                "the SimTK::Assembler.");
+    }
+    cout << "testSparseTrackingWithClamp passed" << endl;
+}
@@ -51,6 +51,7 @@ using namespace OpenSim;
 using std::cout; using std::endl;
 
 void scaleGait2354();
+void scaleGait2354Batch();
 void scaleGait2354_GUI(bool useMarkerPlacement);
 void scaleModelWithLigament();
 bool compareStdScaleToComputed(const ScaleSet& std, const ScaleSet& comp);
@@ -65,6 +66,7 @@ int main()
 {
     try {
         scaleGait2354();
+        scaleGait2354Batch();
         scaleGait2354_GUI(false);
         scaleModelWithLigament();
         scalePhysicalOffsetFrames();
@@ -206,6 +208,42 @@ void scaleGait2354()
                            "std_subject01_simbody.osim", 1.0e-6);
 }
 
+void scaleGait2354Batch()
+{
+    // Create a second subject that uses the same generic model but writes
+    // different result files.
+    ScaleTool subject2("subject01_Setup_Scale.xml");
+    subject2.setName("subject01_batch");
+    subject2.updModelScaler().setOutputScaleFileName(
+            "subject01_batch_scaleSet_applied.xml");
+    subject2.updModelScaler().setOutputModelFileName(
+            "subject01_batch_scaledOnly.osim");
+    subject2.updMarkerPlacer().setOutputModelFileName(
+            "subject01_batch_simbody.osim");
+    subject2.updMarkerPlacer().setOutputMotionFileName(
+            "subject01_batch_static_output.mot");
+    subject2.print("subject01_batch_Setup_Scale.xml");
+
+    const auto results = ScaleTool::runBatch(
+            {"subject01_Setup_Scale.xml", "subject01_batch_Setup_Scale.xml"},
+            2);
+    ASSERT(results.size() == 2);
+    for (const auto& result : results) {
+        ASSERT(result.success, __FILE__, __LINE__,
+                "Could not scale " + result.setupFile + ".");
+    }
+
+    // Both subjects match the result of scaling them one at a time.
+    ScaleSet stdScaleSet("std_subject01_scaleSet_applied.xml");
+    for (const std::string& scaleSetFile :
+            {"subject01_scaleSet_applied.xml",
+                    "subject01_batch_scaleSet_applied.xml"}) {
+        ASSERT(compareStdScaleToComputed(stdScaleSet, ScaleSet(scaleSetFile)));
+    }
+    compareModelToStandard("subject01_batch_simbody.osim",
+                           "std_subject01_simbody.osim", 1.0e-6);
+}
+
 void scaleGait2354_GUI(bool useMarkerPlacement)
 {
     // SET OUTPUT FORMATTING
@@ -21,6 +21,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include "opensim-cmd_batch.h"
 #include "opensim-cmd_info.h"
 #include "opensim-cmd_print-xml.h"
 #include "opensim-cmd_run-tool.h"
@@ -53,6 +54,7 @@ Options:
 
 Available commands:
   run-tool     Run a tool (e.g., Inverse Kinematics) from an XML setup file.
+  batch        Run many tools from the XML setup files listed in a manifest.
   print-xml    Print a template XML file for a Tool or class.
   info         Show description of properties in an OpenSim class.
   update-file  Update an .xml file (.osim or setup) to this version's format.
@@ -73,6 +75,7 @@ Description of options:
 
 Examples:
   opensim-cmd run-tool InverseDynamics_Setup.xml
+  opensim-cmd batch --jobs 8 cohort_setup_files.txt
   opensim-cmd print-xml cmc
   opensim-cmd info PathActuator
   opensim-cmd update-file lowerlimb_v3.3.osim lowerlimb_updated.osim
@@ -94,6 +97,7 @@ int main(int argc, const char** argv) {
 
     commands["print-xml"] = print_xml;
     commands["run-tool"] = run_tool;
+    commands["batch"] = batch;
     commands["info"] = info;
     commands["update-file"] = update_file;
     commands["viz"] = viz;
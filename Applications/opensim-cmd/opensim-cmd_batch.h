@@ -0,0 +1,411 @@
+#ifndef OPENSIM_CMD_BATCH_H_
+#define OPENSIM_CMD_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  opensim-cmd_batch.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#include <docopt.h>
+#include "opensim-cmd_run-tool.h"
+#include "parse_arguments.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+static const char HELP_BATCH[] =
+R"(Run many tools from the XML setup files listed in a manifest file.
+
+Usage:
+  opensim-cmd [options]... batch [--jobs=<n>] [--summary=<file>] <manifest-file>
+  opensim-cmd batch -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -o <level>, --log <level>  Logging level.
+  -j <n>, --jobs <n>  Maximum number of jobs to run at once [default: 1].
+  -s <file>, --summary <file>  Summary CSV file [default: batch_summary.csv].
+
+Description:
+  The manifest file lists one setup file per line; all tools supported by
+  run-tool are supported. Empty lines and lines starting with '#' are
+  ignored. Relative paths are relative to the directory of the manifest file.
+  Each job runs in the directory of its setup file, as if run-tool were
+  invoked from that directory.
+
+  Plugins are loaded and all setup files are read once, before any job runs.
+  Jobs that use the same model file in Inverse Kinematics or Inverse Dynamics
+  setup files share a single copy of the model that is read once, and Inverse
+  Dynamics jobs that use the same coordinates file share a single copy of the
+  coordinate data. Other data files (e.g., marker files, external loads, and
+  the data and models of other tools) are read by each job.
+
+  Each job runs in its own worker process, so that the working directory of
+  each job is independent and a job that fails or crashes does not affect the
+  other jobs. The console output of each job is written to a log file in the
+  'batch_logs' directory next to the summary file. On Windows, jobs run one
+  at a time in this process, and their output is shown in the console.
+
+  The summary contains a row for each job with its status, exit code, wall
+  time (seconds), and peak memory (resident set size, in MB). The exit code of
+  this command is 0 only if all jobs succeeded.
+
+Examples:
+  opensim-cmd batch cohort.txt
+  opensim-cmd batch --jobs 8 --summary results/summary.csv cohort.txt
+  opensim-cmd -L C:\Plugins\osimMyCustomForce.dll batch -j 4 cohort.txt
+)";
+
+namespace OpenSim {
+
+/// A setup file listed in the manifest of the batch command.
+struct BatchJob {
+    /// Absolute path of the setup file.
+    std::string setupFile;
+    std::unique_ptr<Object> setup;
+    /// Not empty if the job should use a model from the shared cache.
+    std::string modelKey;
+    /// Not empty if the job should use coordinate data from the shared cache.
+    std::string coordinatesKey;
+    std::string logFile;
+    std::string status = "not run";
+    int exitCode = EXIT_FAILURE;
+    double wallTime = SimTK::NaN;
+    double peakMemoryMB = SimTK::NaN;
+};
+
+inline bool batch_is_absolute_path(const std::string& path) {
+    return (!path.empty() && (path[0] == '/' || path[0] == '\\')) ||
+           (path.size() > 1 && path[1] == ':');
+}
+
+inline std::string batch_absolute_path(
+        const std::string& path, const std::string& relativeTo) {
+    if (batch_is_absolute_path(path)) return path;
+    const std::string dir = batch_is_absolute_path(relativeTo)
+                                    ? relativeTo
+                                    : IO::getCwd() + "/" + relativeTo;
+    return dir + (dir.empty() || dir.back() == '/' || dir.back() == '\\'
+                                 ? "" : "/") + path;
+}
+
+/// Return the setup files listed in the manifest, as absolute paths.
+inline std::vector<std::string> batch_read_manifest(
+        const std::string& manifestFile) {
+    std::ifstream manifest(manifestFile);
+    if (!manifest.good()) {
+        throw Exception("Could not open manifest file '" + manifestFile +
+                        "'.");
+    }
+    const std::string manifestDir = IO::getParentDirectory(manifestFile);
+    std::vector<std::string> setupFiles;
+    std::string line;
+    while (std::getline(manifest, line)) {
+        IO::TrimWhitespace(line);
+        if (line.empty() || line[0] == '#') continue;
+        setupFiles.push_back(batch_absolute_path(line, manifestDir));
+    }
+    return setupFiles;
+}
+
+/// The model file used by an Inverse Kinematics or Inverse Dynamics setup, or
+/// an empty string for other tools.
+inline std::string batch_get_model_file(const Object& setup) {
+    if (const auto* ik = dynamic_cast<const InverseKinematicsTool*>(&setup)) {
+        return ik->get_model_file();
+    }
+    if (const auto* id = dynamic_cast<const InverseDynamicsTool*>(&setup)) {
+        return id->getModelFileName();
+    }
+    return {};
+}
+
+/// The coordinates file used by an Inverse Dynamics setup, or an empty string
+/// for other tools.
+inline std::string batch_get_coordinates_file(const Object& setup) {
+    if (const auto* id = dynamic_cast<const InverseDynamicsTool*>(&setup)) {
+        const std::string& file = id->getCoordinatesFileName();
+        if (file != "Unassigned") return file;
+    }
+    return {};
+}
+
+/// Give the job's tool the shared coordinate data, if any.
+inline void batch_use_coordinates(
+        const BatchJob& job, const Storage* coordinates) {
+    if (!coordinates) return;
+    if (auto* id = dynamic_cast<InverseDynamicsTool*>(job.setup.get())) {
+        id->setCoordinateValues(*coordinates);
+    }
+}
+
+inline std::string batch_quote_csv(const std::string& field) {
+    return "\"" + IO::replaceSubstring(field, "\"", "\"\"") + "\"";
+}
+
+inline void batch_write_summary(const std::string& summaryFile,
+        const std::vector<BatchJob>& jobs) {
+    std::ofstream summary(summaryFile);
+    if (!summary.good()) {
+        throw Exception("Could not write summary file '" + summaryFile + "'.");
+    }
+    summary << "job,setup_file,tool,status,exit_code,wall_time_s,"
+               "peak_memory_mb,log_file\n";
+    for (int i = 0; i < (int)jobs.size(); ++i) {
+        const auto& job = jobs[i];
+        summary << fmt::format("{},{},{},{},{},{:.3f},{:.1f},{}\n", i + 1,
+                batch_quote_csv(job.setupFile),
+                job.setup ? job.setup->getConcreteClassName() : "",
+                batch_quote_csv(job.status), job.exitCode, job.wallTime,
+                job.peakMemoryMB, batch_quote_csv(job.logFile));
+    }
+}
+
+#ifndef _WIN32
+/// Run the job in a forked worker process, and return the process id. The
+/// worker inherits the loaded plugins, the deserialized setup, and the shared
+/// model and coordinate data (which it may modify without affecting the other
+/// jobs).
+inline pid_t batch_start_job(const BatchJob& job, Model* model,
+        const Storage* coordinates) {
+    const pid_t pid = fork();
+    if (pid != 0) return pid;
+
+    // This is the worker process.
+    int exitCode = EXIT_FAILURE;
+    if (std::freopen(job.logFile.c_str(), "w", stdout)) {
+        dup2(fileno(stdout), STDERR_FILENO);
+    }
+    try {
+        IO::chDir(IO::getParentDirectory(job.setupFile));
+        batch_use_coordinates(job, coordinates);
+        exitCode = run_tool_object(*job.setup, job.setupFile, model);
+    } catch (const std::exception& e) {
+        log_error(e.what());
+    }
+    std::fflush(nullptr);
+    // Do not run the destructors of the objects owned by the parent process.
+    _exit(exitCode);
+}
+#endif
+
+} // namespace OpenSim
+
+int batch(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_BATCH, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    const auto& manifestFile = args["<manifest-file>"].asString();
+    const auto& summaryFile = args["--summary"].asString();
+    const int numJobsAtOnce = std::stoi(args["--jobs"].asString());
+    if (numJobsAtOnce < 1) {
+        throw Exception("Expected --jobs to be at least 1, but got " +
+                        std::to_string(numJobsAtOnce) + ".");
+    }
+
+    // Read all setup files, and the models and data they share.
+    // ---------------------------------------------------------
+    const auto setupFiles = batch_read_manifest(manifestFile);
+    std::string logDir = IO::getParentDirectory(summaryFile) + "batch_logs";
+    IO::makeDir(logDir);
+    std::vector<BatchJob> jobs(setupFiles.size());
+    std::map<std::string, std::unique_ptr<Model>> models;
+    std::map<std::string, std::unique_ptr<Storage>> coordinates;
+    for (int i = 0; i < (int)jobs.size(); ++i) {
+        auto& job = jobs[i];
+        job.setupFile = setupFiles[i];
+        std::string name = IO::GetFileNameFromURI(job.setupFile);
+        job.logFile = batch_absolute_path(
+                fmt::format("{}/{}_{}.log", logDir, i + 1,
+                        name.substr(0, name.rfind('.'))),
+                "");
+        try {
+            job.setup.reset(Object::makeObjectFromFile(job.setupFile));
+        } catch (const std::exception& e) {
+            log_error("Could not read setup file '{}': {}", job.setupFile,
+                    e.what());
+        }
+        if (!job.setup) {
+            job.status = "invalid setup file";
+            continue;
+        }
+        const std::string coordinatesFile =
+                batch_get_coordinates_file(*job.setup);
+        if (!coordinatesFile.empty()) {
+            job.coordinatesKey = batch_absolute_path(
+                    coordinatesFile, IO::getParentDirectory(job.setupFile));
+        }
+        if (!job.coordinatesKey.empty() &&
+                !coordinates.count(job.coordinatesKey)) {
+            try {
+                auto cwd = IO::CwdChanger::changeToParentOf(job.setupFile);
+                coordinates[job.coordinatesKey] =
+                        std::make_unique<Storage>(coordinatesFile);
+                // As if the tool had read the file itself.
+                coordinates[job.coordinatesKey]->setName(coordinatesFile);
+            } catch (const std::exception& e) {
+                // The job reads the file itself and reports the error.
+                log_warn("Could not read coordinates file '{}': {}",
+                        job.coordinatesKey, e.what());
+                coordinates[job.coordinatesKey] = nullptr;
+            }
+        }
+
+        const std::string modelFile = batch_get_model_file(*job.setup);
+        if (modelFile.empty()) continue;
+        job.modelKey = batch_absolute_path(
+                modelFile, IO::getParentDirectory(job.setupFile));
+        if (models.count(job.modelKey)) continue;
+        try {
+            auto cwd = IO::CwdChanger::changeToParentOf(job.setupFile);
+            models[job.modelKey] = std::make_unique<Model>(modelFile);
+        } catch (const std::exception& e) {
+            // The job loads the model itself and reports the error.
+            log_warn("Could not read model file '{}': {}", job.modelKey,
+                    e.what());
+            models[job.modelKey] = nullptr;
+        }
+    }
+    log_info("Running {} job(s) from '{}'.", jobs.size(), manifestFile);
+
+    // Run the jobs.
+    // -------------
+    const auto reportJob = [&](int index) {
+        const auto& job = jobs[index];
+        log_info("[{}/{}] {} {} ({:.1f} s).", index + 1, jobs.size(),
+                job.setupFile, job.status, job.wallTime);
+    };
+#ifdef _WIN32
+    if (numJobsAtOnce > 1) {
+        log_warn("On Windows, batch jobs run one at a time.");
+    }
+    for (int i = 0; i < (int)jobs.size(); ++i) {
+        auto& job = jobs[i];
+        if (!job.setup) continue;
+        job.logFile.clear();
+        std::unique_ptr<Model> model;
+        if (!job.modelKey.empty() && models.at(job.modelKey)) {
+            model.reset(models.at(job.modelKey)->clone());
+        }
+        Stopwatch watch;
+        try {
+            auto cwd = IO::CwdChanger::changeToParentOf(job.setupFile);
+            if (!job.coordinatesKey.empty()) {
+                batch_use_coordinates(
+                        job, coordinates.at(job.coordinatesKey).get());
+            }
+            job.exitCode = run_tool_object(
+                    *job.setup, job.setupFile, model.get());
+            job.status = job.exitCode == EXIT_SUCCESS ? "succeeded" : "failed";
+        } catch (const std::exception& e) {
+            log_error(e.what());
+            job.exitCode = EXIT_FAILURE;
+            job.status = "failed";
+        }
+        job.wallTime = watch.getElapsedTime();
+        reportJob(i);
+    }
+#else
+    // Flush before forking so the workers do not repeat buffered output.
+    std::fflush(nullptr);
+    std::map<pid_t, std::pair<int, Stopwatch>> running;
+    int next = 0;
+    while (next < (int)jobs.size() || !running.empty()) {
+        while ((int)running.size() < numJobsAtOnce &&
+                next < (int)jobs.size()) {
+            const int index = next++;
+            auto& job = jobs[index];
+            if (!job.setup) continue;
+            Model* model = job.modelKey.empty()
+                                   ? nullptr
+                                   : models.at(job.modelKey).get();
+            const Storage* jobCoordinates =
+                    job.coordinatesKey.empty()
+                            ? nullptr
+                            : coordinates.at(job.coordinatesKey).get();
+            const pid_t pid = batch_start_job(job, model, jobCoordinates);
+            if (pid < 0) {
+                log_error("Could not start a worker process for '{}'.",
+                        job.setupFile);
+                job.status = "not started";
+                continue;
+            }
+            running.emplace(pid, std::make_pair(index, Stopwatch()));
+        }
+        if (running.empty()) continue;
+
+        int status = 0;
+        struct rusage usage;
+        const pid_t pid = wait4(-1, &status, 0, &usage);
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            throw Exception("Lost track of the batch worker processes.");
+        }
+        const auto it = running.find(pid);
+        if (it == running.end()) continue;
+        const int index = it->second.first;
+        auto& job = jobs[index];
+        job.wallTime = it->second.second.getElapsedTime();
+#ifdef __APPLE__
+        // ru_maxrss is in bytes on macOS and in kilobytes on Linux.
+        job.peakMemoryMB = usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+        job.peakMemoryMB = usage.ru_maxrss / 1024.0;
+#endif
+        if (WIFEXITED(status)) {
+            job.exitCode = WEXITSTATUS(status);
+            job.status = job.exitCode == EXIT_SUCCESS ? "succeeded" : "failed";
+        } else if (WIFSIGNALED(status)) {
+            job.exitCode = EXIT_FAILURE;
+            job.status = fmt::format("crashed (signal {})", WTERMSIG(status));
+        }
+        running.erase(it);
+        reportJob(index);
+    }
+#endif
+
+    // Summarize.
+    // ----------
+    batch_write_summary(summaryFile, jobs);
+    const auto numSucceeded = std::count_if(jobs.begin(), jobs.end(),
+            [](const BatchJob& job) { return job.status == "succeeded"; });
+    log_info("{} of {} job(s) succeeded. Wrote summary to '{}'.",
+            numSucceeded, jobs.size(), summaryFile);
+    for (const auto& job : jobs) {
+        if (job.status != "succeeded") {
+            log_error("Job '{}' {}.", job.setupFile, job.status);
+        }
+    }
+    return numSucceeded == (long)jobs.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // OPENSIM_CMD_BATCH_H_
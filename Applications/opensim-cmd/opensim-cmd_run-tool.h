@@ -63,24 +63,17 @@ Examples:
   opensim-cmd --library=libosimMyCustomForce.dylib run-tool CMC_setup.xml
 )";
 
-int run_tool(int argc, const char** argv) {
+namespace OpenSim {
 
-    using namespace OpenSim;
-
-    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
-            HELP_RUN_TOOL, { argv + 1, argv + argc },
-            true); // show help if requested
-
-    // Deserialize.
-    const auto& setupFile = args["<setup-xml-file>"].asString();
-    auto obj = std::unique_ptr<Object>(Object::makeObjectFromFile(setupFile));
-    if (obj == nullptr) {
-        throw Exception( "A problem occurred when trying to load file '" +
-                setupFile + "'.");
-    }
+/// Run the tool `obj` that was deserialized from the file `setupFile`. If
+/// `model` is provided, the tools that accept a model (Inverse Kinematics and
+/// Inverse Dynamics) use it instead of loading their model file; the model is
+/// modified by the tool.
+int run_tool_object(Object& obj, const std::string& setupFile,
+        Model* model = nullptr) {
 
     // Detect and run the tool.
-    if (auto* tool = dynamic_cast<AbstractTool*>(obj.get())) {
+    if (auto* tool = dynamic_cast<AbstractTool*>(&obj)) {
         // AbstractTool.
         // We must use the concrete class constructor, as it loads the model
         // (this also preserves the behavior of the previous command line
@@ -104,19 +97,26 @@ int run_tool(int argc, const char** argv) {
         const bool success = concreteTool->run();
         if (success) return EXIT_SUCCESS;
         else return EXIT_FAILURE;
-    } else if (auto* tool = dynamic_cast<Tool*>(obj.get())) {
+    } else if (auto* tool = dynamic_cast<Tool*>(&obj)) {
         // Tool.
         log_info("Preparing to run {}.", tool->getConcreteClassName());
+        if (model) {
+            if (auto* ik = dynamic_cast<InverseKinematicsToolBase*>(tool)) {
+                ik->setModel(*model);
+            } else if (auto* dynamics = dynamic_cast<DynamicsTool*>(tool)) {
+                dynamics->setModel(*model);
+            }
+        }
         const bool success = tool->run();
         if (success) return EXIT_SUCCESS;
         else return EXIT_FAILURE;
-    } else if (auto* scale = dynamic_cast<ScaleTool*>(obj.get())) {
+    } else if (auto* scale = dynamic_cast<ScaleTool*>(&obj)) {
         // ScaleTool.
         log_info("Preparing to run {}.", scale->getConcreteClassName());
         const bool success = scale->run();
         if (success) return EXIT_SUCCESS;
         else return EXIT_FAILURE;
-    } else if (auto* study = dynamic_cast<MocoStudy*>(obj.get())) {
+    } else if (auto* study = dynamic_cast<MocoStudy*>(&obj)) {
         log_info("Preparing to run {}.", study->getConcreteClassName());
         const auto solution = study->solve();
         if (solution.success()) return EXIT_SUCCESS;
@@ -129,4 +129,25 @@ int run_tool(int argc, const char** argv) {
     return EXIT_FAILURE;
 }
 
+} // namespace OpenSim
+
+int run_tool(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_TOOL, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    // Deserialize.
+    const auto& setupFile = args["<setup-xml-file>"].asString();
+    auto obj = std::unique_ptr<Object>(Object::makeObjectFromFile(setupFile));
+    if (obj == nullptr) {
+        throw Exception( "A problem occurred when trying to load file '" +
+                setupFile + "'.");
+    }
+
+    return run_tool_object(*obj, setupFile);
+}
+
 #endif // OPENSIM_CMD_RUN_TOOL_H_
@@ -23,6 +23,7 @@
 
 #include <SimTKcommon/Testing.h>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <regex>
@@ -349,6 +350,51 @@ void testRunTool() {
     testLoadPluginLibraries("run-tool");
 }
 
+void testBatch() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Run many tools ");
+        testCommand("batch -h", EXIT_SUCCESS, output);
+        testCommand("batch -help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("batch", EXIT_FAILURE,
+            ContainsSubstring("Arguments did not match expected patterns"));
+    testCommand("batch putes.txt", EXIT_FAILURE,
+            ContainsSubstring("Could not open manifest file 'putes.txt'."));
+    testCommand("batch --jobs 0 putes.txt", EXIT_FAILURE,
+            ContainsSubstring("Expected --jobs to be at least 1"));
+
+    // Failing jobs do not prevent the other jobs from running.
+    // ========================================================
+    // These setup files were created by testRunTool().
+    {
+        std::ofstream manifest("testbatch_manifest.txt");
+        manifest << "# Setup files that fail.\n"
+                 << "testruntool_cmc_setup.xml\n"
+                 << "\n"
+                 << "testruntool_Model.xml\n"
+                 << "putes.xml\n";
+    }
+    testCommand("batch --jobs 2 --summary testbatch_summary.csv "
+                "testbatch_manifest.txt",
+            EXIT_FAILURE,
+            std::regex(RE_ANY + "(Running 3 job\\(s\\))" + RE_ANY +
+                       "(0 of 3 job\\(s\\) succeeded)" + RE_ANY));
+    std::ifstream summary("testbatch_summary.csv");
+    std::string line;
+    int numLines = 0;
+    while (std::getline(summary, line)) ++numLines;
+    SimTK_TEST(numLines == 4);
+
+    // Library option.
+    // ===============
+    testLoadPluginLibraries("batch");
+}
+
 void testPrintXML() {
     // Help.
     // =====
@@ -494,6 +540,7 @@ int main() {
     SimTK_START_TEST("testCommandLineInterface");
         SimTK_SUBTEST(testNoCommand);
         SimTK_SUBTEST(testRunTool);
+        SimTK_SUBTEST(testBatch);
         SimTK_SUBTEST(testPrintXML);
         SimTK_SUBTEST(testInfo);
         SimTK_SUBTEST(testUpdateFile);
@@ -126,6 +126,7 @@ EXPOSE_BOUNDS_CONSTRUCTORS_HELPER(MocoFinalBounds);
         std::initializer_list<double>);
 
 %include <OpenSim/Moco/MocoTrajectory.h>
+%include <OpenSim/Moco/MocoTrajectoryLibrary.h>
 
 %include <OpenSim/Moco/MocoSolver.h>
 %include <OpenSim/Moco/MocoDirectCollocationSolver.h>
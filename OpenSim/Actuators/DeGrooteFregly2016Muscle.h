@@ -998,6 +998,10 @@ private:
     constexpr static int m_mdi_partialFiberForceAlongTendonPartialFiberLength =
             3;
     constexpr static int m_mdi_partialTendonForcePartialFiberLength = 4;
+
+    // The bank evaluates the curves of many muscles at once and fills the
+    // cache variables of each muscle.
+    friend class DeGrooteFregly2016MuscleBank;
 };
 
 } // namespace OpenSim
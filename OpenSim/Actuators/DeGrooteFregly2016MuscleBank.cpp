@@ -0,0 +1,539 @@
+/* -------------------------------------------------------------------------- *
+ *              OpenSim:  DeGrooteFregly2016MuscleBank.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DeGrooteFregly2016MuscleBank.h"
+
+using namespace OpenSim;
+
+using DGF = DeGrooteFregly2016Muscle;
+
+DeGrooteFregly2016MuscleBank::DeGrooteFregly2016MuscleBank() {
+    constructProperties();
+}
+
+void DeGrooteFregly2016MuscleBank::constructProperties() {
+    constructProperty_equilibrium_tolerance(1e-10);
+    constructProperty_equilibrium_max_iterations(100);
+    constructProperty_equilibrium_num_threads(1);
+}
+
+void DeGrooteFregly2016MuscleBank::Inputs::resize(int n) {
+    muscleTendonLength.resize(n);
+    muscleTendonVelocity.resize(n);
+    activation.resize(n);
+    normTendonForce.resize(n);
+    normTendonForceDerivative.resize(n);
+}
+
+void DeGrooteFregly2016MuscleBank::Outputs::resize(int n) {
+    for (auto* v : {&normTendonLength, &tendonLength, &fiberLengthAlongTendon,
+                 &fiberLength, &normFiberLength, &cosPennationAngle,
+                 &sinPennationAngle, &pennationAngle,
+                 &fiberPassiveForceLengthMultiplier,
+                 &fiberActiveForceLengthMultiplier, &normTendonVelocity,
+                 &tendonVelocity, &fiberVelocityAlongTendon, &fiberVelocity,
+                 &normFiberVelocity, &pennationAngularVelocity,
+                 &fiberForceVelocityMultiplier, &activeFiberForce,
+                 &passiveFiberElasticForce, &passiveFiberDampingForce,
+                 &fiberForce, &fiberForceAlongTendon, &normTendonForce,
+                 &tendonForce, &fiberStiffness, &fiberStiffnessAlongTendon,
+                 &tendonStiffness, &partialPennationAnglePartialFiberLength,
+                 &partialFiberForceAlongTendonPartialFiberLength,
+                 &partialTendonForcePartialFiberLength, &fiberActivePower,
+                 &fiberPassivePower, &tendonPower, &equilibriumResidual,
+                 &linearizedEquilibriumResidualDerivative}) {
+        v->resize(n);
+    }
+}
+
+const DeGrooteFregly2016Muscle& DeGrooteFregly2016MuscleBank::getMuscle(
+        int index) const {
+    OPENSIM_THROW_IF(index < 0 || index >= getNumMuscles(), IndexOutOfRange,
+            index, 0, getNumMuscles() - 1);
+    return *m_muscles[index];
+}
+
+void DeGrooteFregly2016MuscleBank::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+
+    m_muscles.clear();
+    for (const auto& muscle :
+            model.getComponentList<DeGrooteFregly2016Muscle>()) {
+        m_muscles.emplace_back(&muscle);
+    }
+    const int n = getNumMuscles();
+    for (auto* v : {&m_maxIsometricForce, &m_optimalFiberLength,
+                 &m_tendonSlackLength, &m_fiberWidth,
+                 &m_maxContractionVelocity, &m_fiberDamping,
+                 &m_activeForceWidthScale, &m_passiveFiberStrain,
+                 &m_passiveForceScale, &m_passiveForceOffset,
+                 &m_passiveForceDenominator, &m_tendonStiffnessParameter,
+                 &m_ignoreTendonCompliance, &m_isTendonDynamicsExplicit}) {
+        v->resize(n);
+    }
+    for (int i = 0; i < n; ++i) {
+        const auto& muscle = *m_muscles[i];
+        m_maxIsometricForce[i] = muscle.get_max_isometric_force();
+        m_optimalFiberLength[i] = muscle.get_optimal_fiber_length();
+        m_tendonSlackLength[i] = muscle.get_tendon_slack_length();
+        m_fiberWidth[i] = muscle.getFiberWidth();
+        m_maxContractionVelocity[i] =
+                muscle.getMaxContractionVelocityInMetersPerSecond();
+        m_fiberDamping[i] = muscle.get_fiber_damping();
+        m_activeForceWidthScale[i] = muscle.get_active_force_width_scale();
+        const double e0 = muscle.get_passive_fiber_strain_at_one_norm_force();
+        m_passiveFiberStrain[i] = e0;
+        m_passiveForceScale[i] = muscle.get_ignore_passive_fiber_force() ? 0 : 1;
+        m_passiveForceOffset[i] =
+                exp(DGF::kPE * (DGF::m_minNormFiberLength - 1.0) / e0);
+        m_passiveForceDenominator[i] =
+                exp(DGF::kPE) - m_passiveForceOffset[i];
+        m_tendonStiffnessParameter[i] = muscle.getTendonStiffnessParameter();
+        m_ignoreTendonCompliance[i] =
+                muscle.get_ignore_tendon_compliance() ? 1 : 0;
+        m_isTendonDynamicsExplicit[i] =
+                muscle.m_isTendonDynamicsExplicit ? 1 : 0;
+    }
+}
+
+void DeGrooteFregly2016MuscleBank::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+    Workspace workspace;
+    workspace.inputs.resize(getNumMuscles());
+    workspace.outputs.resize(getNumMuscles());
+    this->m_workspaceCV = addCacheVariable(
+            "workspace", workspace, SimTK::Stage::Dynamics);
+}
+
+void DeGrooteFregly2016MuscleBank::getInputs(
+        const SimTK::State& s, Inputs& inputs) const {
+    const int n = getNumMuscles();
+    inputs.resize(n);
+    for (int i = 0; i < n; ++i) {
+        const auto& muscle = *m_muscles[i];
+        inputs.muscleTendonLength[i] = muscle.getLength(s);
+        inputs.muscleTendonVelocity[i] = muscle.getLengtheningSpeed(s);
+        inputs.activation[i] = muscle.getActivation(s);
+        inputs.normTendonForce[i] = SimTK::NaN;
+        inputs.normTendonForceDerivative[i] = SimTK::NaN;
+        if (!muscle.get_ignore_tendon_compliance()) {
+            inputs.normTendonForce[i] = muscle.getStateVariableValue(
+                    s, DGF::STATE_NORMALIZED_TENDON_FORCE_NAME);
+            if (!muscle.m_isTendonDynamicsExplicit) {
+                inputs.normTendonForceDerivative[i] =
+                        muscle.getDiscreteVariableValue(
+                                s, DGF::DERIVATIVE_NORMALIZED_TENDON_FORCE_NAME);
+            }
+        }
+    }
+}
+
+void DeGrooteFregly2016MuscleBank::calcDynamics(
+        const Inputs& inputs, Outputs& outputs) const {
+    outputs.resize(getNumMuscles());
+    calcDynamicsImpl(inputs, false, outputs, 0, getNumMuscles());
+}
+
+void DeGrooteFregly2016MuscleBank::calcEquilibriumResiduals(
+        const Inputs& inputs, Outputs& outputs) const {
+    outputs.resize(getNumMuscles());
+    calcDynamicsImpl(inputs, true, outputs, 0, getNumMuscles());
+}
+
+BatchRootSolveStatistics DeGrooteFregly2016MuscleBank::equilibrateMuscles(
+        SimTK::State& s) const {
+    getModel().realizeVelocity(s);
+
+    // Only muscles with compliant tendons have an equilibrium to solve for.
+    std::vector<int> indices;
+    for (int i = 0; i < getNumMuscles(); ++i) {
+        if (m_ignoreTendonCompliance[i] == 0 && m_muscles[i]->appliesForce(s)) {
+            indices.push_back(i);
+        }
+    }
+    const int numProblems = (int)indices.size();
+
+    // As in DeGrooteFregly2016Muscle::computeInitialFiberEquilibrium(), use
+    // the implicit form of the model with a zero normalized tendon force
+    // derivative.
+    Inputs inputs;
+    getInputs(s, inputs);
+    std::fill(inputs.normTendonForceDerivative.begin(),
+            inputs.normTendonForceDerivative.end(), 0.0);
+    Outputs outputs;
+    outputs.resize(getNumMuscles());
+
+    std::vector<double> normTendonForce(numProblems);
+    for (int j = 0; j < numProblems; ++j) {
+        normTendonForce[j] = inputs.normTendonForce[indices[j]];
+    }
+    // Each range of problems maps to a disjoint range of muscles, so ranges
+    // can be computed concurrently.
+    const auto calcResiduals = [&](int begin, int end,
+                                       const std::vector<double>& x,
+                                       std::vector<double>& residual,
+                                       std::vector<double>& derivative) {
+        for (int j = begin; j < end; ++j) {
+            inputs.normTendonForce[indices[j]] = x[j];
+        }
+        calcDynamicsImpl(inputs, true, outputs, indices[begin],
+                indices[end - 1] + 1);
+        for (int j = begin; j < end; ++j) {
+            const int i = indices[j];
+            residual[j] = outputs.equilibriumResidual[i];
+            // The derivative of the residual with respect to normalized
+            // tendon force, neglecting the dependence of fiber velocity on
+            // pennation.
+            derivative[j] = 1.0 + outputs.fiberStiffnessAlongTendon[i] /
+                                          outputs.tendonStiffness[i];
+        }
+    };
+    const auto stats = solveNewtonBisectionBatch(calcResiduals,
+            normTendonForce,
+            std::vector<double>(numProblems, DGF::m_minNormTendonForce),
+            std::vector<double>(numProblems, DGF::m_maxNormTendonForce),
+            get_equilibrium_tolerance(), get_equilibrium_max_iterations(),
+            get_equilibrium_num_threads());
+
+    std::vector<std::string> failed;
+    for (int j = 0; j < numProblems; ++j) {
+        const auto& muscle = *m_muscles[indices[j]];
+        if (!stats.bracketed[j]) {
+            failed.push_back(muscle.getName());
+            continue;
+        }
+        if (!stats.converged[j]) {
+            log_warn("DeGrooteFregly2016MuscleBank: equilibrium of muscle "
+                     "'{}' did not converge within {} iterations.",
+                    muscle.getName(), get_equilibrium_max_iterations());
+        }
+        muscle.setNormalizedTendonForce(s, normTendonForce[j]);
+    }
+    OPENSIM_THROW_IF_FRMOBJ(!failed.empty(), Exception,
+            "Could not find muscle-tendon equilibrium for muscles: {}. The "
+            "equilibrium residual has the same sign at the bounds of "
+            "normalized tendon force ({} and {}).",
+            fmt::join(failed, ", "), DGF::m_minNormTendonForce,
+            DGF::m_maxNormTendonForce);
+    return stats;
+}
+
+void DeGrooteFregly2016MuscleBank::calcDynamicsImpl(const Inputs& in,
+        bool implicitCompliant, Outputs& out, int begin, int end) const {
+    using SimTK::square;
+    const int n = getNumMuscles();
+    OPENSIM_THROW_IF_FRMOBJ((int)in.muscleTendonLength.size() != n ||
+                                    (int)in.muscleTendonVelocity.size() != n ||
+                                    (int)in.activation.size() != n ||
+                                    (int)in.normTendonForce.size() != n ||
+                                    (int)in.normTendonForceDerivative.size() !=
+                                            n,
+            Exception, "Expected inputs for {} muscles.", n);
+
+    // This loop mirrors the calc*InfoHelper() methods of
+    // DeGrooteFregly2016Muscle. It has no branches: quantities for both
+    // tendon modes are computed and then selected arithmetically, so that the
+    // loop can be vectorized.
+    const double flagScale = implicitCompliant ? 0.0 : 1.0;
+    for (int i = begin; i < end; ++i) {
+        const double rigid = flagScale * m_ignoreTendonCompliance[i];
+        const double explicitMode =
+                flagScale * m_isTendonDynamicsExplicit[i] * (1.0 - rigid);
+        const double maxIsometricForce = m_maxIsometricForce[i];
+        const double tendonSlackLength = m_tendonSlackLength[i];
+        const double fiberWidth = m_fiberWidth[i];
+        const double kT = m_tendonStiffnessParameter[i];
+        const double activation = in.activation[i];
+        const double muscleTendonVelocity = in.muscleTendonVelocity[i];
+        // Use a harmless value for rigid tendons to avoid log(NaN).
+        const double normTendonForce =
+                rigid == 1.0 ? 0.0 : in.normTendonForce[i];
+
+        // Length.
+        // -------
+        const double normTendonLength =
+                rigid + (1.0 - rigid) *
+                                (log((normTendonForce + DGF::c3) / DGF::c1) /
+                                                kT +
+                                        DGF::c2);
+        const double tendonLength = tendonSlackLength * normTendonLength;
+        const double fiberLengthAlongTendon =
+                in.muscleTendonLength[i] - tendonLength;
+        const double fiberLength = sqrt(
+                square(fiberLengthAlongTendon) + square(fiberWidth));
+        const double normFiberLength = fiberLength / m_optimalFiberLength[i];
+        const double cosPennationAngle = fiberLengthAlongTendon / fiberLength;
+        const double sinPennationAngle = fiberWidth / fiberLength;
+
+        const double e0 = m_passiveFiberStrain[i];
+        const double passiveExp = exp(DGF::kPE * (normFiberLength - 1.0) / e0);
+        const double passiveMultiplier = m_passiveForceScale[i] *
+                                         (passiveExp - m_passiveForceOffset[i]) /
+                                         m_passiveForceDenominator[i];
+        const double passiveMultiplierDerivative =
+                m_passiveForceScale[i] * DGF::kPE * passiveExp /
+                (e0 * m_passiveForceDenominator[i]);
+
+        const double scale = m_activeForceWidthScale[i];
+        const double x = (normFiberLength - 1.0) / scale + 1.0;
+        const double activeMultiplier =
+                DGF::calcGaussianLikeCurve(
+                        x, DGF::b11, DGF::b21, DGF::b31, DGF::b41) +
+                DGF::calcGaussianLikeCurve(
+                        x, DGF::b12, DGF::b22, DGF::b32, DGF::b42) +
+                DGF::calcGaussianLikeCurve(
+                        x, DGF::b13, DGF::b23, DGF::b33, DGF::b43);
+        const double activeMultiplierDerivative =
+                (1.0 / scale) *
+                (DGF::calcGaussianLikeCurveDerivative(
+                         x, DGF::b11, DGF::b21, DGF::b31, DGF::b41) +
+                        DGF::calcGaussianLikeCurveDerivative(
+                                x, DGF::b12, DGF::b22, DGF::b32, DGF::b42) +
+                        DGF::calcGaussianLikeCurveDerivative(
+                                x, DGF::b13, DGF::b23, DGF::b33, DGF::b43));
+
+        // Velocity.
+        // ---------
+        const double maxContractionVelocity = m_maxContractionVelocity[i];
+        // Explicit tendon compliance dynamics: the fiber velocity follows
+        // from inverting the force-velocity curve.
+        const double explicitForceVelocityMultiplier =
+                (normTendonForce / cosPennationAngle - passiveMultiplier) /
+                (activation * activeMultiplier);
+        const double explicitNormFiberVelocity =
+                DGF::calcForceVelocityInverseCurve(
+                        explicitForceVelocityMultiplier);
+        const double explicitFiberVelocity =
+                explicitNormFiberVelocity * maxContractionVelocity;
+        const double explicitFiberVelocityAlongTendon =
+                explicitFiberVelocity / cosPennationAngle;
+        // Implicit tendon compliance dynamics (or a rigid tendon): the tendon
+        // velocity follows from the normalized tendon force derivative.
+        const double tendonForceMultiplierDerivative =
+                DGF::c1 * kT * exp(kT * (normTendonLength - DGF::c2));
+        const double implicitNormTendonVelocity =
+                rigid == 1.0 ? 0.0
+                             : in.normTendonForceDerivative[i] /
+                                       tendonForceMultiplierDerivative;
+        const double implicitFiberVelocityAlongTendon =
+                muscleTendonVelocity -
+                tendonSlackLength * implicitNormTendonVelocity;
+        const double implicitFiberVelocity =
+                implicitFiberVelocityAlongTendon * cosPennationAngle;
+
+        const double fiberVelocity =
+                explicitMode == 1.0 ? explicitFiberVelocity
+                                    : implicitFiberVelocity;
+        const double fiberVelocityAlongTendon =
+                explicitMode == 1.0 ? explicitFiberVelocityAlongTendon
+                                    : implicitFiberVelocityAlongTendon;
+        const double tendonVelocity =
+                muscleTendonVelocity - fiberVelocityAlongTendon;
+        const double normFiberVelocity =
+                explicitMode == 1.0 ? explicitNormFiberVelocity
+                                    : fiberVelocity / maxContractionVelocity;
+        const double forceVelocityMultiplier =
+                explicitMode == 1.0
+                        ? explicitForceVelocityMultiplier
+                        : DGF::calcForceVelocityMultiplier(normFiberVelocity);
+
+        // Forces.
+        // -------
+        const double activeFiberForce = maxIsometricForce * activation *
+                                        activeMultiplier *
+                                        forceVelocityMultiplier;
+        const double passiveElasticForce =
+                maxIsometricForce * passiveMultiplier;
+        const double passiveDampingForce =
+                maxIsometricForce * m_fiberDamping[i] * normFiberVelocity;
+        const double fiberForce =
+                activeFiberForce + passiveElasticForce + passiveDampingForce;
+        const double fiberForceAlongTendon = fiberForce * cosPennationAngle;
+        const double normTendonForceOut =
+                rigid == 1.0 ? fiberForce / maxIsometricForce *
+                                       cosPennationAngle
+                             : normTendonForce;
+        const double tendonForce =
+                rigid == 1.0 ? fiberForceAlongTendon
+                             : maxIsometricForce * normTendonForce;
+
+        // Stiffness.
+        // ----------
+        const double fiberStiffness =
+                maxIsometricForce / m_optimalFiberLength[i] *
+                (activation * activeMultiplierDerivative *
+                                forceVelocityMultiplier +
+                        passiveMultiplierDerivative);
+        const double partialPennationAnglePartialFiberLength =
+                (-fiberWidth / square(fiberLength)) /
+                sqrt(1.0 - square(sinPennationAngle));
+        const double partialFiberForceAlongTendonPartialFiberLength =
+                fiberStiffness * cosPennationAngle -
+                fiberForce * sinPennationAngle *
+                        partialPennationAnglePartialFiberLength;
+        const double partialFiberLengthAlongTendonPartialFiberLength =
+                cosPennationAngle - fiberLength * sinPennationAngle *
+                        partialPennationAnglePartialFiberLength;
+        const double fiberStiffnessAlongTendon =
+                partialFiberForceAlongTendonPartialFiberLength /
+                partialFiberLengthAlongTendonPartialFiberLength;
+        const double tendonStiffness =
+                rigid == 1.0 ? SimTK::Infinity
+                             : maxIsometricForce / tendonSlackLength *
+                                       tendonForceMultiplierDerivative;
+
+        // Store results.
+        // --------------
+        out.normTendonLength[i] = normTendonLength;
+        out.tendonLength[i] = tendonLength;
+        out.fiberLengthAlongTendon[i] = fiberLengthAlongTendon;
+        out.fiberLength[i] = fiberLength;
+        out.normFiberLength[i] = normFiberLength;
+        out.cosPennationAngle[i] = cosPennationAngle;
+        out.sinPennationAngle[i] = sinPennationAngle;
+        out.pennationAngle[i] = asin(sinPennationAngle);
+        out.fiberPassiveForceLengthMultiplier[i] = passiveMultiplier;
+        out.fiberActiveForceLengthMultiplier[i] = activeMultiplier;
+
+        out.normTendonVelocity[i] = tendonVelocity / tendonSlackLength;
+        out.tendonVelocity[i] = tendonVelocity;
+        out.fiberVelocityAlongTendon[i] = fiberVelocityAlongTendon;
+        out.fiberVelocity[i] = fiberVelocity;
+        out.normFiberVelocity[i] = normFiberVelocity;
+        out.pennationAngularVelocity[i] = -fiberVelocity / fiberLength *
+                                          fiberWidth / fiberLengthAlongTendon;
+        out.fiberForceVelocityMultiplier[i] = forceVelocityMultiplier;
+
+        out.activeFiberForce[i] = activeFiberForce;
+        out.passiveFiberElasticForce[i] = passiveElasticForce;
+        out.passiveFiberDampingForce[i] = passiveDampingForce;
+        out.fiberForce[i] = fiberForce;
+        out.fiberForceAlongTendon[i] = fiberForceAlongTendon;
+        out.normTendonForce[i] = normTendonForceOut;
+        out.tendonForce[i] = tendonForce;
+
+        out.fiberStiffness[i] = fiberStiffness;
+        out.fiberStiffnessAlongTendon[i] = fiberStiffnessAlongTendon;
+        out.tendonStiffness[i] = tendonStiffness;
+        out.partialPennationAnglePartialFiberLength[i] =
+                partialPennationAnglePartialFiberLength;
+        out.partialFiberForceAlongTendonPartialFiberLength[i] =
+                partialFiberForceAlongTendonPartialFiberLength;
+        out.partialTendonForcePartialFiberLength[i] =
+                tendonStiffness *
+                (fiberLength * sinPennationAngle *
+                                partialPennationAnglePartialFiberLength -
+                        cosPennationAngle);
+
+        out.fiberActivePower[i] =
+                -(activeFiberForce + passiveDampingForce) * fiberVelocity;
+        out.fiberPassivePower[i] = -passiveElasticForce * fiberVelocity;
+        out.tendonPower[i] = -tendonForce * tendonVelocity;
+
+        out.equilibriumResidual[i] =
+                (1.0 - explicitMode) *
+                (normTendonForceOut - fiberForceAlongTendon / maxIsometricForce);
+        out.linearizedEquilibriumResidualDerivative[i] =
+                fiberStiffnessAlongTendon * fiberVelocityAlongTendon -
+                tendonStiffness *
+                        (muscleTendonVelocity - fiberVelocityAlongTendon);
+    }
+}
+
+void DeGrooteFregly2016MuscleBank::extendRealizeDynamics(
+        const SimTK::State& s) const {
+    Super::extendRealizeDynamics(s);
+    if (m_muscles.empty()) return;
+
+    // The workspace only holds intermediate values, so it is never marked
+    // valid.
+    auto& workspace = updCacheVariableValue(s, m_workspaceCV);
+    getInputs(s, workspace.inputs);
+    calcDynamicsImpl(workspace.inputs, false, workspace.outputs, 0,
+            getNumMuscles());
+
+    const auto& out = workspace.outputs;
+    for (int i = 0; i < getNumMuscles(); ++i) {
+        const auto& muscle = *m_muscles[i];
+
+        auto& mli = muscle.updMuscleLengthInfo(s);
+        mli.normTendonLength = out.normTendonLength[i];
+        mli.tendonStrain = out.normTendonLength[i] - 1.0;
+        mli.tendonLength = out.tendonLength[i];
+        mli.fiberLengthAlongTendon = out.fiberLengthAlongTendon[i];
+        mli.fiberLength = out.fiberLength[i];
+        mli.normFiberLength = out.normFiberLength[i];
+        mli.cosPennationAngle = out.cosPennationAngle[i];
+        mli.sinPennationAngle = out.sinPennationAngle[i];
+        mli.pennationAngle = out.pennationAngle[i];
+        mli.fiberPassiveForceLengthMultiplier =
+                out.fiberPassiveForceLengthMultiplier[i];
+        mli.fiberActiveForceLengthMultiplier =
+                out.fiberActiveForceLengthMultiplier[i];
+        muscle.markCacheVariableValid(s, "lengthInfo");
+
+        auto& fvi = muscle.updFiberVelocityInfo(s);
+        fvi.normTendonVelocity = out.normTendonVelocity[i];
+        fvi.tendonVelocity = out.tendonVelocity[i];
+        fvi.fiberVelocityAlongTendon = out.fiberVelocityAlongTendon[i];
+        fvi.fiberVelocity = out.fiberVelocity[i];
+        fvi.normFiberVelocity = out.normFiberVelocity[i];
+        fvi.pennationAngularVelocity = out.pennationAngularVelocity[i];
+        fvi.fiberForceVelocityMultiplier =
+                out.fiberForceVelocityMultiplier[i];
+        muscle.markCacheVariableValid(s, "velInfo");
+
+        auto& mdi = muscle.updMuscleDynamicsInfo(s);
+        mdi.activation = workspace.inputs.activation[i];
+        mdi.fiberForce = out.fiberForce[i];
+        mdi.activeFiberForce = out.activeFiberForce[i];
+        mdi.passiveFiberForce =
+                out.passiveFiberElasticForce[i] + out.passiveFiberDampingForce[i];
+        mdi.normFiberForce = out.fiberForce[i] / m_maxIsometricForce[i];
+        mdi.fiberForceAlongTendon = out.fiberForceAlongTendon[i];
+        mdi.normTendonForce = out.normTendonForce[i];
+        mdi.tendonForce = out.tendonForce[i];
+        mdi.fiberStiffness = out.fiberStiffness[i];
+        mdi.fiberStiffnessAlongTendon = out.fiberStiffnessAlongTendon[i];
+        mdi.tendonStiffness = out.tendonStiffness[i];
+        mdi.fiberActivePower = out.fiberActivePower[i];
+        mdi.fiberPassivePower = out.fiberPassivePower[i];
+        mdi.tendonPower = out.tendonPower[i];
+        mdi.userDefinedDynamicsExtras.resize(5);
+        mdi.userDefinedDynamicsExtras[DGF::m_mdi_passiveFiberElasticForce] =
+                out.passiveFiberElasticForce[i];
+        mdi.userDefinedDynamicsExtras[DGF::m_mdi_passiveFiberDampingForce] =
+                out.passiveFiberDampingForce[i];
+        mdi.userDefinedDynamicsExtras
+                [DGF::m_mdi_partialPennationAnglePartialFiberLength] =
+                out.partialPennationAnglePartialFiberLength[i];
+        mdi.userDefinedDynamicsExtras
+                [DGF::m_mdi_partialFiberForceAlongTendonPartialFiberLength] =
+                out.partialFiberForceAlongTendonPartialFiberLength[i];
+        mdi.userDefinedDynamicsExtras
+                [DGF::m_mdi_partialTendonForcePartialFiberLength] =
+                out.partialTendonForcePartialFiberLength[i];
+        muscle.markCacheVariableValid(s, "dynamicsInfo");
+    }
+}
@@ -0,0 +1,230 @@
+#ifndef OPENSIM_DEGROOTEFREGLY2016MUSCLEBANK_H
+#define OPENSIM_DEGROOTEFREGLY2016MUSCLEBANK_H
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  DeGrooteFregly2016MuscleBank.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+#include <OpenSim/Simulation/Model/MuscleBank.h>
+
+namespace OpenSim {
+
+/** Evaluate all DeGrooteFregly2016Muscle%s in a model at once.
+
+When added to a model, this component gathers the parameters of every
+DeGrooteFregly2016Muscle in the model into contiguous arrays (one array per
+parameter) when the model is connected. The curves of this muscle model are
+closed-form, so the fiber and tendon kinematics, forces, stiffnesses, and
+muscle-tendon equilibrium residuals of all muscles are computed in a single
+pass over these arrays, without branches or virtual calls, which allows
+compilers to vectorize the computation.
+
+During realizeDynamics(), the bank computes the MuscleLengthInfo,
+FiberVelocityInfo, and MuscleDynamicsInfo of every muscle and stores them in
+the muscles' cache variables, before the forces of the model are computed.
+Therefore, the muscles and their Output%s are used exactly as without the
+bank, and the results are identical to those computed by each muscle.
+
+@code{.cpp}
+model.addComponent(new DeGrooteFregly2016MuscleBank());
+@endcode
+
+The calcDynamics() and calcEquilibriumResiduals() methods evaluate all
+muscles for arbitrary inputs without a SimTK::State, which is useful for
+custom solvers.
+
+Muscle-tendon equilibrium
+-------------------------
+Model::equilibrateMuscles() uses equilibrateMuscles() to find the normalized
+tendon force of all muscles with compliant tendons at once, instead of
+running a separate bisection for each muscle. The Newton iterations of all
+muscles advance in lockstep, with a bisection fallback for each muscle (see
+solveNewtonBisectionBatch()). The muscles can be divided into groups that are
+solved on separate threads via the `equilibrium_num_threads` property.
+
+@note If the properties of the muscles are edited, the bank is updated the
+next time the model is connected (e.g., by initSystem()). */
+class OSIMACTUATORS_API DeGrooteFregly2016MuscleBank : public MuscleBank {
+    OpenSim_DECLARE_CONCRETE_OBJECT(DeGrooteFregly2016MuscleBank, MuscleBank);
+
+public:
+    OpenSim_DECLARE_PROPERTY(equilibrium_tolerance, double,
+            "Tolerance on the muscle-tendon equilibrium residual (normalized "
+            "force) used by equilibrateMuscles(). Default: 1e-10.");
+    OpenSim_DECLARE_PROPERTY(equilibrium_max_iterations, int,
+            "Maximum number of iterations for each muscle in "
+            "equilibrateMuscles(). Default: 100.");
+    OpenSim_DECLARE_PROPERTY(equilibrium_num_threads, int,
+            "Number of groups of muscles that equilibrateMuscles() solves "
+            "concurrently. Default: 1.");
+
+    /// The inputs for each muscle, in the order of getMuscle(). The
+    /// normalized tendon force is only used for muscles with a compliant
+    /// tendon, and the normalized tendon force derivative is only used for
+    /// muscles with implicit tendon compliance dynamics.
+    struct Inputs {
+        std::vector<double> muscleTendonLength;
+        std::vector<double> muscleTendonVelocity;
+        std::vector<double> activation;
+        std::vector<double> normTendonForce;
+        std::vector<double> normTendonForceDerivative;
+        void resize(int numMuscles);
+    };
+
+    /// The quantities computed for each muscle, in the order of getMuscle().
+    /// The names and units match those of Muscle::MuscleLengthInfo,
+    /// Muscle::FiberVelocityInfo, and Muscle::MuscleDynamicsInfo.
+    struct Outputs {
+        // Length.
+        std::vector<double> normTendonLength;
+        std::vector<double> tendonLength;
+        std::vector<double> fiberLengthAlongTendon;
+        std::vector<double> fiberLength;
+        std::vector<double> normFiberLength;
+        std::vector<double> cosPennationAngle;
+        std::vector<double> sinPennationAngle;
+        std::vector<double> pennationAngle;
+        std::vector<double> fiberPassiveForceLengthMultiplier;
+        std::vector<double> fiberActiveForceLengthMultiplier;
+        // Velocity.
+        std::vector<double> normTendonVelocity;
+        std::vector<double> tendonVelocity;
+        std::vector<double> fiberVelocityAlongTendon;
+        std::vector<double> fiberVelocity;
+        std::vector<double> normFiberVelocity;
+        std::vector<double> pennationAngularVelocity;
+        std::vector<double> fiberForceVelocityMultiplier;
+        // Forces.
+        std::vector<double> activeFiberForce;
+        std::vector<double> passiveFiberElasticForce;
+        std::vector<double> passiveFiberDampingForce;
+        std::vector<double> fiberForce;
+        std::vector<double> fiberForceAlongTendon;
+        std::vector<double> normTendonForce;
+        std::vector<double> tendonForce;
+        // Stiffnesses and partial derivatives with respect to fiber length.
+        std::vector<double> fiberStiffness;
+        std::vector<double> fiberStiffnessAlongTendon;
+        std::vector<double> tendonStiffness;
+        std::vector<double> partialPennationAnglePartialFiberLength;
+        std::vector<double> partialFiberForceAlongTendonPartialFiberLength;
+        std::vector<double> partialTendonForcePartialFiberLength;
+        // Powers.
+        std::vector<double> fiberActivePower;
+        std::vector<double> fiberPassivePower;
+        std::vector<double> tendonPower;
+        // Muscle-tendon equilibrium; see
+        // DeGrooteFregly2016Muscle::calcEquilibriumResidual() and
+        // DeGrooteFregly2016Muscle::calcLinearizedEquilibriumResidualDerivative().
+        std::vector<double> equilibriumResidual;
+        std::vector<double> linearizedEquilibriumResidualDerivative;
+        void resize(int numMuscles);
+    };
+
+    DeGrooteFregly2016MuscleBank();
+
+    /// The number of DeGrooteFregly2016Muscle%s in the model.
+    int getNumMuscles() const override { return (int)m_muscles.size(); }
+    /// The muscles are in the order in which they appear in the model.
+    const DeGrooteFregly2016Muscle& getMuscle(int index) const override;
+
+    /// Find the normalized tendon force of all muscles with compliant tendons
+    /// that apply force, such that the muscle-tendon equilibrium residual is
+    /// zero (with a zero normalized tendon force derivative). This gives the
+    /// same result as DeGrooteFregly2016Muscle::computeInitialFiberEquilibrium()
+    /// for each muscle.
+    BatchRootSolveStatistics equilibrateMuscles(
+            SimTK::State& s) const override;
+
+    /// Gather the inputs for all muscles from the state. The state must be
+    /// realized to SimTK::Stage::Velocity.
+    void getInputs(const SimTK::State& s, Inputs& inputs) const;
+
+    /// Compute all Outputs for all muscles, using the tendon compliance
+    /// settings of each muscle. For muscles with explicit tendon compliance
+    /// dynamics, the equilibrium residual is zero.
+    void calcDynamics(const Inputs& inputs, Outputs& outputs) const;
+
+    /// Compute the muscle-tendon equilibrium residuals of all muscles, and
+    /// their time derivatives (see Outputs), treating all tendons as compliant
+    /// with implicit dynamics. This is the batch equivalent of
+    /// DeGrooteFregly2016Muscle::calcEquilibriumResidual(), and is
+    /// useful for finding muscle-tendon equilibrium for all muscles at once.
+    void calcEquilibriumResiduals(
+            const Inputs& inputs, Outputs& outputs) const;
+
+protected:
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    /// Compute the dynamics of all muscles and store the results in each
+    /// muscle's cache variables.
+    void extendRealizeDynamics(const SimTK::State& s) const override;
+
+private:
+    void constructProperties();
+    /// Compute the outputs for muscles in [begin, end). The outputs must
+    /// already have the correct size, so that disjoint ranges may be computed
+    /// concurrently.
+    void calcDynamicsImpl(const Inputs& inputs, bool implicitCompliant,
+            Outputs& outputs, int begin, int end) const;
+
+    std::vector<SimTK::ReferencePtr<const DeGrooteFregly2016Muscle>>
+            m_muscles;
+
+    // Muscle parameters, one entry per muscle.
+    // ----------------------------------------
+    std::vector<double> m_maxIsometricForce;
+    std::vector<double> m_optimalFiberLength;
+    std::vector<double> m_tendonSlackLength;
+    std::vector<double> m_fiberWidth;
+    std::vector<double> m_maxContractionVelocity; // m/s
+    std::vector<double> m_fiberDamping;
+    std::vector<double> m_activeForceWidthScale;
+    std::vector<double> m_passiveFiberStrain;
+    // 0 if passive fiber force is ignored, 1 otherwise.
+    std::vector<double> m_passiveForceScale;
+    // Constants of the passive force-length curve.
+    std::vector<double> m_passiveForceOffset;
+    std::vector<double> m_passiveForceDenominator;
+    std::vector<double> m_tendonStiffnessParameter;
+    // Modeling options; 1 if true, 0 otherwise. Stored as double so that
+    // they can be used in arithmetic selects within the kernel.
+    std::vector<double> m_ignoreTendonCompliance;
+    std::vector<double> m_isTendonDynamicsExplicit;
+
+    // Scratch space for extendRealizeDynamics(). It is stored in the state so
+    // that the same model can be realized on multiple threads at once.
+    struct Workspace {
+        Inputs inputs;
+        Outputs outputs;
+        friend std::ostream& operator<<(std::ostream& o, const Workspace&) {
+            o << "DeGrooteFregly2016MuscleBank::Workspace should not be "
+                 "serialized!" << std::endl;
+            return o;
+        }
+    };
+    mutable CacheVariable<Workspace> m_workspaceCV;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_DEGROOTEFREGLY2016MUSCLEBANK_H
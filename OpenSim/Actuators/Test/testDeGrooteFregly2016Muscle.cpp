@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+#include <OpenSim/Actuators/DeGrooteFregly2016MuscleBank.h>
 #include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Moco/osimMoco.h>
@@ -1086,3 +1087,175 @@ TEST_CASE("DeGrooteFregly2016Muscle basics") {
         CHECK(state.getY()[2] == Approx(0.451));
     }
 }
+
+namespace {
+// One muscle for each tendon compliance mode, each on its own slider.
+Model createMuscleBankModel(bool withBank) {
+    Model model;
+    const std::vector<std::string> modes = {"rigid", "explicit", "implicit"};
+    for (int i = 0; i < (int)modes.size(); ++i) {
+        const auto& mode = modes[i];
+        auto* body = new Body("body_" + mode, 0.5, SimTK::Vec3(0),
+                SimTK::Inertia(0.1));
+        model.addBody(body);
+        auto* joint = new SliderJoint("joint_" + mode, model.getGround(),
+                SimTK::Vec3(0, i, 0), SimTK::Vec3(0), *body, SimTK::Vec3(0),
+                SimTK::Vec3(0));
+        joint->updCoordinate().setName("x_" + mode);
+        model.addJoint(joint);
+        auto* muscle = new DeGrooteFregly2016Muscle();
+        muscle->setName("muscle_" + mode);
+        muscle->set_ignore_tendon_compliance(mode == "rigid");
+        muscle->set_tendon_compliance_dynamics_mode(
+                mode == "implicit" ? "implicit" : "explicit");
+        muscle->set_max_isometric_force(100.0 * (i + 1));
+        muscle->set_optimal_fiber_length(0.1 + 0.02 * i);
+        muscle->set_tendon_slack_length(0.2 - 0.03 * i);
+        muscle->set_pennation_angle_at_optimal(0.1 * i);
+        muscle->set_fiber_damping(0.01);
+        muscle->addNewPathPoint(
+                "origin", model.updGround(), SimTK::Vec3(0, i, 0));
+        muscle->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+        model.addForce(muscle);
+    }
+    if (withBank) {
+        auto* bank = new DeGrooteFregly2016MuscleBank();
+        bank->setName("muscle_bank");
+        model.addComponent(bank);
+    }
+    model.finalizeConnections();
+    return model;
+}
+
+void setMuscleBankState(const Model& model, SimTK::State& state) {
+    int i = 0;
+    for (const auto& muscle :
+            model.getComponentList<DeGrooteFregly2016Muscle>()) {
+        const auto& coord = model.getCoordinateSet().get(i);
+        coord.setValue(state, muscle.get_optimal_fiber_length() +
+                                      muscle.get_tendon_slack_length() +
+                                      0.01 * i);
+        coord.setSpeedValue(state, -0.1 + 0.1 * i);
+        muscle.setActivation(state, 0.3 + 0.2 * i);
+        if (!muscle.get_ignore_tendon_compliance()) {
+            muscle.setNormalizedTendonForce(state, 0.4 + 0.1 * i);
+        }
+        if (muscle.get_tendon_compliance_dynamics_mode() == "implicit") {
+            muscle.setDiscreteVariableValue(
+                    state, "implicitderiv_normalized_tendon_force", 0.5);
+        }
+        ++i;
+    }
+}
+} // anonymous namespace
+
+TEST_CASE("DeGrooteFregly2016MuscleBank") {
+    Model reference = createMuscleBankModel(false);
+    SimTK::State refState = reference.initSystem();
+    setMuscleBankState(reference, refState);
+    reference.realizeDynamics(refState);
+
+    Model model = createMuscleBankModel(true);
+    SimTK::State state = model.initSystem();
+    setMuscleBankState(model, state);
+    const auto& bank =
+            model.getComponent<DeGrooteFregly2016MuscleBank>("/muscle_bank");
+    REQUIRE(bank.getNumMuscles() == 3);
+    CHECK(bank.getMuscle(1).getName() == "muscle_explicit");
+    CHECK_THROWS(bank.getMuscle(3));
+
+    SECTION("Muscle outputs are identical") {
+        model.realizeDynamics(state);
+        for (int i = 0; i < bank.getNumMuscles(); ++i) {
+            const auto& muscle = bank.getMuscle(i);
+            const auto& refMuscle =
+                    reference.getComponent<DeGrooteFregly2016Muscle>(
+                            muscle.getAbsolutePath());
+            CAPTURE(muscle.getName());
+            CHECK(muscle.getTendonForce(state) ==
+                    Approx(refMuscle.getTendonForce(refState)));
+            CHECK(muscle.getFiberLength(state) ==
+                    Approx(refMuscle.getFiberLength(refState)));
+            CHECK(muscle.getFiberVelocity(state) ==
+                    Approx(refMuscle.getFiberVelocity(refState)));
+            CHECK(muscle.getPennationAngle(state) ==
+                    Approx(refMuscle.getPennationAngle(refState)));
+            CHECK(muscle.getActiveFiberForce(state) ==
+                    Approx(refMuscle.getActiveFiberForce(refState)));
+            CHECK(muscle.getPassiveFiberDampingForce(state) ==
+                    Approx(refMuscle.getPassiveFiberDampingForce(refState)));
+            CHECK(muscle.getTendonPower(state) ==
+                    Approx(refMuscle.getTendonPower(refState)));
+            CHECK(muscle.calcMuscleStiffness(state) ==
+                    Approx(refMuscle.calcMuscleStiffness(refState)));
+        }
+        reference.realizeAcceleration(refState);
+        model.realizeAcceleration(state);
+        for (int i = 0; i < state.getNU(); ++i) {
+            CHECK(state.getUDot()[i] == Approx(refState.getUDot()[i]));
+        }
+    }
+
+    SECTION("Batch equilibrium residuals") {
+        model.realizeVelocity(state);
+        DeGrooteFregly2016MuscleBank::Inputs inputs;
+        bank.getInputs(state, inputs);
+        inputs.normTendonForce[0] = 0.7;
+        inputs.normTendonForceDerivative = {0.2, -0.3, 0.1};
+        DeGrooteFregly2016MuscleBank::Outputs outputs;
+        bank.calcEquilibriumResiduals(inputs, outputs);
+        for (int i = 0; i < bank.getNumMuscles(); ++i) {
+            const auto& muscle = bank.getMuscle(i);
+            CAPTURE(muscle.getName());
+            CHECK(outputs.equilibriumResidual[i] ==
+                    Approx(muscle.calcEquilibriumResidual(
+                                   inputs.muscleTendonLength[i],
+                                   inputs.muscleTendonVelocity[i],
+                                   inputs.activation[i],
+                                   inputs.normTendonForce[i],
+                                   inputs.normTendonForceDerivative[i]))
+                            .margin(1e-12));
+        }
+        // Only the implicit muscle uses the same tendon dynamics for the
+        // linearized residual derivative.
+        const auto& implicitMuscle = bank.getMuscle(2);
+        CHECK(outputs.linearizedEquilibriumResidualDerivative[2] ==
+                Approx(implicitMuscle.calcLinearizedEquilibriumResidualDerivative(
+                        inputs.muscleTendonLength[2],
+                        inputs.muscleTendonVelocity[2], inputs.activation[2],
+                        inputs.normTendonForce[2],
+                        inputs.normTendonForceDerivative[2])));
+
+        inputs.activation.pop_back();
+        CHECK_THROWS(bank.calcDynamics(inputs, outputs));
+    }
+
+    SECTION("Batched muscle-tendon equilibrium") {
+        reference.equilibrateMuscles(refState);
+        Model threadedModel = createMuscleBankModel(true);
+        threadedModel.updComponent<DeGrooteFregly2016MuscleBank>("/muscle_bank")
+                .set_equilibrium_num_threads(GENERATE(1, 2));
+        SimTK::State threadedState = threadedModel.initSystem();
+        setMuscleBankState(threadedModel, threadedState);
+        threadedModel.equilibrateMuscles(threadedState);
+        const auto& threadedBank =
+                threadedModel.getComponent<DeGrooteFregly2016MuscleBank>(
+                        "/muscle_bank");
+        // Solving again from the equilibrium converges immediately.
+        const auto stats = threadedBank.equilibrateMuscles(threadedState);
+        // The rigid-tendon muscle has no equilibrium to solve for.
+        CHECK(stats.numProblems == 2);
+        CHECK(stats.numConverged == 2);
+        CHECK(stats.maxIterations <= 1);
+        for (int i = 1; i < threadedBank.getNumMuscles(); ++i) {
+            const auto& muscle = threadedBank.getMuscle(i);
+            const auto& refMuscle =
+                    reference.getComponent<DeGrooteFregly2016Muscle>(
+                            muscle.getAbsolutePath());
+            CAPTURE(muscle.getName());
+            CHECK(muscle.getNormalizedTendonForce(threadedState) ==
+                    Approx(refMuscle.getNormalizedTendonForce(refState))
+                            .margin(1e-8));
+        }
+    }
+}
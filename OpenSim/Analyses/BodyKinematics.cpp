@@ -146,6 +146,7 @@ setNull()
     _recordCenterOfMass = true;
 
     // OTHER VARIABLES
+    _massCenters = StationKinematics();
 
     //?_body
     setName("BodyKinematics");
@@ -342,10 +343,25 @@ setModel(Model& aModel)
     constructDescription();
     updateBodiesToRecord();
     constructColumnLabels();
+    _massCenters = StationKinematics();
 
     deleteStorage();
     allocateStorage();
 }
+//_____________________________________________________________________________
+/**
+ * Collect the mass centers of all bodies so that their kinematics can be
+ * computed together. The model's System must have been created.
+ */
+void BodyKinematics::
+updateMassCenters()
+{
+    _massCenters = StationKinematics();
+    const BodySet& bs = _model->getBodySet();
+    for(int i=0;i<bs.getSize();i++) {
+        _massCenters.addStation(bs.get(i), bs.get(i).get_mass_center());
+    }
+}
 
 //-----------------------------------------------------------------------------
 // STORAGE
@@ -437,12 +453,13 @@ record(const SimTK::State& s)
 
     // POSITION
     BodySet& bs = _model->updBodySet();
+    if(_massCenters.getNumStations() != bs.getSize()) updateMassCenters();
+    _massCenters.calcLocationsInGround(s, _massCenterKinematics);
 
     for(int i=0;i<_bodyIndices.getSize();i++) {
         Body& body = bs.get(_bodyIndices[i]);
-        const SimTK::Vec3& com = body.get_mass_center();
         // GET POSITIONS AND EULER ANGLES
-        vec = body.findStationLocationInGround(s, com);
+        vec = _massCenterKinematics[_bodyIndices[i]];
         angVec = body.getTransformInGround(s).R().convertRotationToBodyFixedXYZ();
 
         // CONVERT TO DEGREES?
@@ -462,8 +479,7 @@ record(const SimTK::State& s)
         double rP[3] = { 0.0, 0.0, 0.0 };
         for(int i=0;i<bs.getSize();i++) {
             Body& body = bs.get(i);
-            const SimTK::Vec3& com = body.get_mass_center();
-            vec = body.findStationLocationInGround(s, com);
+            vec = _massCenterKinematics[i];
             // ADD TO WHOLE BODY MASS
             Mass += body.get_mass();
             rP[0] += body.get_mass() * vec[0];
@@ -482,11 +498,11 @@ record(const SimTK::State& s)
     _pStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
 
     // VELOCITY
+    _massCenters.calcVelocitiesInGround(s, _massCenterKinematics);
     for(int i=0;i<_bodyIndices.getSize();i++) {
         Body& body = bs.get(_bodyIndices[i]);
-        const SimTK::Vec3& com = body.get_mass_center();
         // GET VELOCITIES AND ANGULAR VELOCITIES
-        vec = body.findStationVelocityInGround(s, com);
+        vec = _massCenterKinematics[_bodyIndices[i]];
         angVec = body.getVelocityInGround(s)[0];
         if (_expressInLocalFrame) {
             vec = ground.expressVectorInAnotherFrame(s, vec, body);
@@ -510,8 +526,7 @@ record(const SimTK::State& s)
         double rV[3] = { 0.0, 0.0, 0.0 };
         for(int i=0;i<bs.getSize();i++) {
             Body& body = bs.get(i);
-            const SimTK::Vec3& com = body.get_mass_center();
-            vec = body.findStationVelocityInGround(s, com);
+            vec = _massCenterKinematics[i];
             rV[0] += body.get_mass() * vec[0];
             rV[1] += body.get_mass() * vec[1];
             rV[2] += body.get_mass() * vec[2];
@@ -528,12 +543,12 @@ record(const SimTK::State& s)
     _vStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
 
     // ACCELERATIONS
+    _massCenters.calcAccelerationsInGround(s, _massCenterKinematics);
     for(int i=0;i<_bodyIndices.getSize();i++) {
         Body& body = bs.get(_bodyIndices[i]);
-        const SimTK::Vec3& com = body.get_mass_center();
 
         // GET ACCELERATIONS AND ANGULAR ACCELERATIONS
-        vec = body.findStationAccelerationInGround(s, com);
+        vec = _massCenterKinematics[_bodyIndices[i]];
         angVec = body.getAccelerationInGround(s)[0];
         if(_expressInLocalFrame) {
             vec = ground.expressVectorInAnotherFrame(s, vec, body);
@@ -557,8 +572,7 @@ record(const SimTK::State& s)
         double rA[3] = { 0.0, 0.0, 0.0 };
         for(int i=0;i<bs.getSize();i++) {
             Body& body = bs.get(i);
-            const SimTK::Vec3& com = body.get_mass_center();
-            vec = body.findStationAccelerationInGround(s, com);
+            vec = _massCenterKinematics[i];
             rA[0] += body.get_mass() * vec[0];
             rA[1] += body.get_mass() * vec[1];
             rA[2] += body.get_mass() * vec[2];
@@ -597,6 +611,9 @@ begin(const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
+    // The mass centers may have changed since the last run.
+    updateMassCenters();
+
     // RESET STORAGE
     _pStore->reset(s.getTime());
     _vStore->reset(s.getTime());
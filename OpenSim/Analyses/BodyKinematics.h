@@ -28,6 +28,7 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Simulation/Model/Analysis.h>
+#include <OpenSim/Simulation/Model/StationKinematics.h>
 #include <OpenSim/Common/PropertyStrArray.h>
 #include "osimAnalysesDLL.h"
 
@@ -67,6 +68,10 @@ protected:
     bool _recordCenterOfMass;
     Array<double> _kin;
 
+    /** The mass centers of all bodies in the BodySet, in BodySet order. */
+    StationKinematics _massCenters;
+    SimTK::Vector_<SimTK::Vec3> _massCenterKinematics;
+
     Storage *_pStore;
     Storage *_vStore;
     Storage *_aStore;
@@ -95,6 +100,7 @@ private:
     void allocateStorage();
     void deleteStorage();
     void updateBodiesToRecord();
+    void updateMassCenters();
 
 public:
     //--------------------------------------------------------------------------
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+# -------------------------------------------------------------------------- #
+#                      OpenSim:  compare_benchmarks.py                       #
+# -------------------------------------------------------------------------- #
+# The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  #
+# See http://opensim.stanford.edu and the NOTICE file for more information.  #
+# OpenSim is developed at Stanford University and supported by the US        #
+# National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    #
+# through the Warrior Web program.                                           #
+#                                                                            #
+# Copyright (c) 2005-2024 Stanford University and the Authors                #
+# Author(s): OpenSim Team                                                    #
+#                                                                            #
+# Licensed under the Apache License, Version 2.0 (the "License"); you may    #
+# not use this file except in compliance with the License. You may obtain a  #
+# copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         #
+#                                                                            #
+# Unless required by applicable law or agreed to in writing, software        #
+# distributed under the License is distributed on an "AS IS" BASIS,          #
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   #
+# See the License for the specific language governing permissions and        #
+# limitations under the License.                                             #
+# -------------------------------------------------------------------------- #
+
+"""Compare two results files written by opensim-benchmarks.
+
+The median of each benchmark in the contender is compared to that of the
+baseline. A benchmark regressed if it became slower by more than the
+threshold (a fraction; the default is 0.1, i.e., 10%). The exit code is 1 if
+any benchmark regressed, so this script can be used in continuous integration.
+
+Example:
+    python3 compare_benchmarks.py main.json my_branch.json --threshold 0.05
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(filename):
+    with open(filename) as f:
+        results = json.load(f)
+    return {b['name']: b for b in results['benchmarks']}
+
+
+def speedup(baseline, contender):
+    """Ratio greater than 1 if the contender is faster than the baseline."""
+    if baseline['higher_is_better']:
+        return contender['median'] / baseline['median']
+    return baseline['median'] / contender['median']
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('baseline', help='Results of the reference run.')
+    parser.add_argument('contender', help='Results of the run to check.')
+    parser.add_argument('--threshold', type=float, default=0.1,
+                        help='Allowed fractional slowdown (default: 0.1).')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    contender = load(args.contender)
+
+    regressions = []
+    print(f"{'benchmark':<50} {'baseline':>12} {'contender':>12} "
+          f"{'speedup':>8}  unit")
+    for name, base in baseline.items():
+        if name not in contender:
+            print(f'{name:<50} {"":>12} {"missing":>12}')
+            continue
+        cont = contender[name]
+        ratio = speedup(base, cont)
+        status = ''
+        if ratio < 1.0 - args.threshold:
+            status = '  REGRESSION'
+            regressions.append(name)
+        elif ratio > 1.0 + args.threshold:
+            status = '  improvement'
+        print(f"{name:<50} {base['median']:>12.4g} {cont['median']:>12.4g} "
+              f"{ratio:>8.3f}  {base['unit']}{status}")
+    for name in contender:
+        if name not in baseline:
+            print(f'{name:<50} {"new":>12} {contender[name]["median"]:>12.4g}')
+
+    if regressions:
+        print(f'\n{len(regressions)} benchmark(s) regressed by more than '
+              f'{100 * args.threshold:g}%: ' + ', '.join(regressions))
+        return 1
+    print(f'\nNo benchmark regressed by more than {100 * args.threshold:g}%.')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
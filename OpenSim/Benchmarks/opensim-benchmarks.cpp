@@ -0,0 +1,504 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  opensim-benchmarks.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Measure the throughput of the hot paths of OpenSim on models that ship with
+// the repository, and write the results to a JSON file. Use
+// compare_benchmarks.py to compare two such files. Run with --help for usage.
+
+#include <OpenSim/Common/About.h>
+#include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/Moco/osimMoco.h>
+#include <OpenSim/Simulation/InverseDynamicsSolver.h>
+#include <OpenSim/Simulation/InverseKinematicsSolver.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/MarkersReference.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <regex>
+
+using namespace OpenSim;
+
+namespace {
+
+/// The samples of one benchmark; there is one sample per repetition.
+struct BenchmarkResult {
+    std::string name;
+    std::string unit;
+    bool higherIsBetter = true;
+    std::vector<double> samples;
+    double median() const {
+        std::vector<double> sorted(samples);
+        std::sort(sorted.begin(), sorted.end());
+        const auto n = sorted.size();
+        if (n == 0) return SimTK::NaN;
+        return n % 2 ? sorted[n / 2]
+                     : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+    }
+    double best() const {
+        if (samples.empty()) return SimTK::NaN;
+        return higherIsBetter
+                ? *std::max_element(samples.begin(), samples.end())
+                : *std::min_element(samples.begin(), samples.end());
+    }
+};
+
+/// A benchmark performs its setup and then measures one sample per
+/// repetition, so that the setup is not timed.
+struct Benchmark {
+    std::string name;
+    std::string unit;
+    bool higherIsBetter;
+    std::function<void(int numRepetitions, std::vector<double>& samples)>
+            run;
+};
+
+/// Call `step` repeatedly for at least `minDuration` seconds, and return the
+/// number of calls per second. `step` returns the number of units of work it
+/// performed (e.g., frames).
+double measureRate(const std::function<int()>& step,
+        double minDuration = 0.5) {
+    long long count = 0;
+    Stopwatch watch;
+    double elapsed = 0;
+    do {
+        count += step();
+        elapsed = watch.getElapsedTime();
+    } while (elapsed < minDuration);
+    return (double)count / elapsed;
+}
+
+// realizeDynamics() for the default state of a model. Setting the generalized
+// coordinates invalidates all stages, so each call recomputes the path
+// geometry, muscle states, and forces.
+Benchmark realizeDynamics(const std::string& modelFile) {
+    const std::string name = modelFile.substr(0, modelFile.rfind('.'));
+    return {"realize_dynamics/" + name, "realizations/s", true,
+            [modelFile](int numRepetitions, std::vector<double>& samples) {
+                Model model(modelFile);
+                SimTK::State state = model.initSystem();
+                model.equilibrateMuscles(state);
+                const SimTK::Vector q = state.getQ();
+                for (int irep = 0; irep < numRepetitions; ++irep) {
+                    samples.push_back(measureRate([&]() {
+                        for (int i = 0; i < 10; ++i) {
+                            state.updQ() = q;
+                            model.realizeDynamics(state);
+                        }
+                        return 10;
+                    }));
+                }
+            }};
+}
+
+// Read a model file, with or without deferring the display properties (see
+// Object::setLazyDeserialization()). The model's system is not built.
+Benchmark loadModel(const std::string& modelFile, bool lazy) {
+    const std::string name = modelFile.substr(0, modelFile.rfind('.'));
+    return {std::string(lazy ? "model_load_lazy/" : "model_load/") + name,
+            "loads/s", true,
+            [modelFile, lazy](int numRepetitions,
+                    std::vector<double>& samples) {
+                const bool wasLazy = Object::getLazyDeserialization();
+                Object::setLazyDeserialization(lazy);
+                for (int irep = 0; irep < numRepetitions; ++irep) {
+                    samples.push_back(measureRate([&]() {
+                        Model model(modelFile);
+                        return 1;
+                    }));
+                }
+                Object::setLazyDeserialization(wasLazy);
+            }};
+}
+
+// Forward simulation from the default state with the default integrator.
+Benchmark forwardSimulation(const std::string& modelFile, double duration) {
+    const std::string name = modelFile.substr(0, modelFile.rfind('.'));
+    return {"forward_simulation/" + name, "steps/s", true,
+            [modelFile, duration](int numRepetitions,
+                    std::vector<double>& samples) {
+                Model model(modelFile);
+                SimTK::State initialState = model.initSystem();
+                model.equilibrateMuscles(initialState);
+                for (int irep = 0; irep < numRepetitions; ++irep) {
+                    SimTK::State state = initialState;
+                    Manager manager(model);
+                    manager.initialize(state);
+                    Stopwatch watch;
+                    manager.integrate(duration);
+                    const double elapsed = watch.getElapsedTime();
+                    samples.push_back(
+                            manager.getIntegrator().getNumStepsTaken() /
+                            elapsed);
+                }
+            }};
+}
+
+// Load the gait2354 walking kinematics, in radians.
+TimeSeriesTable loadGaitCoordinates(const Model& model) {
+    Storage storage("subject01_walk1_ik.mot");
+    if (storage.isInDegrees()) {
+        model.getSimbodyEngine().convertDegreesToRadians(storage);
+    }
+    return storage.exportToTable();
+}
+
+std::vector<std::string> getCoordinateNamesInMultibodyTreeOrder(
+        const Model& model) {
+    std::vector<std::string> names;
+    for (const auto& coord : model.getCoordinatesInMultibodyTreeOrder()) {
+        names.push_back(coord->getName());
+    }
+    return names;
+}
+
+// Inverse kinematics of the gait2354 model. The marker data are synthesized
+// from the walking kinematics, using three markers on each body.
+Benchmark inverseKinematics() {
+    return {"inverse_kinematics/gait2354_simbody", "frames/s", true,
+            [](int numRepetitions, std::vector<double>& samples) {
+                Model model("gait2354_simbody.osim");
+                const auto& bodies = model.getBodySet();
+                for (int ib = 0; ib < bodies.getSize(); ++ib) {
+                    const Body& body = bodies[ib];
+                    for (int k = 0; k < 3; ++k) {
+                        SimTK::Vec3 offset(0);
+                        offset[k] = 0.05;
+                        model.addMarker(new Marker(
+                                fmt::format("{}_{}", body.getName(), k), body,
+                                offset));
+                    }
+                }
+                SimTK::State state = model.initSystem();
+                const TimeSeriesTable coordinates =
+                        loadGaitCoordinates(model);
+                const auto& times = coordinates.getIndependentColumn();
+                const auto& markers = model.getMarkerSet();
+
+                TimeSeriesTableVec3 markerData;
+                std::vector<std::string> markerNames;
+                for (int im = 0; im < markers.getSize(); ++im) {
+                    markerNames.push_back(markers[im].getName());
+                }
+                markerData.setColumnLabels(markerNames);
+                for (int irow = 0; irow < (int)coordinates.getNumRows();
+                        ++irow) {
+                    const auto row = coordinates.getRowAtIndex(irow);
+                    for (int ic = 0; ic < (int)row.size(); ++ic) {
+                        model.getCoordinateSet()
+                                .get(coordinates.getColumnLabel(ic))
+                                .setValue(state, row[ic], false);
+                    }
+                    model.realizePosition(state);
+                    SimTK::RowVector_<SimTK::Vec3> locations(
+                            markers.getSize());
+                    for (int im = 0; im < markers.getSize(); ++im) {
+                        locations[im] = markers[im].getLocationInGround(state);
+                    }
+                    markerData.appendRow(times[irow], locations);
+                }
+
+                for (int irep = 0; irep < numRepetitions; ++irep) {
+                    SimTK::Array_<CoordinateReference> coordinateReferences;
+                    InverseKinematicsSolver ikSolver(model,
+                            std::make_shared<MarkersReference>(
+                                    markerData, Set<MarkerWeight>()),
+                            coordinateReferences);
+                    ikSolver.setAccuracy(1e-5);
+                    state.updTime() = times.front();
+                    ikSolver.assemble(state);
+                    Stopwatch watch;
+                    for (const auto& time : times) {
+                        state.updTime() = time;
+                        ikSolver.track(state);
+                    }
+                    samples.push_back(times.size() / watch.getElapsedTime());
+                }
+            }};
+}
+
+// Inverse dynamics of the gait2354 model over the walking kinematics.
+Benchmark inverseDynamics() {
+    return {"inverse_dynamics/gait2354_simbody", "frames/s", true,
+            [](int numRepetitions, std::vector<double>& samples) {
+                Model model("gait2354_simbody.osim");
+                SimTK::State state = model.initSystem();
+                for (auto& muscle : model.updComponentList<Muscle>()) {
+                    muscle.setAppliesForce(state, false);
+                }
+                const TimeSeriesTable coordinates =
+                        loadGaitCoordinates(model);
+                const auto labels =
+                        getCoordinateNamesInMultibodyTreeOrder(model);
+                GCVSplineSet splines(coordinates, labels);
+                std::vector<int> coordinatesToSpeedsIndexMap(labels.size());
+                for (int i = 0; i < (int)labels.size(); ++i) {
+                    coordinatesToSpeedsIndexMap[i] = i;
+                }
+                const auto& times = coordinates.getIndependentColumn();
+                InverseDynamicsSolver idSolver(model);
+                for (int irep = 0; irep < numRepetitions; ++irep) {
+                    samples.push_back(measureRate([&]() {
+                        idSolver.solve(state, splines,
+                                coordinatesToSpeedsIndexMap, times);
+                        return (int)times.size();
+                    }));
+                }
+            }};
+}
+
+// A table with the size of a typical states trajectory of a full-body model.
+TimeSeriesTable createLargeTable() {
+    const int numRows = 2000;
+    const int numColumns = 200;
+    std::vector<double> time(numRows);
+    for (int i = 0; i < numRows; ++i) { time[i] = 0.001 * i; }
+    std::vector<std::string> labels(numColumns);
+    for (int j = 0; j < numColumns; ++j) {
+        labels[j] = fmt::format("/forceset/muscle_{}/activation", j);
+    }
+    SimTK::Matrix data(numRows, numColumns);
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numColumns; ++j) {
+            data(i, j) = std::sin(0.01 * i + j) * (j + 1);
+        }
+    }
+    return TimeSeriesTable(time, data, labels);
+}
+
+double getFileSizeInMB(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    return (double)file.tellg() / (1024.0 * 1024.0);
+}
+
+Benchmark writeSTO() {
+    return {"sto_write/2000x200", "MB/s", true,
+            [](int numRepetitions, std::vector<double>& samples) {
+                const TimeSeriesTable table = createLargeTable();
+                const std::string fileName = "opensim-benchmarks_write.sto";
+                for (int irep = 0; irep < numRepetitions; ++irep) {
+                    Stopwatch watch;
+                    STOFileAdapter::write(table, fileName);
+                    const double elapsed = watch.getElapsedTime();
+                    samples.push_back(getFileSizeInMB(fileName) / elapsed);
+                }
+                std::remove(fileName.c_str());
+            }};
+}
+
+Benchmark readSTO() {
+    return {"sto_read/2000x200", "MB/s", true,
+            [](int numRepetitions, std::vector<double>& samples) {
+                const std::string fileName = "opensim-benchmarks_read.sto";
+                STOFileAdapter::write(createLargeTable(), fileName);
+                const double size = getFileSizeInMB(fileName);
+                for (int irep = 0; irep < numRepetitions; ++irep) {
+                    Stopwatch watch;
+                    TimeSeriesTable table(fileName);
+                    samples.push_back(size / watch.getElapsedTime());
+                }
+                std::remove(fileName.c_str());
+            }};
+}
+
+// The average duration of an iteration of MocoInverse for walking with the
+// 18-muscle model, as in testMocoInverse. The number of iterations is capped
+// so that the benchmark runs in a reasonable amount of time.
+Benchmark mocoInverseIteration(int maxIterations) {
+    return {"moco_iteration/subject_walk_armless_18musc", "s/iteration",
+            false, [maxIterations](int numRepetitions,
+                           std::vector<double>& samples) {
+                MocoInverse inverse;
+                inverse.setModel(
+                        ModelProcessor("subject_walk_armless_18musc.osim") |
+                        ModOpReplaceJointsWithWelds({"subtalar_r",
+                                "subtalar_l", "mtp_r", "mtp_l"}) |
+                        ModOpReplaceMusclesWithDeGrooteFregly2016() |
+                        ModOpIgnorePassiveFiberForcesDGF() |
+                        ModOpTendonComplianceDynamicsModeDGF("implicit") |
+                        ModOpAddExternalLoads(
+                                "subject_walk_armless_external_loads.xml"));
+                inverse.setKinematics(TableProcessor(
+                        "subject_walk_armless_coordinates.mot") |
+                        TabOpLowPassFilter(6));
+                inverse.set_initial_time(0.450);
+                inverse.set_final_time(1.0);
+                inverse.set_kinematics_allow_extra_columns(true);
+                inverse.set_mesh_interval(0.025);
+                inverse.set_max_iterations(maxIterations);
+                for (int irep = 0; irep < numRepetitions; ++irep) {
+                    const MocoSolution solution =
+                            inverse.solve().getMocoSolution();
+                    samples.push_back(solution.getSolverDuration() /
+                                      std::max(1, solution.getNumIterations()));
+                }
+            }};
+}
+
+void writeJSON(const std::string& fileName, int numRepetitions,
+        const std::vector<BenchmarkResult>& results) {
+    std::ofstream file(fileName);
+    OPENSIM_THROW_IF(!file.good(), Exception,
+            fmt::format("Could not open '{}' for writing.", fileName));
+    file << "{\n";
+    file << fmt::format("  \"opensim_version\": \"{}\",\n", GetVersion());
+    file << fmt::format("  \"compiler\": \"{}\",\n", GetCompilerVersion());
+    file << fmt::format("  \"os\": \"{}\",\n", GetOSInfo());
+    file << fmt::format("  \"repetitions\": {},\n", numRepetitions);
+    file << "  \"benchmarks\": [\n";
+    for (int i = 0; i < (int)results.size(); ++i) {
+        const auto& result = results[i];
+        file << "    {\n";
+        file << fmt::format("      \"name\": \"{}\",\n", result.name);
+        file << fmt::format("      \"unit\": \"{}\",\n", result.unit);
+        file << fmt::format("      \"higher_is_better\": {},\n",
+                result.higherIsBetter ? "true" : "false");
+        file << fmt::format("      \"median\": {:.6g},\n", result.median());
+        file << fmt::format("      \"best\": {:.6g},\n", result.best());
+        file << fmt::format("      \"samples\": [{:.6g}]\n",
+                fmt::join(result.samples, ", "));
+        file << (i + 1 < (int)results.size() ? "    },\n" : "    }\n");
+    }
+    file << "  ]\n";
+    file << "}\n";
+}
+
+const char* HELP = R"(Measure the performance of OpenSim.
+
+Usage:
+  opensim-benchmarks [options]
+
+Options:
+  -o, --output <file>       Write the results to this JSON file
+                            [default: opensim-benchmarks.json].
+  -r, --repetitions <n>     Number of samples for each benchmark [default: 3].
+  -f, --filter <regex>      Only run benchmarks whose name matches this
+                            regular expression.
+  --moco-iterations <n>     Maximum number of iterations for the Moco
+                            benchmark [default: 20].
+  -l, --list                List the benchmarks without running them.
+  -h, --help                Show this help message.
+
+Run from the directory containing the model and data files (the build
+directory of this program). Compare two results files with
+compare_benchmarks.py.
+)";
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    std::string outputFile = "opensim-benchmarks.json";
+    int numRepetitions = 3;
+    std::string filter = ".*";
+    int mocoIterations = 20;
+    bool listOnly = false;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const auto nextArg = [&]() -> std::string {
+                OPENSIM_THROW_IF(i + 1 >= argc, Exception,
+                        fmt::format("Missing value for '{}'.", arg));
+                return argv[++i];
+            };
+            if (arg == "-h" || arg == "--help") {
+                std::cout << HELP;
+                return 0;
+            } else if (arg == "-o" || arg == "--output") {
+                outputFile = nextArg();
+            } else if (arg == "-r" || arg == "--repetitions") {
+                numRepetitions = std::stoi(nextArg());
+            } else if (arg == "-f" || arg == "--filter") {
+                filter = nextArg();
+            } else if (arg == "--moco-iterations") {
+                mocoIterations = std::stoi(nextArg());
+            } else if (arg == "-l" || arg == "--list") {
+                listOnly = true;
+            } else {
+                OPENSIM_THROW(Exception,
+                        fmt::format("Unrecognized argument '{}'.", arg));
+            }
+        }
+        OPENSIM_THROW_IF(numRepetitions < 1, Exception,
+                "Expected the number of repetitions to be at least 1.");
+
+        std::vector<Benchmark> benchmarks;
+        for (const auto& modelFile : {"arm26.osim", "gait2354_simbody.osim",
+                     "subject_walk_armless_18musc.osim",
+                     "walk_gait1018_subject01.osim"}) {
+            benchmarks.push_back(realizeDynamics(modelFile));
+        }
+        for (const auto& modelFile : {"gait2354_simbody.osim",
+                     "subject_walk_armless_18musc.osim"}) {
+            benchmarks.push_back(loadModel(modelFile, false));
+            benchmarks.push_back(loadModel(modelFile, true));
+        }
+        benchmarks.push_back(forwardSimulation("arm26.osim", 1.0));
+        benchmarks.push_back(forwardSimulation("gait2354_simbody.osim", 0.1));
+        benchmarks.push_back(inverseKinematics());
+        benchmarks.push_back(inverseDynamics());
+        benchmarks.push_back(writeSTO());
+        benchmarks.push_back(readSTO());
+#ifdef OPENSIM_WITH_CASADI
+        benchmarks.push_back(mocoInverseIteration(mocoIterations));
+#else
+        (void)mocoIterations;
+#endif
+
+        const std::regex pattern(filter);
+        std::vector<BenchmarkResult> results;
+        for (const auto& benchmark : benchmarks) {
+            if (!std::regex_search(benchmark.name, pattern)) continue;
+            if (listOnly) {
+                std::cout << benchmark.name << "\n";
+                continue;
+            }
+            // Only show our own output, not that of the tools.
+            const auto level = Logger::getLevel();
+            Logger::setLevel(Logger::Level::Warn);
+            BenchmarkResult result;
+            result.name = benchmark.name;
+            result.unit = benchmark.unit;
+            result.higherIsBetter = benchmark.higherIsBetter;
+            benchmark.run(numRepetitions, result.samples);
+            Logger::setLevel(level);
+            log_cout("{:<50} {:>12.4g} {}", result.name, result.median(),
+                    result.unit);
+            results.push_back(std::move(result));
+        }
+        if (!listOnly) {
+            writeJSON(outputFile, numRepetitions, results);
+            log_cout("Wrote results to '{}'.", outputFile);
+        }
+    } catch (const std::exception& e) {
+        log_error("{}", e.what());
+        return 1;
+    }
+    return 0;
+}
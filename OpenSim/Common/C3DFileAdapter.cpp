@@ -3,10 +3,43 @@
 #ifdef WITH_EZC3D
 #include "ezc3d/ezc3d_all.h"
 #endif
+#include "IO.h"
 #include "STOFileAdapter.h"
+#include "TRCFileAdapter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+
+#ifndef _WIN32
+#include <dirent.h>
+#endif
 
 namespace {
 
+// Call func(begin, end) for contiguous ranges of the frames [0, numFrames),
+// concurrently if requested and if there are enough frames for threads to pay
+// off.
+template <typename F>
+void forFrameRanges(int numFrames, bool concurrent, F&& func) {
+    static const int minFramesPerThread = 2000;
+    const int numThreads = concurrent ? std::max(1,
+            std::min((int)std::thread::hardware_concurrency(),
+                    numFrames / minFramesPerThread)) : 1;
+    if (numThreads == 1) {
+        func(0, numFrames);
+        return;
+    }
+    std::vector<std::future<void>> futures;
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        futures.push_back(std::async(std::launch::async, func,
+                ithread * numFrames / numThreads,
+                (ithread + 1) * numFrames / numThreads));
+    }
+    for (auto& future : futures) future.get();
+}
+
 #ifdef WITH_EZC3D
 // Function to convert ezc3d matrix to SimTK matrix. This can become a lambda
 // function inside extendRead in future.
@@ -118,27 +151,29 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         }
 
         double time_step{1.0 / pointFrequency};
-        for(int f = 0; f < marker_nrow; ++f) {
-            SimTK::RowVector_<SimTK::Vec3> row{ numMarkers,
-                                                SimTK::Vec3(SimTK::NaN) };
-            int m{0};
-            // C3D standard is to read empty values as zero, but sets a
-            // "residual" value to -1 and it is how it knows to export these
-            // values as blank, instead of 0,  when exporting to .trc
-            // See: C3D documention 3D Point Residuals
-            // Read in value if it is not zero or residual is not -1
-            for(auto pt : c3d.data().frame(f).points().points()) {
-                if (!pt.isEmpty() ) {//residual is not -1
-                    row[m] = SimTK::Vec3{ static_cast<double>(pt.x()),
-                                          static_cast<double>(pt.y()),
-                                          static_cast<double>(pt.z()) };
+        forFrameRanges(marker_nrow, _concurrentFrames, [&](int begin, int end) {
+            for(int f = begin; f < end; ++f) {
+                SimTK::RowVector_<SimTK::Vec3> row{ numMarkers,
+                                                    SimTK::Vec3(SimTK::NaN) };
+                int m{0};
+                // C3D standard is to read empty values as zero, but sets a
+                // "residual" value to -1 and it is how it knows to export these
+                // values as blank, instead of 0,  when exporting to .trc
+                // See: C3D documention 3D Point Residuals
+                // Read in value if it is not zero or residual is not -1
+                for(const auto& pt : c3d.data().frame(f).points().points()) {
+                    if (!pt.isEmpty() ) {//residual is not -1
+                        row[m] = SimTK::Vec3{ static_cast<double>(pt.x()),
+                                              static_cast<double>(pt.y()),
+                                              static_cast<double>(pt.z()) };
+                    }
+                    ++m;
                 }
-                ++m;
-            }
 
-            marker_matrix.updRow(f) = row;
-            marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
-        }
+                marker_matrix.updRow(f) = row;
+                marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
+            }
+        });
 
         // Create the data
         auto marker_table =
@@ -176,17 +211,64 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         tables.emplace(_markers, emptyMarkersTable);
     }
 
+    auto analogFrequency = static_cast<double>(c3d.header().frameRate()
+        * c3d.header().nbAnalogByFrame());
+
+    if (_readForces) {
+        tables.emplace(_forces, readForces(c3d, event_table, analogFrequency));
+    }
+    else { // insert empty table
+        std::vector<double> emptyTimes;
+        std::vector<std::string> emptyLabels;
+        SimTK::Matrix_<SimTK::Vec3> noData;
+        tables.emplace(_forces, std::make_shared<TimeSeriesTableVec3>(
+                emptyTimes, noData, emptyLabels));
+    }
+
+    if (_readAnalogData) {
+        tables.emplace(_analog, readAnalogData(c3d, analogFrequency));
+    }
+    else { // insert empty table
+        std::vector<double> emptyTimes;
+        std::vector<std::string> emptyLabels;
+        SimTK::Matrix noData;
+        tables.emplace(_analog, std::make_shared<TimeSeriesTable>(
+                emptyTimes, noData, emptyLabels));
+    }
+    return tables;
+
+}
+
+std::shared_ptr<TimeSeriesTableVec3>
+C3DFileAdapter::readForces(const ezc3d::c3d& c3d, const EventTable& event_table,
+        double analogFrequency) const {
+    ForceLocation forceLocation(getLocationForForceExpression());
+
     std::vector<SimTK::Matrix_<double>> fpCalMatrices{};
     std::vector<SimTK::Matrix_<double>> fpCorners{};
     std::vector<SimTK::Matrix_<double>> fpOrigins{};
     std::vector<unsigned>               fpTypes{};
-    const auto& force_platforms_extractor = ezc3d::Modules::ForcePlatforms(c3d);
 
-    ForceLocation forceLocation(getLocationForForceExpression());
-    auto numPlatform(static_cast<int>(
-                             force_platforms_extractor.forcePlatforms().size()));
+    // Computing the forces, moments, and centers of pressure of a force
+    // platform processes all of its analog data, so compute the platforms
+    // concurrently.
+    const auto numPlatforms = c3d.parameters().isGroup("FORCE_PLATFORM") &&
+            c3d.parameters().group("FORCE_PLATFORM").isParameter("USED")
+            ? static_cast<size_t>(c3d.parameters().group("FORCE_PLATFORM")
+                    .parameter("USED").valuesAsInt()[0])
+            : 0;
+    std::vector<std::future<ezc3d::Modules::ForcePlatform>> platformFutures;
+    for (size_t i = 0; i < numPlatforms; ++i) {
+        platformFutures.push_back(std::async(
+                _concurrentFrames ? std::launch::async : std::launch::deferred,
+                [&c3d, i]() { return ezc3d::Modules::ForcePlatform(i, c3d); }));
+    }
+    std::vector<ezc3d::Modules::ForcePlatform> platforms;
+    for (auto& future : platformFutures) platforms.push_back(future.get());
+
+    auto numPlatform(static_cast<int>(platforms.size()));
 
-    for (const auto& platform : force_platforms_extractor.forcePlatforms()){
+    for (const auto& platform : platforms){
 
         const auto& calMatrix = platform.calMatrix();
         const auto& corners   = platform.corners();
@@ -199,10 +281,12 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         fpTypes.push_back(static_cast<unsigned>(type));
 
     }
-    auto analogFrequency = static_cast<double>(c3d.header().frameRate()
-        * c3d.header().nbAnalogByFrame());
 
     if(numPlatform != 0) {
+        OPENSIM_THROW_IF(
+                forceLocation == ForceLocation::PointOfWrenchApplication,
+                Exception, "The selected force location is not implemented "
+                           "for ezc3d files");
         for (auto type : c3d.parameters().group("FORCE_PLATFORM")
                             .parameter("TYPE").valuesAsInt()){
             if (type == 1){
@@ -215,12 +299,9 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         for(int fp = 1; fp <= numPlatform; ++fp) {
             auto fp_str = std::to_string(fp);
 
-            auto force_unit =
-                    force_platforms_extractor.forcePlatform(fp-1).forceUnit();
-            auto position_unit =
-                    force_platforms_extractor.forcePlatform(fp-1).positionUnit();
-            auto moment_unit =
-                    force_platforms_extractor.forcePlatform(fp-1).momentUnit();
+            auto force_unit = platforms[fp-1].forceUnit();
+            auto position_unit = platforms[fp-1].positionUnit();
+            auto moment_unit = platforms[fp-1].momentUnit();
 
             labels.push_back(SimTK::Value<std::string>("f" + fp_str));
             units.upd().push_back(SimTK::Value<std::string>(force_unit));
@@ -232,51 +313,49 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
             units.upd().push_back(SimTK::Value<std::string>(moment_unit));
         }
 
-        const int nf = static_cast<int>(force_platforms_extractor.forcePlatform(0).nbFrames());
+        const int nf = static_cast<int>(platforms[0].nbFrames());
         
-        const auto& pf_ref(force_platforms_extractor.forcePlatforms());
+        const auto& pf_ref(platforms);
 
         std::vector<double> force_times(nf);
         SimTK::Matrix_<SimTK::Vec3> force_matrix(nf, (int)labels.size());
 
         double time_step{1.0 / analogFrequency};
 
-        for(int f = 0; f < nf;  ++f) {
-            SimTK::RowVector_<SimTK::Vec3>
-                    row{numPlatform * 3};
-            int col{0};
-            for (size_t i = 0; i < (size_t)numPlatform; ++i){
-                row[col] = SimTK::Vec3{pf_ref[i].forces()[f](0),
-                                       pf_ref[i].forces()[f](1),
-                                       pf_ref[i].forces()[f](2)};
-                ++col;
-                if (forceLocation == ForceLocation::CenterOfPressure){
-                    row[col] = SimTK::Vec3{pf_ref[i].CoP()[f](0),
-                                           pf_ref[i].CoP()[f](1),
-                                           pf_ref[i].CoP()[f](2)};
+        forFrameRanges(nf, _concurrentFrames, [&](int begin, int end) {
+            for(int f = begin; f < end;  ++f) {
+                SimTK::RowVector_<SimTK::Vec3>
+                        row{numPlatform * 3};
+                int col{0};
+                for (size_t i = 0; i < (size_t)numPlatform; ++i){
+                    row[col] = SimTK::Vec3{pf_ref[i].forces()[f](0),
+                                           pf_ref[i].forces()[f](1),
+                                           pf_ref[i].forces()[f](2)};
                     ++col;
-                    row[col] = SimTK::Vec3{pf_ref[i].Tz()[f](0),
-                                           pf_ref[i].Tz()[f](1),
-                                           pf_ref[i].Tz()[f](2)};
-                    ++col;
-                } else if (forceLocation == ForceLocation::OriginOfForcePlate){
-                    row[col] = SimTK::Vec3{pf_ref[i].meanCorners()(0),
-                                           pf_ref[i].meanCorners()(1),
-                                           pf_ref[i].meanCorners()(2)};
-                    ++col;
-                    row[col] = SimTK::Vec3{pf_ref[i].moments()[f](0),
-                                           pf_ref[i].moments()[f](1),
-                                           pf_ref[i].moments()[f](2)};
-                    ++col;
-                } else {
-                    OPENSIM_THROW(Exception,
-                                  "The selected force location is not "
-                                  "implemented for ezc3d files");
+                    if (forceLocation == ForceLocation::CenterOfPressure){
+                        row[col] = SimTK::Vec3{pf_ref[i].CoP()[f](0),
+                                               pf_ref[i].CoP()[f](1),
+                                               pf_ref[i].CoP()[f](2)};
+                        ++col;
+                        row[col] = SimTK::Vec3{pf_ref[i].Tz()[f](0),
+                                               pf_ref[i].Tz()[f](1),
+                                               pf_ref[i].Tz()[f](2)};
+                        ++col;
+                    } else {
+                        row[col] = SimTK::Vec3{pf_ref[i].meanCorners()(0),
+                                               pf_ref[i].meanCorners()(1),
+                                               pf_ref[i].meanCorners()(2)};
+                        ++col;
+                        row[col] = SimTK::Vec3{pf_ref[i].moments()[f](0),
+                                               pf_ref[i].moments()[f](1),
+                                               pf_ref[i].moments()[f](2)};
+                        ++col;
+                    }
                 }
+                force_matrix.updRow(f) = row;
+                force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
             }
-            force_matrix.updRow(f) = row;
-            force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
-        }
+        });
 
         auto&  force_table =
                 *(new TimeSeriesTableVec3(force_times, force_matrix, labels));
@@ -309,20 +388,22 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
                 setValueForKey("DataRate",
                                std::to_string(analogFrequency));
 
-        tables.emplace(_forces,
-                       std::shared_ptr<TimeSeriesTableVec3>(&force_table));
-
         force_table.updTableMetaData().setValueForKey("events", event_table);
+
+        return std::shared_ptr<TimeSeriesTableVec3>(&force_table);
     }
-    else { // insert empty table
+    else { // empty table
         std::vector<double> emptyTimes;
         std::vector<std::string> emptyLabels;
         SimTK::Matrix_<SimTK::Vec3> noData;
-        auto emptyforcesTable = std::make_shared<TimeSeriesTableVec3>(
+        return std::make_shared<TimeSeriesTableVec3>(
                 emptyTimes, noData, emptyLabels);
-        tables.emplace(_forces, emptyforcesTable);
     }
+}
 
+std::shared_ptr<TimeSeriesTable>
+C3DFileAdapter::readAnalogData(const ezc3d::c3d& c3d,
+        double analogFrequency) const {
     // Try to extract analog data and place in a new TimeSeriesTable_<double> 
     std::vector<std::string> analog_labels{};
     for (auto label : c3d.parameters().group("ANALOG")
@@ -337,25 +418,28 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
     double analog_time_step{ 1.0 / analogFrequency };
 
     // Exrtact matrix of analog data one (sub)frame at a time
-    int rowNumber = 0;
-    for (const auto& frame : c3d.data().frames()) {
-        for (size_t i = 0; i < frame.analogs().nbSubframes(); ++i) {
-            const auto& subframe(frame.analogs().subframe(i));
-            SimTK::RowVector_<double> row{ numAnalogSignals, SimTK::NaN };
-            for (int col = 0; col < numAnalogSignals; ++col) {
-                row[col] = subframe.channel(col).data();
+    const int numSubframes = static_cast<int>(c3d.header().nbAnalogByFrame());
+    forFrameRanges(static_cast<int>(c3d.data().nbFrames()), _concurrentFrames,
+            [&](int begin, int end) {
+        for (int f = begin; f < end; ++f) {
+            const auto& frame = c3d.data().frame(f);
+            int rowNumber = f * numSubframes;
+            for (size_t i = 0; i < frame.analogs().nbSubframes(); ++i) {
+                const auto& subframe(frame.analogs().subframe(i));
+                SimTK::RowVector_<double> row{ numAnalogSignals, SimTK::NaN };
+                for (int col = 0; col < numAnalogSignals; ++col) {
+                    row[col] = subframe.channel(col).data();
+                }
+                analog_data_matrix.updRow(rowNumber) = row;
+                analog_times[rowNumber] = rowNumber * analog_time_step; //TODO: 0 should be start_time
+                rowNumber++;
             }
-            analog_data_matrix.updRow(rowNumber) = row;
-            analog_times[rowNumber] = rowNumber * analog_time_step; //TODO: 0 should be start_time
-            rowNumber++;
         }
-    }
-    auto& analog_table =
-        *(new TimeSeriesTable(analog_times, analog_data_matrix, analog_labels));
-    analog_table.updTableMetaData().setValueForKey("DataRate", std::to_string(analogFrequency));
-    tables.emplace(_analog, std::shared_ptr<TimeSeriesTable>(&analog_table));
-    return tables;
-
+    });
+    auto analog_table = std::make_shared<TimeSeriesTable>(
+            analog_times, analog_data_matrix, analog_labels);
+    analog_table->updTableMetaData().setValueForKey("DataRate", std::to_string(analogFrequency));
+    return analog_table;
 }
 
 void
@@ -364,4 +448,96 @@ C3DFileAdapter::extendWrite(const InputTables& absTables,
     OPENSIM_THROW(Exception, "Writing to C3D not supported yet.");
 }
 
+int C3DFileAdapter::convertFiles(const std::vector<std::string>& fileNames,
+        const std::string& outputDirectory, int numThreads) const {
+    if (numThreads <= 0) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    numThreads = std::max(1, std::min(numThreads, (int)fileNames.size()));
+    if (!outputDirectory.empty()) IO::makeDir(outputDirectory);
+
+    // Each file is read on a single thread, and each thread holds the data of
+    // one file at a time.
+    C3DFileAdapter adapter(*this);
+    adapter._concurrentFrames = false;
+    std::atomic<size_t> next{0};
+    std::atomic<int> numFailed{0};
+    auto convert = [&]() {
+        for (size_t i = next++; i < fileNames.size(); i = next++) {
+            const std::string& fileName = fileNames[i];
+            bool isAbsolutePath;
+            std::string directory, stem, extension;
+            SimTK::Pathname::deconstructPathname(fileName, isAbsolutePath,
+                    directory, stem, extension);
+            // The directory is empty or ends with a separator.
+            const std::string prefix = outputDirectory.empty()
+                    ? directory + stem : outputDirectory + "/" + stem;
+            try {
+                auto tables = adapter.read(fileName);
+                const auto& markers = adapter.getMarkersTable(tables);
+                if (markers->getNumColumns()) {
+                    TRCFileAdapter::write(*markers, prefix + ".trc");
+                }
+                const auto& forces = adapter.getForcesTable(tables);
+                if (forces->getNumColumns()) {
+                    STOFileAdapter::write(forces->flatten(),
+                            prefix + "_forces.mot");
+                }
+                const auto& analog = adapter.getAnalogDataTable(tables);
+                if (analog->getNumColumns()) {
+                    STOFileAdapter::write(*analog, prefix + "_analog.sto");
+                }
+            } catch (const std::exception& e) {
+                log_error("C3DFileAdapter::convertFiles: could not convert "
+                          "'{}': {}", fileName, e.what());
+                ++numFailed;
+            }
+        }
+    };
+    std::vector<std::future<void>> futures;
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        futures.push_back(std::async(std::launch::async, convert));
+    }
+    convert();
+    for (auto& future : futures) future.get();
+    return numFailed;
+}
+
+int C3DFileAdapter::convertDirectory(const std::string& inputDirectory,
+        const std::string& outputDirectory, int numThreads) const {
+    std::vector<std::string> fileNames;
+    auto isC3D = [](std::string name) {
+        if (name.size() < 4) return false;
+        name = IO::Lowercase(name.substr(name.size() - 4));
+        return name == ".c3d";
+    };
+#ifdef _WIN32
+    WIN32_FIND_DATAA data;
+    HANDLE handle = FindFirstFileA((inputDirectory + "\\*").c_str(), &data);
+    OPENSIM_THROW_IF(handle == INVALID_HANDLE_VALUE, Exception,
+            "Could not open directory '{}'.", inputDirectory);
+    do {
+        if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) &&
+                isC3D(data.cFileName)) {
+            fileNames.push_back(inputDirectory + "/" + data.cFileName);
+        }
+    } while (FindNextFileA(handle, &data));
+    FindClose(handle);
+#else
+    DIR* dir = opendir(inputDirectory.c_str());
+    OPENSIM_THROW_IF(dir == nullptr, Exception,
+            "Could not open directory '{}'.", inputDirectory);
+    while (const dirent* entry = readdir(dir)) {
+        if (isC3D(entry->d_name)) {
+            fileNames.push_back(inputDirectory + "/" + entry->d_name);
+        }
+    }
+    closedir(dir);
+#endif
+    std::sort(fileNames.begin(), fileNames.end());
+    log_info("Converting {} C3D files in '{}'.", fileNames.size(),
+            inputDirectory);
+    return convertFiles(fileNames, outputDirectory, numThreads);
+}
+
 } // namespace OpenSim
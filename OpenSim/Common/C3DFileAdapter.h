@@ -26,6 +26,10 @@
 #include "TimeSeriesTable.h"
 #include "Event.h"
 
+namespace ezc3d {
+class c3d;
+}
+
 namespace OpenSim {
 
 /** C3DFileAdapter reads a C3D file into markers and forces tables of type
@@ -116,6 +120,38 @@ public:
         return _location;
     }
 
+    /** Whether read() computes the forces, points, and moments of the force
+        plates (the "forces" table). Computing them processes all analog
+        data, which dominates the time to read a C3D file with force plates.
+        If false, the "forces" table is empty. To compute the forces of only
+        some of the files, read those files again with this option enabled.
+        The default is true. */
+    void setReadForces(bool readForces) { _readForces = readForces; }
+    bool getReadForces() const { return _readForces; }
+    /** Whether read() extracts the analog data (the "analog" table). If false,
+        the "analog" table is empty. The default is true. */
+    void setReadAnalogData(bool readAnalogData) {
+        _readAnalogData = readAnalogData;
+    }
+    bool getReadAnalogData() const { return _readAnalogData; }
+
+    /** Convert C3D files to tables with the options of this adapter, using
+        up to `numThreads` threads (the number of hardware threads if not
+        positive). Each thread converts one file at a time, so at most
+        `numThreads` files are held in memory. For a file `<stem>.c3d`, the
+        markers are written to `<stem>.trc`, the forces to
+        `<stem>_forces.mot`, and the analog data to `<stem>_analog.sto`;
+        empty tables are not written. The files are written to
+        `outputDirectory`, or next to the C3D file if `outputDirectory` is
+        empty. A file that cannot be converted is logged and skipped.
+        @returns the number of files that could not be converted. */
+    int convertFiles(const std::vector<std::string>& fileNames,
+            const std::string& outputDirectory, int numThreads = 0) const;
+    /** Convert all files with the extension `.c3d` (in any case) in
+        `inputDirectory` (not including subdirectories) with convertFiles(). */
+    int convertDirectory(const std::string& inputDirectory,
+            const std::string& outputDirectory, int numThreads = 0) const;
+
 #ifndef SWIG
     static
     void write(const Tables& markerTable, const std::string& fileName);
@@ -150,9 +186,18 @@ protected:
                      const std::string& fileName) const override;
 
 private:
+    std::shared_ptr<TimeSeriesTableVec3> readForces(const ezc3d::c3d& c3d,
+            const EventTable& event_table, double analogFrequency) const;
+    std::shared_ptr<TimeSeriesTable> readAnalogData(
+            const ezc3d::c3d& c3d, double analogFrequency) const;
+
     static const std::unordered_map<std::string, std::size_t> _unit_index;
 
     ForceLocation _location{ ForceLocation::OriginOfForcePlate };
+    bool _readForces{true};
+    bool _readAnalogData{true};
+    // Whether to process the frames of a file on multiple threads.
+    bool _concurrentFrames{true};
 
 };
 
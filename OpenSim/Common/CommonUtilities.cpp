@@ -26,8 +26,10 @@
 #include "PiecewiseLinearFunction.h"
 #include "STOFileAdapter.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
 #include <chrono>
 #include <ctime>
+#include <future>
 #include <iomanip>
 #include <memory>
 #include <sstream>
@@ -187,6 +189,115 @@ SimTK::Real OpenSim::solveBisection(
     return midpoint;
 }
 
+BatchRootSolveStatistics OpenSim::solveNewtonBisectionBatch(
+        std::function<void(int, int, const std::vector<double>&,
+                std::vector<double>&, std::vector<double>&)> calcResiduals,
+        std::vector<double>& x, const std::vector<double>& left,
+        const std::vector<double>& right, double tolerance, int maxIterations,
+        int numThreads) {
+    const int n = (int)x.size();
+    OPENSIM_THROW_IF((int)left.size() != n || (int)right.size() != n,
+            Exception,
+            "Expected {} lower and upper bounds, but got {} and {}.", n,
+            left.size(), right.size());
+    OPENSIM_THROW_IF(maxIterations < 0, Exception,
+            "Expected maxIterations to be positive, but got {}.",
+            maxIterations);
+    OPENSIM_THROW_IF(numThreads < 1, Exception,
+            "Expected numThreads to be positive, but got {}.", numThreads);
+
+    std::vector<double> lo(left), hi(right), residual(n), derivative(n);
+    std::vector<double> residualLo(n), residualHi(n);
+    // 0: active, 1: converged, 2: not bracketed.
+    std::vector<char> status(n, 0);
+    for (int i = 0; i < n; ++i) {
+        x[i] = std::min(std::max(x[i], lo[i]), hi[i]);
+    }
+
+    // Each group of problems is solved independently, so groups can be
+    // solved concurrently; all vectors are only accessed within the group's
+    // range.
+    auto solveGroup = [&](int begin, int end) {
+        BatchRootSolveStatistics stats;
+        if (begin == end) return stats;
+        // Residuals at the bounds.
+        calcResiduals(begin, end, lo, residualLo, derivative);
+        calcResiduals(begin, end, hi, residualHi, derivative);
+        int numActive = 0;
+        for (int i = begin; i < end; ++i) {
+            if (residualLo[i] * residualHi[i] > 0 ||
+                    SimTK::isNaN(residualLo[i] * residualHi[i])) {
+                status[i] = 2;
+                ++stats.numNotBracketed;
+            } else {
+                ++numActive;
+            }
+        }
+        int iter = 0;
+        while (numActive > 0 && iter < maxIterations) {
+            calcResiduals(begin, end, x, residual, derivative);
+            ++iter;
+            for (int i = begin; i < end; ++i) {
+                if (status[i] != 0) continue;
+                // Shrink the bracket.
+                if (residual[i] * residualLo[i] > 0) {
+                    lo[i] = x[i];
+                    residualLo[i] = residual[i];
+                } else {
+                    hi[i] = x[i];
+                    residualHi[i] = residual[i];
+                }
+                if (std::abs(residual[i]) < tolerance ||
+                        hi[i] - lo[i] < tolerance) {
+                    status[i] = 1;
+                    --numActive;
+                    stats.maxIterations = iter;
+                    continue;
+                }
+                const double newton = x[i] - residual[i] / derivative[i];
+                if (newton > lo[i] && newton < hi[i]) {
+                    x[i] = newton;
+                    ++stats.numNewtonSteps;
+                } else {
+                    x[i] = 0.5 * (lo[i] + hi[i]);
+                    ++stats.numBisectionSteps;
+                }
+            }
+        }
+        if (numActive > 0) stats.maxIterations = iter;
+        return stats;
+    };
+
+    BatchRootSolveStatistics stats;
+    stats.numProblems = n;
+    const int numGroups = std::max(1, std::min(numThreads, n));
+    std::vector<BatchRootSolveStatistics> groupStats;
+    if (numGroups == 1) {
+        groupStats.push_back(solveGroup(0, n));
+    } else {
+        std::vector<std::future<BatchRootSolveStatistics>> futures;
+        for (int igroup = 0; igroup < numGroups; ++igroup) {
+            futures.push_back(std::async(std::launch::async, solveGroup,
+                    igroup * n / numGroups, (igroup + 1) * n / numGroups));
+        }
+        for (auto& future : futures) groupStats.push_back(future.get());
+    }
+    for (const auto& group : groupStats) {
+        stats.numNotBracketed += group.numNotBracketed;
+        stats.maxIterations = std::max(stats.maxIterations, group.maxIterations);
+        stats.numNewtonSteps += group.numNewtonSteps;
+        stats.numBisectionSteps += group.numBisectionSteps;
+    }
+    stats.bracketed.resize(n);
+    stats.converged.resize(n);
+    for (int i = 0; i < n; ++i) {
+        stats.bracketed[i] = status[i] != 2;
+        stats.converged[i] = status[i] == 1;
+    }
+    stats.numConverged = (int)std::count(status.begin(), status.end(), 1);
+    return stats;
+}
+
 SimTK::Matrix OpenSim::computeKNearestNeighbors(const SimTK::Matrix& x,
         const SimTK::Matrix& y, int k) {
 
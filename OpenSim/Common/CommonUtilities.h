@@ -30,6 +30,7 @@
 #include <memory>
 #include <mutex>
 #include <stack>
+#include <vector>
 #include <condition_variable>
 
 #include <SimTKcommon/internal/BigMatrix.h>
@@ -130,6 +131,60 @@ SimTK::Real solveBisection(std::function<double(const double&)> calcResidual,
         double left, double right, const double& tolerance = 1e-6,
         int maxIterations = 1000);
 
+/// Iteration statistics returned by solveNewtonBisectionBatch().
+/// @ingroup commonutil
+struct BatchRootSolveStatistics {
+    /// The number of scalar problems.
+    int numProblems = 0;
+    /// The number of problems whose root was found within the tolerance.
+    int numConverged = 0;
+    /// The number of problems whose residual had the same sign at both
+    /// bounds; these problems are not solved.
+    int numNotBracketed = 0;
+    /// The largest number of iterations taken by any problem.
+    int maxIterations = 0;
+    /// The total number of Newton and bisection steps over all problems.
+    int numNewtonSteps = 0;
+    int numBisectionSteps = 0;
+    /// For each problem, whether the root was bracketed by the bounds and
+    /// whether the solver converged.
+    std::vector<bool> bracketed;
+    std::vector<bool> converged;
+};
+
+/// Solve many independent scalar root-finding problems at once using
+/// Newton's method safeguarded by bisection. The problems are advanced in
+/// lockstep: each iteration evaluates the residuals and derivatives of a group
+/// of problems with a single call to `calcResiduals`, so that the residual
+/// computation can operate on contiguous arrays. Each problem keeps a bracket
+/// on its root; a Newton step that leaves the bracket (or has a zero
+/// derivative) is replaced by a bisection step. Problems that have converged
+/// are masked out of further updates.
+/// @param calcResiduals computes `residual[i]` and `derivative[i]` (of the
+///     residual with respect to `x[i]`) for all `i` in `[begin, end)`. The
+///     derivative may be approximate, at the cost of more iterations. If
+///     `numThreads > 1`, this function is called concurrently for disjoint
+///     ranges.
+/// @param[in,out] x on input, the initial guesses (these are clamped to the
+///     bounds); on output, the roots. Problems that are not bracketed keep
+///     their initial guess.
+/// @param left lower bounds on the roots.
+/// @param right upper bounds on the roots.
+/// @param tolerance a problem has converged when the magnitude of its
+///     residual or the width of its bracket is less than this value.
+/// @param maxIterations the maximum number of iterations for each problem.
+/// @param numThreads the problems are divided into this many contiguous groups
+///     that are solved concurrently.
+/// @ingroup commonutil
+OSIMCOMMON_API
+BatchRootSolveStatistics solveNewtonBisectionBatch(
+        std::function<void(int begin, int end, const std::vector<double>& x,
+                std::vector<double>& residual,
+                std::vector<double>& derivative)> calcResiduals,
+        std::vector<double>& x, const std::vector<double>& left,
+        const std::vector<double>& right, double tolerance = 1e-6,
+        int maxIterations = 100, int numThreads = 1);
+
 /// This class lets you store objects of a single type for reuse by multiple
 /// threads, ensuring threadsafe access to each of those objects.
 /// @ingroup commonutil
@@ -1390,6 +1390,9 @@ void Component::markPropertiesAsSubcomponents()
     // Now mark properties that are Components as subcomponents
     //loop over all its properties
     for (int i = 0; i < getNumProperties(); ++i) {
+        // Deferred properties never hold Components (see
+        // Object::registerDeferrableType()); do not read them.
+        if (isPropertyDeferred(i)) continue;
         auto& prop = getPropertyByIndex(i);
         // check if property is of type Object
         if (prop.isObjectProperty()) {
@@ -1742,6 +1745,12 @@ void Component::extendRealizeTopology(SimTK::State& s) const
             cv.maybeUninitIndex = subSys.allocateLazyCacheEntry(s, cv.dependsOnStage, cv.value->clone());
         }
     }
+
+    // Allocate cache entries for the outputs whose values are cached. The
+    // outputs are stored in a std::map, so the order is deterministic.
+    for (const auto& kv : _outputsTable) {
+        kv.second->allocateCacheEntries(s, subSys.getMySubsystemIndex());
+    }
 }
 
 
@@ -3782,6 +3782,28 @@ protected:
         };
         return constructOutput<T>(name, outputFunc, dependsOn, true);
     }
+    /** Construct an output that can have multiple channels, like the above,
+    and that can also compute the values of all of its channels at once (see
+    Output::getValues()). The member function `valuesFunc` must fill its
+    vector argument with the value of each channel, in the order of
+    Output::getChannels(). */
+    template <typename T, typename CompType>
+    bool constructListOutput(const std::string& name,
+             T (CompType::*const memFunc)(const SimTK::State&,
+                                          const std::string& channel) const,
+             void (CompType::*const valuesFunc)(const SimTK::State&,
+                                                std::vector<T>& values) const,
+            const SimTK::Stage& dependsOn = SimTK::Stage::Acceleration) {
+        constructListOutput<T, CompType>(name, memFunc, dependsOn);
+        auto valuesFcn = [valuesFunc] (const Component* comp,
+                const SimTK::State& s, std::vector<T>& values) -> void {
+            std::mem_fn(valuesFunc)(
+                    dynamic_cast<const CompType*>(comp), s, values);
+        };
+        Output<T>::updDowncast(_outputsTable[name].updRef())
+                .setValuesFunction(valuesFcn);
+        return true;
+    }
 #endif
 
     /** Construct an Output for a StateVariable. While this method is a
@@ -36,9 +36,11 @@
 
 #include <functional>
 #include <map>
+#include <vector>
 
 #include <SimTKcommon/internal/Stage.h>
 #include <SimTKcommon/internal/State.h>
+#include <SimTKcommon/internal/Value.h>
 
 namespace OpenSim {
 
@@ -95,6 +97,13 @@ public:
  * An Output can either be a single-value Output or a list Output. A list Output
  * is one that can have multiple Channels. The Channels are what get connected
  * to Inputs.
+ *
+ * If an Output is read several times for the same State (e.g., by multiple
+ * reporters, or by a reporter and a Moco goal), its value can be cached in
+ * the State by enabling caching (see setCachingEnabled()) before the System
+ * is created (e.g., before Model::initSystem()). The cached value of each
+ * channel is invalidated whenever the State changes at or below the Output's
+ * dependsOnStage.
  * @author  Ajay Seth
  */
 
@@ -145,6 +154,18 @@ public:
     void         setNumberOfSignificantDigits(unsigned int numSigFigs) 
     { _numSigFigs = numSigFigs; }
 
+    /** Store the value of each channel of this Output in the State, so that
+     * reading the value again before the State changes at or below
+     * getDependsOnStage() does not recompute it. Only enable caching for
+     * Outputs whose value depends on nothing but the State up to
+     * getDependsOnStage() (this is the contract of dependsOnStage). Caching
+     * takes effect the next time the System's topology is realized (e.g., in
+     * Model::initSystem()). Caching is disabled by default. */
+    void setCachingEnabled(bool enabled) { _cachingEnabled = enabled; }
+    /** Is the value of this Output cached in the State?
+     * @see setCachingEnabled() */
+    bool getCachingEnabled() const { return _cachingEnabled; }
+
 protected:
 
     // Set the component that contains this Output.
@@ -152,6 +173,13 @@ protected:
         _owner.reset(&owner);
     }
 
+    /** Allocate a lazy cache entry for each channel in the given subsystem
+     * of the State if caching is enabled, otherwise forget any previously
+     * allocated entries. Called by the owner Component while realizing
+     * topology. */
+    virtual void allocateCacheEntries(SimTK::State& state,
+            SimTK::SubsystemIndex subsystemIndex) const = 0;
+
     SimTK::ReferencePtr<const Component> _owner;
 
 private:
@@ -159,6 +187,7 @@ private:
     SimTK::Stage dependsOnStage;
     unsigned int _numSigFigs = 8;
     bool _isList = false;
+    bool _cachingEnabled = false;
 
     // For calling setOwner().
     friend Component;
@@ -202,9 +231,11 @@ public:
     /** Custom copy constructor is for setting the Channel's pointer
      * back to this Output. */
     Output(const Output& source) : AbstractOutput(source),
-            _outputFcn(source._outputFcn), _channels(source._channels) {
+            _outputFcn(source._outputFcn), _valuesFcn(source._valuesFcn),
+            _channels(source._channels) {
         for (auto& it : _channels) {
             it.second._output.reset(this);
+            it.second._cacheIndex.invalidate();
         }
     }
     
@@ -214,9 +245,11 @@ public:
         if (&source == this) return *this;
         AbstractOutput::operator=(source);
         _outputFcn = source._outputFcn;
+        _valuesFcn = source._valuesFcn;
         _channels = source._channels;
         for (auto& it : _channels) {
             it.second._output.reset(this);
+            it.second._cacheIndex.invalidate();
         }
         return *this;
     }
@@ -289,8 +322,48 @@ public:
                     state.getSystemStage(), getDependsOnStage(),
                     "Output::getValue(state)");
         }
-        _outputFcn(_owner.get(), state, "", _result);
-        return _result;
+        return _channels.begin()->second.getValue(state);
+    }
+
+    /** Get the values of all channels of this Output in channel name order
+     * (the order of getChannels()), e.g., to report a list Output without
+     * looking up its channels by name. The values of a single-value Output
+     * consist of its value. If a values function is set (see
+     * setValuesFunction()), all channels are evaluated in one call to it;
+     * otherwise, each channel is evaluated separately. If caching is enabled,
+     * the values are cached as for Channel::getValue(). */
+    void getValues(const SimTK::State& state, std::vector<T>& values) const {
+        if (state.getSystemStage() < getDependsOnStage()) {
+            throw SimTK::Exception::StageTooLow(__FILE__, __LINE__,
+                    state.getSystemStage(), getDependsOnStage(),
+                    "Output::getValues(state)");
+        }
+        if (_valuesFcn && !areAllValuesCached(state)) {
+            _valuesFcn(_owner.get(), state, values);
+            OPENSIM_THROW_IF(values.size() != _channels.size(), Exception,
+                    "Expected the values function of Output '{}' to "
+                    "provide {} values, but it provided {}.",
+                    getName(), _channels.size(), values.size());
+            auto value = values.begin();
+            for (const auto& it : _channels) {
+                it.second.cacheValue(state, *value++);
+            }
+            return;
+        }
+        values.resize(_channels.size());
+        auto value = values.begin();
+        for (const auto& it : _channels) {
+            *value++ = it.second.getValue(state);
+        }
+    }
+
+    /** Set a function that computes the values of all channels at once, in
+     * channel name order (the order of getChannels()), for getValues(). The
+     * function must resize its vector argument to the number of channels.
+     * Individual channels are still evaluated with the output function. */
+    void setValuesFunction(const std::function<void (const Component* comp,
+            const SimTK::State&, std::vector<T>&)>& valuesFunction) {
+        _valuesFcn = valuesFunction;
     }
     
     std::string getTypeName() const override {
@@ -317,12 +390,42 @@ public:
         return dynamic_cast<Output<T>*>(parent);
     }
 
+protected:
+    // Do all channels have a valid cached value in the State?
+    bool areAllValuesCached(const SimTK::State& state) const {
+        if (!getCachingEnabled()) return false;
+        for (const auto& it : _channels) {
+            if (!it.second._cacheIndex.isValid() ||
+                    !state.isCacheValueRealized(
+                            _cacheSubsystemIndex, it.second._cacheIndex)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void allocateCacheEntries(SimTK::State& state,
+            SimTK::SubsystemIndex subsystemIndex) const override {
+        for (const auto& it : _channels) {
+            it.second._cacheIndex.invalidate();
+            if (getCachingEnabled()) {
+                it.second._cacheIndex = state.allocateLazyCacheEntry(
+                        subsystemIndex, getDependsOnStage(),
+                        new SimTK::Value<T>());
+            }
+        }
+        _cacheSubsystemIndex = subsystemIndex;
+    }
+
 private:
-    mutable T _result;
+    mutable SimTK::SubsystemIndex _cacheSubsystemIndex;
     std::function<void (const Component*,
                         const SimTK::State&,
                         const std::string& channel,
                         T& result)> _outputFcn { nullptr };
+    std::function<void (const Component*,
+                        const SimTK::State&,
+                        std::vector<T>& values)> _valuesFcn { nullptr };
     // TODO consider using indices, and having a parallel data structure
     // for names.
     std::map<std::string, Channel> _channels;
@@ -338,8 +441,22 @@ public:
     Channel(const Output<T>* output, const std::string& channelName)
      : _output(output), _channelName(channelName) {}
     const T& getValue(const SimTK::State& state) const {
+        const Output<T>& output = _output.getRef();
+        if (_cacheIndex.isValid() &&
+                state.getSystemStage() >= output.getDependsOnStage()) {
+            const SimTK::SubsystemIndex ssIndex = output._cacheSubsystemIndex;
+            if (!state.isCacheValueRealized(ssIndex, _cacheIndex)) {
+                T& value = SimTK::Value<T>::downcast(
+                        state.updCacheEntry(ssIndex, _cacheIndex)).upd();
+                output._outputFcn(output._owner.get(), state, _channelName,
+                        value);
+                state.markCacheValueRealized(ssIndex, _cacheIndex);
+            }
+            return SimTK::Value<T>::downcast(
+                    state.getCacheEntry(ssIndex, _cacheIndex)).get();
+        }
         // Must cache, since we're returning a reference.
-        _output->_outputFcn(_output->_owner.get(), state, _channelName, _result);
+        output._outputFcn(output._owner.get(), state, _channelName, _result);
         return _result;
     }
     const Output<T>& getOutput() const { return _output.getRef(); }
@@ -358,14 +475,30 @@ public:
         return getOutput().getOwner().getAbsolutePathString() + "|" + getName();
     }
 private:
+    // Store a value computed by the Output's values function, if caching is
+    // enabled.
+    void cacheValue(const SimTK::State& state, const T& value) const {
+        const Output<T>& output = _output.getRef();
+        if (!_cacheIndex.isValid()) return;
+        const SimTK::SubsystemIndex ssIndex = output._cacheSubsystemIndex;
+        SimTK::Value<T>::downcast(state.updCacheEntry(ssIndex, _cacheIndex))
+                .upd() = value;
+        state.markCacheValueRealized(ssIndex, _cacheIndex);
+    }
+
     mutable T _result;
     SimTK::ReferencePtr<const Output<T>> _output;
     std::string _channelName;
+    // Index of the entry in the State that caches this channel's value, if
+    // caching is enabled for the Output.
+    mutable SimTK::CacheEntryIndex _cacheIndex;
     
 #ifndef SWIG // These declarations cause a warning in SWIG.
     // To allow Output<T> to set the _output pointer upon copy.
     friend Output<T>::Output(const Output&);
     friend Output<T>& Output<T>::operator=(const Output&);
+    // To allow Output<T> to allocate the cache entry.
+    friend class Output<T>;
 #endif
 };
 } // end of namespace OpenSim
@@ -467,6 +600,31 @@ private:
     };                                                                      \
     /** @endcond                                                         */
 
+/** Create a list Output like #OpenSim_DECLARE_LIST_OUTPUT, which can also
+ * compute the values of all of its channels in one call to the member function
+ * `valuesFunc`, with signature
+ * `void valuesFunc(const SimTK::State&, std::vector<T>& values) const`. The
+ * values are in the order of Output::getChannels(); see Output::getValues().
+ * @relates OpenSim::Output
+ */
+#define OpenSim_DECLARE_LIST_OUTPUT_WITH_VALUES(oname, T, func, valuesFunc, \
+                                                ostage)                     \
+    /** @name Outputs (list)                                             */ \
+    /** @{                                                               */ \
+    /** Provides the value of func##() and is available at stage ostage. */ \
+    /** This output can have multiple channels, whose values are all     */ \
+    /** provided by valuesFunc##().                                      */ \
+    /** This output was generated with the                               */ \
+    /** #OpenSim_DECLARE_LIST_OUTPUT_WITH_VALUES macro.                  */ \
+    OpenSim_DOXYGEN_Q_PROPERTY(T, oname)                                    \
+    /** @}                                                               */ \
+    /** @cond                                                            */ \
+    bool _has_output_##oname {                                              \
+        this->template constructListOutput<T>(#oname, &Self::func,          \
+                &Self::valuesFunc, ostage)                                  \
+    };                                                                      \
+    /** @endcond                                                         */
+
 // Note: we could omit the T argument from the above macro by using the
 // following code to deduce T from the provided func
 //      std::result_of<decltype(&Self::func)(Self, const SimTK::State&)>::type
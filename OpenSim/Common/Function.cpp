@@ -29,6 +29,7 @@
 // INCLUDES
 #include "Function.h"
 
+#include <mutex>
 
 using namespace OpenSim;
 using namespace std;
@@ -38,6 +39,14 @@ using SimTK::Vector;
 //=============================================================================
 // STATICS
 //=============================================================================
+namespace {
+    // Serializes the creation of the SimTK::Function of every Function.
+    std::mutex& simTKFunctionMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+}
 
 
 //=============================================================================
@@ -57,7 +66,8 @@ Function::~Function()
  * Default constructor.
  */
 Function::Function() :
-    _function(NULL)
+    _function(NULL),
+    _functionIsCreated(false)
 {
     setNull();
 }
@@ -69,7 +79,8 @@ Function::Function() :
  */
 Function::Function(const Function &aFunction) :
     Object(aFunction),
-    _function(NULL)
+    _function(NULL),
+    _functionIsCreated(false)
 {
 }
 
@@ -161,30 +172,53 @@ evaluateTotalSecondDerivative(double aX,double aDxdt,double aD2xdt2)
 */
 double Function::calcValue(const Vector& x) const
 {
-    if (_function == NULL)
-        _function = createSimTKFunction();
-    return _function->calcValue(x);
+    return getSimTKFunction().calcValue(x);
 }
 
 double Function::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
 {
-    if (_function == NULL)
-        _function = createSimTKFunction();
-    return _function->calcDerivative(derivComponents, x);
+    return getSimTKFunction().calcDerivative(derivComponents, x);
+}
+
+void Function::calcValues(const Vector& x, int maxDerivOrder,
+        SimTK::Matrix& values) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(maxDerivOrder < 0, Exception,
+            "Expected maxDerivOrder to be non-negative, but got {}.",
+            maxDerivOrder);
+    values.resize(x.size(), maxDerivOrder + 1);
+    Vector arg(1);
+    std::vector<int> derivComponents;
+    for (int i = 0; i < x.size(); ++i) {
+        arg[0] = x[i];
+        values(i, 0) = calcValue(arg);
+        derivComponents.clear();
+        for (int k = 1; k <= maxDerivOrder; ++k) {
+            derivComponents.push_back(0);
+            values(i, k) = calcDerivative(derivComponents, arg);
+        }
+    }
 }
 
 int Function::getArgumentSize() const
 {
-    if (_function == NULL)
-        _function = createSimTKFunction();
-    return _function->getArgumentSize();
+    return getSimTKFunction().getArgumentSize();
 }
 
 int Function::getMaxDerivativeOrder() const
 {
-    if (_function == NULL)
-        _function = createSimTKFunction();
-    return _function->getMaxDerivativeOrder();
+    return getSimTKFunction().getMaxDerivativeOrder();
+}
+
+const SimTK::Function& Function::getSimTKFunction() const
+{
+    if (!_functionIsCreated.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(simTKFunctionMutex());
+        if (_function == NULL)
+            _function = createSimTKFunction();
+        _functionIsCreated.store(true, std::memory_order_release);
+    }
+    return *_function;
 }
 
 void Function::resetFunction()
@@ -192,4 +226,5 @@ void Function::resetFunction()
     if (_function != NULL)
         delete _function;
     _function = NULL;
+    _functionIsCreated = false;
 }
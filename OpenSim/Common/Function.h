@@ -32,6 +32,8 @@
 #include "Object.h"
 #include "SimTKmath.h"
 
+#include <atomic>
+
 
 //=============================================================================
 //=============================================================================
@@ -114,6 +116,20 @@ public:
      * @param x                the Vector of input arguments.  Its size must equal the value returned by getArgumentSize().
      */
     virtual double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const;
+    /**
+     * Calculate the value and derivatives of this function of one variable
+     * at many points at once. The default implementation calls calcValue()
+     * and calcDerivative() for each point; subclasses (e.g., GCVSpline) may
+     * provide a faster implementation.
+     *
+     * @param x              the points at which to evaluate the function.
+     * @param maxDerivOrder  the highest derivative order to calculate (0
+     *                       calculates only the value).
+     * @param[out] values    resized to x.size() rows and maxDerivOrder+1
+     *                       columns; column k contains the k-th derivative.
+     */
+    virtual void calcValues(const SimTK::Vector& x, int maxDerivOrder,
+            SimTK::Matrix& values) const;
     /**
      * Get the number of components expected in the input vector.
      */
@@ -129,12 +145,24 @@ public:
     virtual SimTK::Function* createSimTKFunction() const = 0;
 
 protected:
+    /**
+     * Return the internal SimTK::Function object used to evaluate this
+     * function, creating it with createSimTKFunction() if necessary. This may
+     * be called from multiple threads at once.
+     */
+    const SimTK::Function& getSimTKFunction() const;
     /**
      * This should be called whenever this object has been modified.  It clears 
      * the internal SimTK::Function object used to evaluate it.
      */
     void resetFunction();
 
+private:
+#ifndef SWIG
+    // Whether _function has been created by getSimTKFunction().
+    mutable std::atomic<bool> _functionIsCreated;
+#endif
+
 //=============================================================================
 };  // END class Function
 
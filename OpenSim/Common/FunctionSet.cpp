@@ -154,3 +154,22 @@ evaluate(Array<double> &rValues,int aDerivOrder,double aX) const
         }
     }
 }
+
+void FunctionSet::calcValues(const SimTK::Vector& x, int maxDerivOrder,
+        std::vector<SimTK::Matrix>& values) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(maxDerivOrder < 0, Exception,
+            "Expected maxDerivOrder to be non-negative, but got {}.",
+            maxDerivOrder);
+    const int numFunctions = getSize();
+    values.resize(maxDerivOrder + 1);
+    for (auto& matrix : values) matrix.resize(x.size(), numFunctions);
+
+    SimTK::Matrix functionValues;
+    for (int i = 0; i < numFunctions; ++i) {
+        get(i).calcValues(x, maxDerivOrder, functionValues);
+        for (int k = 0; k <= maxDerivOrder; ++k) {
+            values[k].updCol(i) = functionValues.col(k);
+        }
+    }
+}
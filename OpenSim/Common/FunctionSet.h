@@ -75,6 +75,22 @@ public:
     virtual void
         evaluate(Array<double> &rValues,int aDerivOrder,
         double aX=0.0) const;
+#ifndef SWIG
+    /**
+     * Evaluate all functions in the set and their derivatives at many values
+     * of the independent variable at once (see Function::calcValues()). For
+     * a GCVSplineSet, this is much faster than calling evaluate() for each
+     * value if the values are sorted in nondecreasing order.
+     *
+     * @param x Values of the independent variable.
+     * @param maxDerivOrder Highest derivative order to evaluate.
+     * @param[out] values Resized to maxDerivOrder+1 matrices; matrix k has a
+     * row for each value in x and a column for each function in the set, and
+     * contains the k-th derivatives of the functions.
+     */
+    void calcValues(const SimTK::Vector& x, int maxDerivOrder,
+            std::vector<SimTK::Matrix>& values) const;
+#endif
 
 //=============================================================================
 };  // END class FunctionSet
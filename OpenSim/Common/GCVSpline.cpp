@@ -600,3 +600,27 @@ SimTK::Function* GCVSpline::createSimTKFunction() const {
     return spline;
 }
 
+void GCVSpline::calcValues(const SimTK::Vector& x, int maxDerivOrder,
+        SimTK::Matrix& values) const {
+    OPENSIM_THROW_IF_FRMOBJ(maxDerivOrder < 0, Exception,
+            "Expected maxDerivOrder to be non-negative, but got {}.",
+            maxDerivOrder);
+
+    // The coefficients are updated when the underlying SimTK::Function is
+    // created, so make sure that has happened.
+    getArgumentSize();
+
+    const int n = _x.getSize();
+    double* knots = const_cast<double*>(_x.get());
+    double* coefficients = const_cast<double*>(_coefficients.get());
+    std::vector<double> work(2 * _halfOrder);
+    // splder() starts its search for the knot interval from this index.
+    int interval = 1;
+    values.resize(x.size(), maxDerivOrder + 1);
+    for (int i = 0; i < x.size(); ++i) {
+        for (int k = 0; k <= maxDerivOrder; ++k) {
+            values(i, k) = splder(k, _halfOrder, n, x[i], knots, coefficients,
+                    &interval, work.data());
+        }
+    }
+}
@@ -233,6 +233,16 @@ public:
     //--------------------------------------------------------------------------
     // EVALUATION
     //--------------------------------------------------------------------------
+    /**
+     * Evaluate the spline and its derivatives at many values of the
+     * independent variable at once (see Function::calcValues()). The knot
+     * interval containing each value is found by advancing from the interval
+     * of the previous value, rather than by searching the knot sequence
+     * again, so the values should be sorted in nondecreasing order for best
+     * performance.
+     */
+    void calcValues(const SimTK::Vector& x, int maxDerivOrder,
+            SimTK::Matrix& values) const override;
 
 //=============================================================================
 };  // END class GCVSpline
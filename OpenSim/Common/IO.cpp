@@ -488,6 +488,22 @@ makeDir(const string &aDirName)
 #else
     return _mkdir(aDirName.c_str());
 #endif
+}
+//_____________________________________________________________________________
+/**
+ * Remove an empty directory. Potentially platform dependent.
+  * @return int 0 on success, error condition otherwise
+*/
+int IO::
+removeDir(const string &aDirName)
+{
+
+#if defined __linux__ || defined __APPLE__
+    return rmdir(aDirName.c_str());
+#else
+    return _rmdir(aDirName.c_str());
+#endif
+
 }
 //_____________________________________________________________________________
 /**
@@ -54,8 +54,33 @@ std::map<string,Object*>    Object::_mapTypesToDefaultObjects;
 std::map<string,string>     Object::_renamedTypesMap;
 
 bool                        Object::_serializeAllDefaults=false;
+bool                        Object::_lazyDeserialization=false;
+std::set<string>            Object::_deferrableTypes;
 const string                Object::DEFAULT_NAME(ObjectDEFAULT_NAME);
 
+namespace {
+    // The document of the Object whose file is being read on this thread, if
+    // any. Lazily read properties keep a reference to it rather than copying
+    // their XML (see PropertyTable::deferReadFromXMLParentElement()).
+    thread_local std::shared_ptr<XMLDocument> documentBeingRead;
+
+    // Sets the document being read on this thread until it goes out of
+    // scope. Files that are included by other files are read in nested
+    // scopes.
+    class DocumentBeingRead {
+    public:
+        explicit DocumentBeingRead(std::shared_ptr<XMLDocument> document) :
+            _previous(std::move(documentBeingRead)) {
+            documentBeingRead = std::move(document);
+        }
+        ~DocumentBeingRead() { documentBeingRead = std::move(_previous); }
+        DocumentBeingRead(const DocumentBeingRead&) = delete;
+        DocumentBeingRead& operator=(const DocumentBeingRead&) = delete;
+    private:
+        std::shared_ptr<XMLDocument> _previous;
+    };
+}
+
 //=============================================================================
 // CONSTRUCTOR(S)
 //=============================================================================
@@ -114,6 +139,7 @@ Object::Object(const string &aFileName, bool aUpdateFromXMLNode)
     // of an exception.
     if (aUpdateFromXMLNode) {
         IO::CwdChanger cwd = IO::CwdChanger::changeToParentOf(aFileName);
+        DocumentBeingRead documentScope(_document);
         updateFromXMLNode(myNode, _document->getDocumentVersion());
     }
 }
@@ -711,6 +737,7 @@ void Object::readObjectFromXMLNodeOrFile
     }
     _inlined=false;
     SimTK::Xml::Element e = _document->getRootDataElement();
+    DocumentBeingRead documentScope(_document);
     updateFromXMLNode(e, _document->getDocumentVersion());
 }
 
@@ -789,7 +816,13 @@ try {
     // LOOP THROUGH PROPERTIES
     for(int i=0; i < _propertyTable.getNumProperties(); ++i) {
         AbstractProperty& prop = _propertyTable.updAbstractPropertyByIndex(i);
-        prop.readFromXMLParentElement(aNode, versionNumber);
+        if (_lazyDeserialization && prop.isUnnamedProperty() &&
+                _deferrableTypes.count(prop.getTypeName())) {
+            _propertyTable.deferReadFromXMLParentElement(
+                    i, aNode, versionNumber, documentBeingRead);
+        } else {
+            prop.readFromXMLParentElement(aNode, versionNumber);
+        }
     }
 
     // LOOP THROUGH DEPRECATED PROPERTIES
@@ -1595,6 +1628,7 @@ makeObjectFromFile(const std::string &aFileName)
         // properly
         IO::CwdChanger cwd = IO::CwdChanger::changeToParentOf(aFileName);
         newObject->_document = std::move(doc);
+        DocumentBeingRead documentScope(newObject->_document);
         if (newFormat) {
             newObject->updateFromXMLNode(*newObject->_document->getRootElement().element_begin(), newObject->_document->getDocumentVersion());
         } else {
@@ -1620,6 +1654,9 @@ void Object::makeObjectNamesConsistentWithProperties()
     // Cycle through this object's Object properties and make sure those
     // that are objects have names that are consistent with object property. 
     for (int i = 0; i < getNumProperties(); ++i) {
+        // Deferred properties are unnamed, and hold no named object
+        // properties; do not read them.
+        if (isPropertyDeferred(i)) continue;
         auto& prop = updPropertyByIndex(i);  // CARE: sets object as not up to date
         // check if property is of type Object
         if (prop.isObjectProperty()) {
@@ -1660,6 +1697,7 @@ void Object::updateFromXMLDocument()
 
     SimTK::Xml::Element e = _document->getRootDataElement();
     IO::CwdChanger cwd = IO::CwdChanger::changeToParentOf(_document->getFileName());
+    DocumentBeingRead documentScope(_document);
     updateFromXMLNode(e, _document->getDocumentVersion());
 }
 
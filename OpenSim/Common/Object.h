@@ -649,6 +649,41 @@ public:
         return _serializeAllDefaults;
     }
 
+    /** Static function to control whether properties that only affect how an
+    object is displayed are read lazily when objects are read from XML. When
+    this is on, an unnamed property holding an object of a type registered
+    with registerDeferrableType() (e.g., the Appearance of Geometry and
+    paths) keeps its XML, which is read the first time the property is
+    accessed; the result is the same as reading the property right away.
+    Objects read from a file share a reference to the file's document rather
+    than copying their XML.
+    This reduces the time to load large models in tools that do not display
+    them. Off by default. **/
+    static void setLazyDeserialization(bool shouldDeferDisplayProperties)
+    {
+        _lazyDeserialization = shouldDeferDisplayProperties;
+    }
+    /** Report the value of the "lazy deserialization" flag. **/
+    static bool getLazyDeserialization()
+    {
+        return _lazyDeserialization;
+    }
+    /** Register an Object type, by class name, whose unnamed properties may
+    be read lazily (see setLazyDeserialization()). The type must hold only
+    data that is not needed to build a Component tree or a System; in
+    particular, it must not be a Component. **/
+    static void registerDeferrableType(const std::string& className)
+    {
+        _deferrableTypes.insert(className);
+    }
+    /** Return true if the property at the given index was read lazily (see
+    setLazyDeserialization()) and has not been accessed since; accessing the
+    property reads it. This does not read the property. **/
+    bool isPropertyDeferred(int propertyIndex) const
+    {
+        return _propertyTable.isPropertyDeferred(propertyIndex);
+    }
+
     /** Returns true if the passed-in string is "Object"; each %Object-derived
     class defines a method of this name for its own class name. **/
     static bool isKindOf(const char *type) 
@@ -895,6 +930,11 @@ private:
     // a "defaults" section.
     static bool _serializeAllDefaults;
 
+    // Global flag to indicate if properties holding registered deferrable
+    // types are read lazily, and the class names of those types.
+    static bool _lazyDeserialization;
+    static std::set<std::string> _deferrableTypes;
+
     // The name of this object.
     std::string     _name;
     // A short description of the object.
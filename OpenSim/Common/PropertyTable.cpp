@@ -24,8 +24,106 @@
 
 #include "Assertion.h"
 
+#include <mutex>
+
 using namespace OpenSim;
 
+struct PropertyTable::PropertyHolder::DeferredXML {
+    // The document that holds the property's elements: either the document
+    // the property was read from, or one whose root element holds copies of
+    // the elements.
+    std::shared_ptr<SimTK::Xml::Document> document;
+    // The parent of the property's elements, within the document.
+    SimTK::Xml::Element parent;
+    int versionNumber;
+};
+
+namespace {
+    // Serializes the reading of deferred XML. Copies of a PropertyTable share
+    // the deferred XML, and reading it modifies the elements temporarily (see
+    // AbstractProperty::readFromXMLParentElement()). The mutex is recursive
+    // since reading an Object may read deferred properties of its own.
+    std::recursive_mutex& deferredXMLMutex()
+    {
+        static std::recursive_mutex mutex;
+        return mutex;
+    }
+
+    // Whether the element, or any element within it, includes another file.
+    bool hasFileAttribute(SimTK::Xml::Element& element)
+    {
+        if (element.hasAttribute("file")) return true;
+        for (auto iter = element.element_begin();
+                iter != element.element_end(); ++iter) {
+            if (hasFileAttribute(*iter)) return true;
+        }
+        return false;
+    }
+
+    // Whether the element is within the document's tree.
+    bool isInDocument(SimTK::Xml::Element element,
+            SimTK::Xml::Document& document)
+    {
+        while (element.hasParentElement()) {
+            element = element.getParentElement();
+        }
+        return element == document.getRootElement();
+    }
+}
+
+PropertyTable::PropertyHolder::PropertyHolder(const PropertyHolder& other)
+{
+    *this = other;
+}
+
+PropertyTable::PropertyHolder::PropertyHolder(PropertyHolder&& other) noexcept :
+    _ptr{std::move(other._ptr)},
+    _deferred{std::move(other._deferred)},
+    _isDeferred{other._isDeferred.load(std::memory_order_relaxed)}
+{}
+
+PropertyTable::PropertyHolder&
+PropertyTable::PropertyHolder::operator=(const PropertyHolder& other)
+{
+    if (&other == this) return *this;
+    // Another thread may be reading the other property's deferred XML.
+    std::unique_lock<std::recursive_mutex> lock(deferredXMLMutex(),
+                                                std::defer_lock);
+    if (other.isDeferred()) lock.lock();
+    _ptr = other._ptr;
+    _deferred = other._deferred;
+    _isDeferred.store(other._isDeferred.load(std::memory_order_relaxed),
+                      std::memory_order_release);
+    return *this;
+}
+
+PropertyTable::PropertyHolder&
+PropertyTable::PropertyHolder::operator=(PropertyHolder&& other) noexcept
+{
+    _ptr = std::move(other._ptr);
+    _deferred = std::move(other._deferred);
+    _isDeferred.store(other._isDeferred.load(std::memory_order_relaxed),
+                      std::memory_order_release);
+    return *this;
+}
+
+void PropertyTable::PropertyHolder::defer(std::shared_ptr<DeferredXML> xml)
+{
+    _deferred = std::move(xml);
+    _isDeferred.store(true, std::memory_order_release);
+}
+
+void PropertyTable::PropertyHolder::readDeferred() const
+{
+    std::lock_guard<std::recursive_mutex> lock(deferredXMLMutex());
+    // Another thread may have read it while we waited for the lock.
+    if (!_isDeferred.load(std::memory_order_relaxed)) return;
+    _ptr.upd()->readFromXMLParentElement(
+            _deferred->parent, _deferred->versionNumber);
+    _deferred.reset();
+    _isDeferred.store(false, std::memory_order_release);
+}
+
 void PropertyTable::clear()
 {
     _properties.clear();
@@ -115,3 +213,55 @@ int PropertyTable::findPropertyIndex(const std::string& name) const
     const auto it = _namelookup.find(name);
     return it != _namelookup.end() ? it->second : -1;
 }
+
+void PropertyTable::deferReadFromXMLParentElement(int index,
+        SimTK::Xml::Element& parent, int versionNumber,
+        std::shared_ptr<SimTK::Xml::Document> document)
+{
+    // This also reads any XML that was deferred earlier, so that the result
+    // is the same as if both had been read right away.
+    AbstractProperty& prop = updAbstractPropertyByIndex(index);
+    OPENSIM_ASSERT(prop.isUnnamedProperty());
+
+    // An unnamed property is read from the first element whose tag is an
+    // acceptable object type.
+    bool hasElement = false;
+    for (auto iter = parent.element_begin(); iter != parent.element_end();
+            ++iter) {
+        if (!prop.isAcceptableObjectTag(iter->getElementTag())) continue;
+        if (hasFileAttribute(*iter)) {
+            prop.readFromXMLParentElement(parent, versionNumber);
+            return;
+        }
+        hasElement = true;
+    }
+    if (!hasElement) {
+        prop.readFromXMLParentElement(parent, versionNumber);
+        return;
+    }
+
+    auto deferred = std::make_shared<PropertyHolder::DeferredXML>();
+    deferred->versionNumber = versionNumber;
+    if (document && isInDocument(parent, *document)) {
+        deferred->document = std::move(document);
+        deferred->parent = parent;
+    } else {
+        // Copy the elements, in order.
+        deferred->document = std::make_shared<SimTK::Xml::Document>();
+        deferred->document->setRootTag(parent.getElementTag());
+        deferred->parent = deferred->document->getRootElement();
+        for (auto iter = parent.element_begin(); iter != parent.element_end();
+                ++iter) {
+            if (!prop.isAcceptableObjectTag(iter->getElementTag())) continue;
+            deferred->parent.insertNodeAfter(
+                    deferred->parent.node_end(), iter->clone());
+        }
+    }
+    _properties[index].defer(std::move(deferred));
+}
+
+bool PropertyTable::isPropertyDeferred(int index) const
+{
+    return 0 <= index && index < getNumProperties() &&
+           _properties[index].isDeferred();
+}
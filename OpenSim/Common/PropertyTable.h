@@ -29,6 +29,8 @@
 
 #include <SimTKcommon/internal/ClonePtr.h>
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -50,6 +52,11 @@ namespace OpenSim {
  * means no Object can contain two unnamed properties holding the same type of
  * object since that would appear as a duplicate name.
  *
+ * Reading a property from XML can be deferred (see
+ * deferReadFromXMLParentElement()): the table then keeps the property's XML
+ * elements and reads them the first time the property is accessed, by any of
+ * the methods below. Copies of the table share the unread XML.
+ *
  * @author Cassidy Kelly, Michael Sherman, Adam Kewley
  * @see AbstractProperty, Property, Object
  */
@@ -189,26 +196,70 @@ public:
      */
     int findPropertyIndex(const std::string& name) const;
 
+    /**
+     * Read the property at the given index from the XML element `parent` the
+     * first time the property is accessed, rather than now; the result is the
+     * same as that of AbstractProperty::readFromXMLParentElement(). Only
+     * unnamed properties (see AbstractProperty::isUnnamedProperty()) can be
+     * deferred. If `parent` is within `document`, the table keeps a
+     * reference to `document` and later reads the elements from it, so
+     * `document` must not be modified in the meantime. Otherwise, the
+     * elements of `parent` that hold the property are copied, so `parent`
+     * need not outlive this table. The property is read now if `parent` has
+     * no element for it, or if the element refers to another file (since the
+     * file is found relative to the current directory).
+     */
+    void deferReadFromXMLParentElement(int index, SimTK::Xml::Element& parent,
+            int versionNumber,
+            std::shared_ptr<SimTK::Xml::Document> document = nullptr);
+
+    /**
+     * Return true if the property at the given index has a deferred XML
+     * element that has not been read yet (see deferReadFromXMLParentElement()).
+     * This does not read the property.
+     */
+    bool isPropertyDeferred(int index) const;
+
 private:
 
     // internal class that defines how the property is stored in this table
     class PropertyHolder final {
     public:
+        // The XML elements of a deferred property.
+        struct DeferredXML;
+
         explicit PropertyHolder(AbstractProperty* p) : _ptr{p} {}
+        PropertyHolder(const PropertyHolder& other);
+        PropertyHolder(PropertyHolder&& other) noexcept;
+        PropertyHolder& operator=(const PropertyHolder& other);
+        PropertyHolder& operator=(PropertyHolder&& other) noexcept;
 
         friend bool operator==(const PropertyHolder& lhs, const PropertyHolder& rhs)
         {
-            return *lhs._ptr == *rhs._ptr;
+            return *lhs == *rhs;
         }
 
-        const AbstractProperty* get() const { return _ptr.get(); }
-        AbstractProperty* get() { return _ptr.upd(); }
-        const AbstractProperty& operator*() const { return *_ptr; }
-        AbstractProperty& operator*() { return *_ptr; }
-        const AbstractProperty* operator->() const { return _ptr.get(); }
-        AbstractProperty* operator->() { return _ptr.upd(); }
+        // All access to the property reads the deferred XML first, if any.
+        const AbstractProperty* get() const { read(); return _ptr.get(); }
+        AbstractProperty* get() { read(); return _ptr.upd(); }
+        const AbstractProperty& operator*() const { read(); return *_ptr; }
+        AbstractProperty& operator*() { read(); return *_ptr; }
+        const AbstractProperty* operator->() const { read(); return _ptr.get(); }
+        AbstractProperty* operator->() { read(); return _ptr.upd(); }
+
+        bool isDeferred() const
+        {
+            return _isDeferred.load(std::memory_order_acquire);
+        }
+        void defer(std::shared_ptr<DeferredXML> xml);
     private:
-        SimTK::ClonePtr<AbstractProperty> _ptr;
+        void read() const { if (isDeferred()) readDeferred(); }
+        void readDeferred() const;
+
+        // Mutable so that the deferred XML can be read on const access.
+        mutable SimTK::ClonePtr<AbstractProperty> _ptr;
+        mutable std::shared_ptr<DeferredXML> _deferred;
+        mutable std::atomic<bool> _isDeferred{false};
     };
 
     std::vector<PropertyHolder> _properties;
@@ -64,6 +64,12 @@ public:
     static int
         LowpassIIR(double aDeltaT,double aCutOffFrequency,
         int aN,const double *aSignal,double *rFilteredSignal);
+    /// Filter multiple signals in place with the same filter as
+    /// LowpassIIR(). aSignals holds pointers to the aN contiguous samples of
+    /// each of the aNumSignals signals (e.g., the columns of a SimTK::Matrix).
+    static int
+        LowpassIIR(double aDeltaT,double aCutOffFrequency,
+        int aN,int aNumSignals,double *const *aSignals);
     static int
         LowpassFIR(int aOrder,double aDeltaT,double aCutoffFrequency,
         int aN,double *aSignal,double *rFilteredSignal);
@@ -1,10 +1,109 @@
 #include "TRCFileAdapter.h"
 #include <OpenSim/Common/IO.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <future>
 #include <iomanip>
+#include <sstream>
+#include <thread>
 
 namespace OpenSim {
 
+namespace {
+// A line of the data section, as a range of characters excluding the line
+// ending.
+struct TRCLine {
+    const char* begin;
+    const char* end;
+};
+
+// Parse a number from a field (excluding delimiters) of a data row. Blank
+// fields are NaN and set 'blank' to true.
+double parseTRCField(const char* begin, const char* end,
+        const std::string& fileName, std::size_t lineNum, bool& blank) {
+    // Trim whitespace as FileAdapter::tokenize() does.
+    while (begin < end && std::isspace(static_cast<unsigned char>(*begin)))
+        ++begin;
+    while (end > begin && std::isspace(static_cast<unsigned char>(*(end - 1))))
+        --end;
+    if (begin == end) {
+        blank = true;
+        return SimTK::NaN;
+    }
+    // Fields are followed by a delimiter, a line ending, or the terminating
+    // null character of the buffer, so strtod() cannot read past the field.
+    char* parsedEnd = nullptr;
+    const double value = std::strtod(begin, &parsedEnd);
+    OPENSIM_THROW_IF(parsedEnd == begin, IOError,
+            "Error reading rows in file '" + fileName + "'. Could not parse '"
+            + std::string(begin, end) + "' as a number in line "
+            + std::to_string(lineNum) + ".");
+    return value;
+}
+
+// Parse the rows [first, last) of the data section into 'times' and
+// 'markerData'. Fields are split on tabs and carriage returns, consistently
+// with FileAdapter::getNextLine(). Only the markers whose (file) indices are in
+// 'markerIndices' are parsed. Returns the index of the first row that does not
+// have 'expected' fields (and sets 'received'), or -1 if all rows are valid.
+int parseTRCRows(const std::vector<TRCLine>& lines, int first, int last,
+        std::size_t expected, const std::vector<int>& markerIndices,
+        std::vector<double>& times, SimTK::Matrix_<SimTK::Vec3>& markerData,
+        const std::string& fileName, std::size_t firstLineNum,
+        std::size_t& received) {
+    std::vector<const char*> fieldBegins;
+    std::vector<const char*> fieldEnds;
+    fieldBegins.reserve(expected);
+    fieldEnds.reserve(expected);
+    for (int irow = first; irow < last; ++irow) {
+        const TRCLine& line = lines[irow];
+        fieldBegins.clear();
+        fieldEnds.clear();
+        const char* fieldBegin = line.begin;
+        for (const char* c = line.begin; c < line.end; ++c) {
+            if (*c == '\t' || *c == '\r') {
+                fieldBegins.push_back(fieldBegin);
+                fieldEnds.push_back(c);
+                fieldBegin = c + 1;
+            }
+        }
+        if (fieldBegin < line.end) {
+            fieldBegins.push_back(fieldBegin);
+            fieldEnds.push_back(line.end);
+        }
+        if (fieldBegins.size() != expected) {
+            received = fieldBegins.size();
+            return irow;
+        }
+
+        const std::size_t lineNum = firstLineNum + irow;
+        // Column 1 is time, and columns 2 till the end are data.
+        bool blank = false;
+        times[irow] = parseTRCField(fieldBegins[1], fieldEnds[1],
+                fileName, lineNum, blank);
+        OPENSIM_THROW_IF(blank, IOError,
+                "Error reading rows in file '" + fileName + "'. Missing time "
+                "in line " + std::to_string(lineNum) + ".");
+        for (int icol = 0; icol < (int)markerIndices.size(); ++icol) {
+            const std::size_t c = 3 * markerIndices[icol] + 2;
+            SimTK::Vec3 value;
+            blank = false;
+            for (int k = 0; k < 3; ++k) {
+                value[k] = parseTRCField(fieldBegins[c + k], fieldEnds[c + k],
+                        fileName, lineNum, blank);
+            }
+            // Only if each component is specified read process as a Vec3.
+            if (blank) value = SimTK::Vec3(SimTK::NaN);
+            markerData(irow, icol) = value;
+        }
+    }
+    return -1;
+}
+} // anonymous namespace
+
 const std::string TRCFileAdapter::_headerDelimiters{ " \t\r" };
 const std::string TRCFileAdapter::_markers{"markers"};
 const std::string TRCFileAdapter::_delimiterWrite{"\t"};
@@ -156,72 +255,93 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
         }
     }
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container.
+    // Select the markers to read. Columns keep the order of the file.
+    std::vector<int> markerIndices;
+    std::vector<std::string> labels;
+    for (int i = 0; i < (int)column_labels.size(); ++i) {
+        if (_markerNames.empty() ||
+                std::find(_markerNames.begin(), _markerNames.end(),
+                        column_labels[i]) != _markerNames.end()) {
+            markerIndices.push_back(i);
+            labels.push_back(column_labels[i]);
+        }
+    }
+    if (!_markerNames.empty()) {
+        metaData.removeValueForKey(_numMarkersLabel);
+        metaData.setValueForKey(_numMarkersLabel,
+                std::to_string(markerIndices.size()));
+    }
+
+    // Skip immediate blank lines between header and data.
     std::size_t line_num{_dataStartsAtLine};
-    std::vector<std::string> row = nextLine();
-    // skip immediate blank lines between header and data.
-    while(row.empty() || row.at(0).empty()) {
-        row = nextLine();
+    std::string firstRow;
+    while (std::getline(in_stream, firstRow)) {
+        if (!firstRow.empty() && firstRow.back() == '\r') firstRow.pop_back();
+        const auto row = tokenize(firstRow, _delimitersRead);
+        if (!row.empty() && !row.at(0).empty()) break;
+        firstRow.clear();
         ++line_num;
     }
-    
-    const size_t expected{ column_labels.size() * 3 + 2 };
-    // Will first store data in a SimTK::Matrix to avoid expensive calls 
-    // to the table's appendRow() which reallocates and copies the whole table.
-    int rowNumber = 0;
-    int last_size = 1024; 
-    SimTK::Matrix_<SimTK::Vec3> markerData{last_size, static_cast<int>(num_markers_expected)};
-    std::vector<double> times;
-    times.resize(last_size);
-
-    // An empty line during data parsing denotes end of data
-    while (!row.empty()) {
-        OPENSIM_THROW_IF(row.size() != expected,
+
+    // Read the rest of the file at once, and split it into lines rather than
+    // tokenizing the rows one at a time. An empty line denotes end of data.
+    std::string buffer{firstRow};
+    if (!firstRow.empty()) {
+        std::ostringstream remainder;
+        remainder << in_stream.rdbuf();
+        buffer += '\n';
+        buffer += remainder.str();
+    }
+    std::vector<TRCLine> lines;
+    const char* cursor = buffer.data();
+    const char* bufferEnd = buffer.data() + buffer.size();
+    while (cursor < bufferEnd) {
+        const char* lineEnd = static_cast<const char*>(
+                std::memchr(cursor, '\n', bufferEnd - cursor));
+        const char* next = lineEnd ? lineEnd + 1 : bufferEnd;
+        if (!lineEnd) lineEnd = bufferEnd;
+        if (lineEnd > cursor && *(lineEnd - 1) == '\r') --lineEnd;
+        if (lineEnd == cursor) break;
+        lines.push_back({cursor, lineEnd});
+        cursor = next;
+    }
+
+    // Parse the rows directly into the containers of the table, in parallel
+    // chunks for long files.
+    const int numRows = (int)lines.size();
+    const std::size_t expected{column_labels.size() * 3 + 2};
+    std::vector<double> times(numRows);
+    SimTK::Matrix_<SimTK::Vec3> markerData(
+            numRows, (int)markerIndices.size());
+    static const int minRowsPerChunk = 1000;
+    const int numChunks = std::max(1, std::min(
+            (int)std::thread::hardware_concurrency(),
+            numRows / minRowsPerChunk));
+    std::vector<std::size_t> received(numChunks, 0);
+    std::vector<std::future<int>> chunks;
+    for (int ichunk = 0; ichunk < numChunks; ++ichunk) {
+        const int first = ichunk * numRows / numChunks;
+        const int last = (ichunk + 1) * numRows / numChunks;
+        chunks.push_back(std::async(
+                numChunks == 1 ? std::launch::deferred : std::launch::async,
+                [&, first, last, ichunk] {
+                    return parseTRCRows(lines, first, last, expected,
+                            markerIndices, times, markerData, fileName,
+                            line_num, received[ichunk]);
+                }));
+    }
+    // Report the error in the earliest line.
+    for (int ichunk = 0; ichunk < numChunks; ++ichunk) {
+        const int invalidRow = chunks[ichunk].get();
+        OPENSIM_THROW_IF(invalidRow >= 0,
                          RowLengthMismatch,
                          fileName,
-                         line_num,
+                         line_num + invalidRow,
                          expected,
-                         row.size());
-
-        // Columns 2 till the end are data.
-        TimeSeriesTableVec3::RowVector 
-            row_vector{static_cast<int>(num_markers_expected), 
-                       SimTK::Vec3(SimTK::NaN)};
-        int ind{0};
-        for (std::size_t c = 2; c < column_labels.size() * 3 + 2; c += 3) {
-            //only if each component is specified read process as a Vec3
-            if ( !(row.at(c).empty() || row.at(c + 1).empty() 
-                                     || row.at(c + 2).empty()) ) {
-                row_vector[ind] = SimTK::Vec3{ std::stod(row.at(c)),
-                                               std::stod(row.at(c + 1)),
-                                               std::stod(row.at(c + 2)) };
-            } // otherwise the value will remain NaN (default)
-            ++ind;
-        }
-        markerData[rowNumber] = row_vector;
-        // Column 1 is time.
-        times[rowNumber] = std::stod(row.at(1));
-        rowNumber++;
-        if (rowNumber== last_size) {
-            // resize all Data/Matrices, double the size  while keeping data
-            int newSize = last_size * 2;
-            times.resize(newSize);
-            // Repeat for Data matrices in use
-            markerData.resizeKeep(newSize, (int)num_markers_expected);
-            last_size = newSize;
-        }
-        row = nextLine();
-        ++line_num;
+                         received[ichunk]);
     }
-    // Trim Matrices in use to actual data and move into tables
-    times.resize(rowNumber);
-    markerData.resizeKeep(rowNumber, (int)num_markers_expected);
 
     // Set the column labels of the table.
-    std::vector<std::string> labels{};
-    for(const auto& cl : column_labels)
-            labels.push_back(SimTK::Value<std::string>{cl});
     auto table = std::make_shared<TimeSeriesTableVec3>(
             times, markerData, labels);
     table->updTableMetaData() = metaData;
@@ -24,14 +24,41 @@
 #include "TableUtilities.h"
 
 #include "CommonUtilities.h"
-#include "FunctionSet.h"
-#include "GCVSplineSet.h"
+#include "GCVSpline.h"
 #include "PiecewiseLinearFunction.h"
 #include "Signal.h"
 #include "Storage.h"
 
+#include <algorithm>
+#include <future>
+#include <thread>
+
 using namespace OpenSim;
 
+namespace {
+// Call func(begin, end) for contiguous ranges of the columns [0, numColumns),
+// concurrently if the table is large enough for threads to pay off.
+template <typename F>
+void forColumnRanges(int numColumns, int numRows, F&& func) {
+    static const int minValuesPerThread = 50000;
+    const int numThreads = std::max(1,
+            std::min({(int)std::thread::hardware_concurrency(), numColumns,
+                    (int)((long long)numColumns * numRows /
+                            minValuesPerThread)}));
+    if (numThreads == 1) {
+        func(0, numColumns);
+        return;
+    }
+    std::vector<std::future<void>> futures;
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        futures.push_back(std::async(std::launch::async, func,
+                ithread * numColumns / numThreads,
+                (ithread + 1) * numColumns / numThreads));
+    }
+    for (auto& future : futures) future.get();
+}
+} // namespace
+
 void TableUtilities::checkNonUniqueLabels(std::vector<std::string> labels) {
     std::sort(labels.begin(), labels.end());
     auto it = std::adjacent_find(labels.begin(), labels.end());
@@ -147,14 +174,18 @@ void TableUtilities::filterLowpass(
         table = resampleWithInterval(table, dtMin);
     }
 
-    SimTK::Vector filtered(numRows);
-    for (int icol = 0; icol < (int)table.getNumColumns(); ++icol) {
-        SimTK::VectorView column = table.getDependentColumnAtIndex(icol);
-        Signal::LowpassIIR(dtMin, cutoffFreq, numRows,
-                column.getContiguousScalarData(),
-                filtered.updContiguousScalarData());
-        table.updDependentColumnAtIndex(icol) = filtered;
+    // Filter the columns in place, several at a time.
+    const int numFilterRows = (int)table.getNumRows();
+    const int numColumns = (int)table.getNumColumns();
+    std::vector<double*> columns(numColumns);
+    for (int icol = 0; icol < numColumns; ++icol) {
+        columns[icol] =
+                table.updDependentColumnAtIndex(icol).updContiguousScalarData();
     }
+    forColumnRanges(numColumns, numFilterRows, [&](int begin, int end) {
+        Signal::LowpassIIR(dtMin, cutoffFreq, numFilterRows, end - begin,
+                columns.data() + begin);
+    });
 }
 
 void TableUtilities::pad(
@@ -186,24 +217,23 @@ void TableUtilities::pad(
 
 namespace {
 template <typename FunctionType>
-std::unique_ptr<FunctionSet> createFunctionSet(const TimeSeriesTable& table) {
-    auto set = make_unique<FunctionSet>();
+std::unique_ptr<Function> createFunction(
+        const TimeSeriesTable& table, int icol) {
     const auto& time = table.getIndependentColumn();
-    const auto numRows = (int)table.getNumRows();
-    for (int icol = 0; icol < (int)table.getNumColumns(); ++icol) {
-        const double* y =
-                table.getDependentColumnAtIndex(icol).getContiguousScalarData();
-        set->adoptAndAppend(new FunctionType(numRows, time.data(), y));
-    }
-    return set;
+    const double* y =
+            table.getDependentColumnAtIndex(icol).getContiguousScalarData();
+    return make_unique<FunctionType>(
+            (int)table.getNumRows(), time.data(), y);
 }
 
 template <>
-inline std::unique_ptr<FunctionSet> createFunctionSet<GCVSpline>(
-        const TimeSeriesTable& table) {
+inline std::unique_ptr<Function> createFunction<GCVSpline>(
+        const TimeSeriesTable& table, int icol) {
     const auto& time = table.getIndependentColumn();
-    return OpenSim::make_unique<GCVSplineSet>(table, std::vector<std::string>{},
-            std::min((int)time.size() - 1, 5));
+    const double* y =
+            table.getDependentColumnAtIndex(icol).getContiguousScalarData();
+    return make_unique<GCVSpline>(std::min((int)time.size() - 1, 5),
+            (int)time.size(), time.data(), y);
 }
 } // namespace
 
@@ -240,24 +270,33 @@ TimeSeriesTable TableUtilities::resample(
                 itime, itime - 1, newTime[itime], newTime[itime - 1]);
     }
 
-    // Copy over metadata.
-    TimeSeriesTable out = in;
-    for (int irow = (int)out.getNumRows() - 1; irow >= 0; --irow) {
-        out.removeRowAtIndex(irow);
+    const int numTimes = (int)newTime.size();
+    SimTK::Vector times(numTimes);
+    for (int itime = 0; itime < numTimes; ++itime) {
+        times[itime] = newTime[itime];
     }
+    // Fit and evaluate the interpolant of each column independently, so that
+    // groups of columns can be processed concurrently. Each function is
+    // evaluated at all times at once; the new times are sorted, so splines
+    // need not search for the knot interval of each time.
+    const int numColumns = (int)in.getNumColumns();
+    SimTK::Matrix values(numTimes, numColumns);
+    forColumnRanges(numColumns, (int)time.size() + numTimes,
+            [&](int begin, int end) {
+                SimTK::Matrix functionValues;
+                for (int icol = begin; icol < end; ++icol) {
+                    createFunction<FunctionType>(in, icol)->calcValues(
+                            times, 0, functionValues);
+                    values.updCol(icol) = functionValues.col(0);
+                }
+            });
 
-    std::unique_ptr<FunctionSet> functions =
-            createFunctionSet<FunctionType>(in);
-    SimTK::Vector curTime(1);
-    SimTK::RowVector row(functions->getSize());
-    for (int itime = 0; itime < (int)newTime.size(); ++itime) {
-        curTime[0] = newTime[itime];
-        for (int icol = 0; icol < functions->getSize(); ++icol) {
-            row(icol) = functions->get(icol).calcValue(curTime);
-        }
-        // Not efficient!
-        out.appendRow(curTime[0], row);
-    }
+    // Copy over metadata.
+    TimeSeriesTable out = in;
+    out._indData.assign(
+            times.getContiguousScalarData(),
+            times.getContiguousScalarData() + numTimes);
+    out.updMatrix() = values;
     return out;
 }
 
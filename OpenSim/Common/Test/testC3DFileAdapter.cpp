@@ -26,6 +26,7 @@
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <fstream>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -220,9 +221,45 @@ void test(const std::string filename) {
 
 }
 
+void testMarkersOnlyAndConvertFiles() {
+    using namespace OpenSim;
+
+    C3DFileAdapter c3dFileAdapter{};
+    auto tables = c3dFileAdapter.read("walking2.c3d");
+    auto markers = c3dFileAdapter.getMarkersTable(tables);
+
+    // Reading only the markers gives the same markers and empty force and
+    // analog tables.
+    C3DFileAdapter markersAdapter{};
+    markersAdapter.setReadForces(false);
+    markersAdapter.setReadAnalogData(false);
+    auto markerTables = markersAdapter.read("walking2.c3d");
+    compare_tables<SimTK::Vec3>(*markers,
+            *markersAdapter.getMarkersTable(markerTables));
+    ASSERT(markersAdapter.getForcesTable(markerTables)->getNumColumns() == 0);
+    ASSERT(markersAdapter.getAnalogDataTable(markerTables)->getNumColumns()
+            == 0);
+
+    // Convert two files and a missing file concurrently.
+    C3DFileAdapter convertAdapter{};
+    convertAdapter.setReadAnalogData(false);
+    const int numFailed = convertAdapter.convertFiles(
+            {"walking2.c3d", "walking5.c3d", "missing.c3d"}, "", 2);
+    ASSERT(numFailed == 1);
+    TimeSeriesTableVec3 convertedMarkers("walking2.trc");
+    ASSERT(convertedMarkers.getNumRows() == markers->getNumRows());
+    ASSERT(convertedMarkers.getColumnLabels() == markers->getColumnLabels());
+    // Force, point, and moment of each force plate.
+    TimeSeriesTable convertedForces("walking5_forces.mot");
+    ASSERT(convertedForces.getNumColumns() > 0 &&
+            convertedForces.getNumColumns() % 9 == 0);
+    ASSERT(!std::ifstream("walking2_analog.sto").good());
+}
+
 int main() {
     SimTK_START_TEST("testC3DFileAdapter");
         SimTK_SUBTEST1(test, "walking2.c3d");
         SimTK_SUBTEST1(test, "walking5.c3d");
+        SimTK_SUBTEST(testMarkersOnlyAndConvertFiles);
     SimTK_END_TEST();
 }
@@ -3411,6 +3411,97 @@ TEST_CASE("Component Interface: Incorrectly Reading an Optional Object Property
     }
 }
 
+TEST_CASE("Component Interface Cached Output Values")
+{
+    class A : public Component {
+        OpenSim_DECLARE_CONCRETE_OBJECT(A, Component);
+    public:
+        OpenSim_DECLARE_OUTPUT(out1, double, calcOut1, SimTK::Stage::Time);
+        OpenSim_DECLARE_LIST_OUTPUT(outL, double, calcOutL, SimTK::Stage::Time);
+        OpenSim_DECLARE_LIST_OUTPUT_WITH_VALUES(outV, double, calcOutL,
+                calcOutV, SimTK::Stage::Time);
+        double calcOut1(const SimTK::State& state) const {
+            ++numEvaluations;
+            return 2 * state.getTime();
+        }
+        double calcOutL(const SimTK::State& state,
+                        const std::string& channel) const {
+            ++numEvaluations;
+            return std::stod(channel) * state.getTime();
+        }
+        void calcOutV(const SimTK::State& state,
+                      std::vector<double>& values) const {
+            ++numValuesEvaluations;
+            values = {0.0, state.getTime(), 2 * state.getTime()};
+        }
+        mutable int numEvaluations = 0;
+        mutable int numValuesEvaluations = 0;
+    private:
+        void extendFinalizeFromProperties() override {
+            auto& outL = updOutput("outL");
+            outL.clearChannels();
+            outL.addChannel("0"); outL.addChannel("1"); outL.addChannel("2");
+            auto& outV = updOutput("outV");
+            outV.clearChannels();
+            outV.addChannel("0"); outV.addChannel("1"); outV.addChannel("2");
+        }
+    };
+
+    for (bool caching : {false, true}) {
+        TheWorld world;
+        A* a = new A(); a->setName("a");
+        world.add(a);
+        a->updOutput("out1").setCachingEnabled(caching);
+        a->updOutput("outL").setCachingEnabled(caching);
+        a->updOutput("outV").setCachingEnabled(caching);
+        MultibodySystem system;
+        world.connect();
+        world.buildUpSystem(system);
+        State s = system.realizeTopology();
+        s.setTime(1.5);
+        system.realize(s, Stage::Time);
+
+        const auto& out1 = Output<double>::downcast(a->getOutput("out1"));
+        CHECK(out1.getValue(s) == 3.0);
+        CHECK(out1.getValue(s) == 3.0);
+        CHECK(a->numEvaluations == (caching ? 1 : 2));
+
+        // Changing the time invalidates the cached value.
+        s.setTime(2.0);
+        CHECK_THROWS_AS(out1.getValue(s), SimTK::Exception::StageTooLow);
+        system.realize(s, Stage::Time);
+        a->numEvaluations = 0;
+        CHECK(out1.getValue(s) == 4.0);
+        CHECK(out1.getValue(s) == 4.0);
+        CHECK(a->numEvaluations == (caching ? 1 : 2));
+
+        // All channels of a list output at once.
+        const auto& outL = Output<double>::downcast(a->getOutput("outL"));
+        std::vector<double> values;
+        a->numEvaluations = 0;
+        outL.getValues(s, values);
+        CHECK(values == std::vector<double>{0.0, 2.0, 4.0});
+        CHECK(outL.getChannels().at("2").getValue(s) == 4.0);
+        CHECK(a->numEvaluations == (caching ? 3 : 4));
+
+        out1.getValues(s, values);
+        CHECK(values == std::vector<double>{4.0});
+
+        // A list output with a values function evaluates all channels in one
+        // call, and fills the channels' caches.
+        const auto& outV = Output<double>::downcast(a->getOutput("outV"));
+        a->numEvaluations = 0;
+        outV.getValues(s, values);
+        CHECK(values == std::vector<double>{0.0, 2.0, 4.0});
+        CHECK(a->numValuesEvaluations == 1);
+        CHECK(a->numEvaluations == 0);
+        CHECK(outV.getChannels().at("2").getValue(s) == 4.0);
+        CHECK(a->numEvaluations == (caching ? 0 : 1));
+        outV.getValues(s, values);
+        CHECK(a->numValuesEvaluations == (caching ? 1 : 2));
+    }
+}
+
 const bool g_TestFixtureTypesAreRegistered = []()
 {
     // ensure new types are globally registered for testing deserialization
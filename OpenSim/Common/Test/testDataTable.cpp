@@ -26,7 +26,9 @@
 #include <catch2/catch_all.hpp>
 
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Common/Signal.h>
 #include <OpenSim/Common/TableUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
@@ -919,6 +921,56 @@ TEST_CASE("TableUtilities::resample") {
     }
 }
 
+TEST_CASE("TableUtilities filter and resample many columns") {
+    // Large enough to be processed in groups of columns on multiple threads.
+    const int numRows = 2000;
+    const int numColumns = 45;
+    // Use a sampling interval that is exact in floating point, so that the
+    // table is uniformly sampled and filterLowpass() does not resample.
+    std::vector<double> time(numRows);
+    for (int i = 0; i < numRows; ++i) time[i] = i / 1024.0;
+    TimeSeriesTable table(time);
+    for (int icol = 0; icol < numColumns; ++icol) {
+        table.appendColumn(std::to_string(icol),
+                SimTK::Test::randVector(numRows));
+    }
+
+    SECTION("filterLowpass matches Signal::LowpassIIR") {
+        TimeSeriesTable filteredTable = table;
+        TableUtilities::filterLowpass(filteredTable, 6.0);
+        const double dt = time[1] - time[0];
+        SimTK::Vector expected(numRows);
+        for (int icol = 0; icol < numColumns; ++icol) {
+            Signal::LowpassIIR(dt, 6.0, numRows,
+                    table.getDependentColumnAtIndex(icol)
+                            .getContiguousScalarData(),
+                    expected.updContiguousScalarData());
+            const auto& actual = filteredTable.getDependentColumnAtIndex(icol);
+            for (int i = 0; i < numRows; ++i) {
+                CHECK(actual[i] == Approx(expected[i]).margin(1e-12));
+            }
+        }
+    }
+
+    SECTION("resample matches per-column splines") {
+        const SimTK::Vector newTime = createVectorLinspace(777, 0.1, 1.9);
+        TimeSeriesTable resampled = TableUtilities::resample(table, newTime);
+        REQUIRE(resampled.getNumRows() == 777);
+        REQUIRE(resampled.getNumColumns() == numColumns);
+        SimTK::Vector x(1);
+        for (int icol = 0; icol < numColumns; icol += 11) {
+            GCVSpline spline(5, numRows, time.data(),
+                    table.getDependentColumnAtIndex(icol)
+                            .getContiguousScalarData());
+            const auto& actual = resampled.getDependentColumnAtIndex(icol);
+            for (int i = 0; i < newTime.size(); ++i) {
+                x[0] = newTime[i];
+                CHECK(actual[i] == Approx(spline.calcValue(x)));
+            }
+        }
+    }
+}
+
 TEST_CASE("TimeSeriesTable trim methods") {
     // make time table
     TimeSeriesTable_<double> table{};
@@ -85,3 +85,50 @@ TEST_CASE("GCVSpline Behaves as Expected")
             "Duplicate GCVSpline failed to reproduce identical first derivative.");
     }
 }
+
+TEST_CASE("GCVSpline and GCVSplineSet batch evaluation") {
+    const int size = 51;
+    const double dt = 1.0 / (size - 1);
+    TimeSeriesTable table;
+    table.setColumnLabels({"sin", "cos"});
+    SimTK::RowVector row(2);
+    for (int i = 0; i < size; ++i) {
+        const double time = dt * i;
+        row[0] = sin(2 * SimTK::Pi * time);
+        row[1] = cos(3 * time);
+        table.appendRow(time, row);
+    }
+    GCVSplineSet splines(table);
+
+    // Include unsorted values, repeated values, and the endpoints.
+    SimTK::Vector times(8);
+    times[0] = 0.0;
+    times[1] = 0.013;
+    times[2] = 0.5;
+    times[3] = 0.5;
+    times[4] = 0.77;
+    times[5] = 0.2;
+    times[6] = 0.999;
+    times[7] = 1.0;
+
+    std::vector<SimTK::Matrix> values;
+    splines.calcValues(times, 2, values);
+    REQUIRE(values.size() == 3);
+    SimTK::Vector arg(1);
+    for (int ispline = 0; ispline < splines.getSize(); ++ispline) {
+        const auto& spline = splines.get(ispline);
+        SimTK::Matrix splineValues;
+        spline.calcValues(times, 2, splineValues);
+        REQUIRE(splineValues.ncol() == 3);
+        for (int i = 0; i < times.size(); ++i) {
+            arg[0] = times[i];
+            const double value = spline.calcValue(arg);
+            const double deriv = spline.calcDerivative({0}, arg);
+            const double deriv2 = spline.calcDerivative({0, 0}, arg);
+            CHECK(values[0](i, ispline) == Catch::Approx(value).margin(1e-10));
+            CHECK(values[1](i, ispline) == Catch::Approx(deriv).margin(1e-8));
+            CHECK(values[2](i, ispline) == Catch::Approx(deriv2).margin(1e-6));
+            CHECK(splineValues(i, 0) == values[0](i, ispline));
+        }
+    }
+}
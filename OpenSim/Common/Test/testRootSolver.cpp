@@ -20,6 +20,7 @@
  * See the License for the specific language governing permissions and        *
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Exception.h>
 #include <OpenSim/Common/Signal.h>
 #include <OpenSim/Common/Storage.h>
@@ -72,3 +73,42 @@ TEST_CASE("APDM Data Reader")
         //ASSERT_EQUAL(i*0.01, roots[i], 1e-6);
     }
 }
+
+TEST_CASE("solveNewtonBisectionBatch") {
+    // Solve x^3 - c = 0 for several values of c; the last problem is not
+    // bracketed by the bounds [-2, 2].
+    const std::vector<double> c = {-7.0, -1.0, 0.0, 0.5, 3.0, 27.0};
+    const int n = (int)c.size();
+    const auto calcResiduals = [&](int begin, int end,
+                                       const std::vector<double>& x,
+                                       std::vector<double>& residual,
+                                       std::vector<double>& derivative) {
+        for (int i = begin; i < end; ++i) {
+            residual[i] = x[i] * x[i] * x[i] - c[i];
+            derivative[i] = 3.0 * x[i] * x[i];
+        }
+    };
+    const int numThreads = GENERATE(1, 2, 4);
+    // The derivative is zero at the initial guess, which forces a bisection
+    // step.
+    std::vector<double> x(n, 0.0);
+    const auto stats = solveNewtonBisectionBatch(calcResiduals, x,
+            std::vector<double>(n, -2.0), std::vector<double>(n, 2.0), 1e-12,
+            100, numThreads);
+    CHECK(stats.numProblems == n);
+    CHECK(stats.numConverged == n - 1);
+    CHECK(stats.numNotBracketed == 1);
+    CHECK_FALSE(stats.bracketed.back());
+    CHECK(stats.maxIterations < 100);
+    CHECK(stats.numNewtonSteps > 0);
+    CHECK(stats.numBisectionSteps > 0);
+    for (int i = 0; i < n - 1; ++i) {
+        CHECK(stats.converged[i]);
+        CHECK(std::abs(x[i] * x[i] * x[i] - c[i]) < 1e-12);
+    }
+    // The unbracketed problem keeps its initial guess.
+    CHECK(x.back() == 0.0);
+
+    CHECK_THROWS(solveNewtonBisectionBatch(calcResiduals, x,
+            std::vector<double>(n - 1, -2.0), std::vector<double>(n, 2.0)));
+}
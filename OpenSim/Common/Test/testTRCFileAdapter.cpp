@@ -210,3 +210,89 @@ TEST_CASE("TRCFileAdapter (all)")
     std::remove(tmpfile.c_str());
     std::cout << "\nAll tests passed!" << std::endl;
 }
+
+TEST_CASE("TRCFileAdapter reads selected markers")
+{
+    using namespace OpenSim;
+
+    const std::string filename{"subject01_synthetic_marker_data.trc"};
+    TimeSeriesTableVec3 full(filename);
+    const auto& allLabels = full.getColumnLabels();
+    REQUIRE(allLabels.size() > 3);
+
+    // The columns are in the order of the file; unknown names are ignored.
+    TRCFileAdapter adapter{};
+    adapter.setMarkerNames({allLabels[3], "not_a_marker", allLabels[0]});
+    auto selected = std::static_pointer_cast<TimeSeriesTableVec3>(
+            adapter.read(filename).at(TRCFileAdapter::_markers));
+    REQUIRE(selected->getColumnLabels() ==
+            std::vector<std::string>{allLabels[0], allLabels[3]});
+    CHECK(selected->getTableMetaData<std::string>("NumMarkers") == "2");
+    REQUIRE(selected->getNumRows() == full.getNumRows());
+    CHECK(selected->getIndependentColumn() == full.getIndependentColumn());
+    for (const auto& label : selected->getColumnLabels()) {
+        const auto& expected = full.getDependentColumn(label);
+        const auto& actual = selected->getDependentColumn(label);
+        for (int i = 0; i < expected.size(); ++i) {
+            CHECK((expected[i] == actual[i] ||
+                    (expected[i].isNaN() && actual[i].isNaN())));
+        }
+    }
+}
+
+TEST_CASE("TRCFileAdapter reads long files in parallel chunks")
+{
+    using namespace OpenSim;
+
+    // Enough rows that the data are parsed in multiple chunks.
+    const int numRows = 5000;
+    const int numMarkers = 4;
+    std::vector<double> times(numRows);
+    SimTK::Matrix_<SimTK::Vec3> data(numRows, numMarkers);
+    for (int i = 0; i < numRows; ++i) {
+        times[i] = i / 100.0;
+        for (int j = 0; j < numMarkers; ++j)
+            data(i, j) = SimTK::Vec3(i, 0.5 * j, -1.0 * i * j);
+    }
+    data(1234, 2) = SimTK::Vec3(SimTK::NaN);
+    TimeSeriesTableVec3 table(times, data, {"m0", "m1", "m2", "m3"});
+    table.addTableMetaData("DataRate", std::string("100"));
+    table.addTableMetaData("Units", std::string("m"));
+    const std::string tmpfile{"testtrcfileadapter_long.trc"};
+    TRCFileAdapter::write(table, tmpfile);
+
+    TimeSeriesTableVec3 roundTrip(tmpfile);
+    REQUIRE(roundTrip.getNumRows() == numRows);
+    CHECK(roundTrip.getIndependentColumn() == times);
+    const auto& roundTripData = roundTrip.getMatrix();
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numMarkers; ++j) {
+            if (i == 1234 && j == 2) {
+                CHECK(roundTripData(i, j).isNaN());
+            } else {
+                CHECK(roundTripData(i, j) == data(i, j));
+            }
+        }
+    }
+
+    // A row with a missing column is reported with its line number.
+    {
+        std::ifstream in(tmpfile);
+        std::ofstream out("bad_" + tmpfile);
+        std::string line;
+        int lineNum = 0;
+        while (std::getline(in, line)) {
+            ++lineNum;
+            // Rows end with a delimiter; drop the last value.
+            if (lineNum == 4000) {
+                line = line.substr(0, line.rfind('\t', line.size() - 2) + 1);
+            }
+            out << line << "\n";
+        }
+    }
+    CHECK_THROWS_WITH(TimeSeriesTableVec3("bad_" + tmpfile),
+            Catch::Matchers::ContainsSubstring("line 4000"));
+
+    std::remove(("bad_" + tmpfile).c_str());
+    std::remove(tmpfile.c_str());
+}
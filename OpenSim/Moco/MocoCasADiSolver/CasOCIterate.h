@@ -74,6 +74,10 @@ struct Solution : public Iterate {
     casadi::Dict stats;
     double objective;
     ObjectiveBreakdown objective_breakdown;
+    /// A row vector (one entry per mesh interval) of the estimated relative
+    /// discretization error in each mesh interval. This is only populated if
+    /// Solver::setEstimateMeshIntervalErrors() is enabled.
+    casadi::DM mesh_interval_errors;
 };
 
 } // namespace CasOC
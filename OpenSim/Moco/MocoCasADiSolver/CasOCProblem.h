@@ -332,6 +332,13 @@ public:
     virtual std::vector<std::string>
     createKinematicConstraintEquationNamesImpl() const;
 
+    /// This is invoked by the transcription if the initial and final times are
+    /// fixed, with the times of the grid points at which the
+    /// integrands are evaluated. Problems can use this to precompute
+    /// quantities that depend only on time.
+    virtual void initializeOnGridTimes(
+            const std::vector<double>& /*times*/) const {}
+
     void intermediateCallback() const { intermediateCallbackImpl(); }
     void intermediateCallbackWithIterate(const CasOC::Iterate& it) const {
         intermediateCallbackWithIterateImpl(it);
@@ -126,6 +126,16 @@ public:
         return m_enforcePathConstraintMidpoints;
     }
 
+    /// Whether or not to estimate the discretization error in each mesh
+    /// interval after solving (see Solution::mesh_interval_errors). This
+    /// requires an additional evaluation of the dynamics at every grid point.
+    void setEstimateMeshIntervalErrors(bool tf) {
+        m_estimateMeshIntervalErrors = tf;
+    }
+    bool getEstimateMeshIntervalErrors() const {
+        return m_estimateMeshIntervalErrors;
+    }
+
     void setOptimSolver(std::string optimSolver) {
         m_optimSolver = std::move(optimSolver);
     }
@@ -203,6 +213,7 @@ private:
     double m_implicitAuxiliaryDerivativesWeight = 1.0;
     bool m_interpolateControlMidpoints = true;
     bool m_enforcePathConstraintMidpoints = false;
+    bool m_estimateMeshIntervalErrors = false;
     Bounds m_implicitMultibodyAccelerationBounds;
     Bounds m_implicitAuxiliaryDerivativeBounds;
     std::string m_finite_difference_scheme = "central";
@@ -277,6 +277,17 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
     m_duration = m_unscaledVars[final_time] - m_unscaledVars[initial_time];
     m_times = createTimes(
             m_unscaledVars[initial_time], m_unscaledVars[final_time]);
+
+    // With fixed initial and final times, the grid times are known before
+    // solving.
+    const auto& initialTimeBounds = m_problem.getTimeInitialBounds();
+    const auto& finalTimeBounds = m_problem.getTimeFinalBounds();
+    if (initialTimeBounds.lower == initialTimeBounds.upper &&
+            finalTimeBounds.lower == finalTimeBounds.upper) {
+        const DM gridTimes = createTimes(
+                DM(initialTimeBounds.lower), DM(finalTimeBounds.lower));
+        m_problem.initializeOnGridTimes(gridTimes.nonzeros());
+    }
     m_paramsTrajGrid =
             MX::repmat(m_unscaledVars[parameters], 1, m_numGridPoints);
     m_paramsTrajMesh =
@@ -754,6 +765,11 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     // Print breakdown of objective.
     printObjectiveBreakdown(solution, objectiveOut[0]);
 
+    if (m_solver.getEstimateMeshIntervalErrors()) {
+        solution.mesh_interval_errors =
+                calcMeshIntervalErrors(finalVariables, solution);
+    }
+
     if (!solution.stats.at("success")) {
 
         // For some reason, nlpResult.at("g") is all 0. So we calculate the
@@ -766,6 +782,64 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     return solution;
 }
 
+casadi::DM Transcription::calcMeshIntervalErrors(
+        const casadi::DM& x, const Iterate& it) const {
+    casadi::DM errors = casadi::DM::zeros(1, m_numMeshIntervals);
+    const auto& states = it.variables.at(Var::states);
+    const int numStates = (int)states.rows();
+    if (numStates == 0) return errors;
+
+    // Evaluate the state derivatives at the provided variables.
+    casadi::Function xdotFunc("xdot",
+            {flattenVariables(m_scaledVars)}, {m_xdot});
+    casadi::DMVector xdotOut;
+    xdotFunc.call(casadi::DMVector{x}, xdotOut);
+    const casadi::DM& xdot = xdotOut[0];
+
+    // Normalize the error in each state by the magnitude of that state.
+    std::vector<double> weights(numStates, 1.0);
+    for (int is = 0; is < numStates; ++is) {
+        for (int itime = 0; itime < m_numGridPoints; ++itime) {
+            weights[is] = std::max(weights[is],
+                    1.0 + std::abs(states(is, itime).scalar()));
+        }
+    }
+
+    std::vector<int> meshGridIndices;
+    const casadi::DM meshIndices = createMeshIndices();
+    for (int itime = 0; itime < m_numGridPoints; ++itime) {
+        if (meshIndices(itime).__nonzero__()) {
+            meshGridIndices.push_back(itime);
+        }
+    }
+    OPENSIM_THROW_IF((int)meshGridIndices.size() != m_numMeshPoints,
+            OpenSim::Exception,
+            "Internal error: expected {} mesh points but found {}.",
+            m_numMeshPoints, meshGridIndices.size());
+
+    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
+        const int istart = meshGridIndices[imesh];
+        const int iend = meshGridIndices[imesh + 1];
+        const double h = it.times(iend).scalar() - it.times(istart).scalar();
+        double maxError = 0;
+        for (int is = 0; is < numStates; ++is) {
+            const double fstart = xdot(is, istart).scalar();
+            const double fend = xdot(is, iend).scalar();
+            double error;
+            if (iend - istart > 1) {
+                const double increment = states(is, iend).scalar() -
+                                         states(is, istart).scalar();
+                error = std::abs(increment - 0.5 * h * (fstart + fend));
+            } else {
+                error = 0.5 * h * std::abs(fend - fstart);
+            }
+            maxError = std::max(maxError, error / weights[is]);
+        }
+        errors(imesh) = maxError;
+    }
+    return errors;
+}
+
 void Transcription::printConstraintValues(const Iterate& it,
         const Constraints<casadi::DM>& constraints,
         std::ostream& stream) const {
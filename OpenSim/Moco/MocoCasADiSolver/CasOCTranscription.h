@@ -137,6 +137,17 @@ protected:
     void printObjectiveBreakdown(const Iterate& it,
             const casadi::DM& objectiveTerms,
             std::ostream& stream = std::cout) const;
+    /// Estimate the relative discretization error in each mesh interval for
+    /// the (scaled, flattened) variables x. The estimate compares the change
+    /// in each state across a mesh interval with the change predicted by a
+    /// lower-order quadrature of the state derivatives (the trapezoidal rule
+    /// over the interval endpoints). For trapezoidal transcription, which has
+    /// no interior grid points, the difference between the trapezoidal and
+    /// Euler rules is used instead. Errors are normalized by
+    /// 1 + max(|state|) and the maximum over all states is returned for each
+    /// mesh interval.
+    casadi::DM calcMeshIntervalErrors(
+            const casadi::DM& x, const Iterate& it) const;
 
     const Solver& m_solver;
     const Problem& m_problem;
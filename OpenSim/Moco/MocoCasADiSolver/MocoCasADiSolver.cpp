@@ -55,6 +55,10 @@ void MocoCasADiSolver::constructProperties() {
     constructProperty_implicit_auxiliary_derivatives_weight(1.0);
 
     constructProperty_enforce_path_constraint_midpoints(false);
+
+    constructProperty_mesh_refinement_max_iterations(0);
+    constructProperty_mesh_refinement_tolerance(1e-3);
+    constructProperty_mesh_refinement_max_mesh_intervals(1000);
 }
 
 bool MocoCasADiSolver::isAvailable() {
@@ -343,6 +347,14 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     if (casProblem.getJarSize() > 1) {
         casSolver->setParallelism("thread", casProblem.getJarSize());
     }
+    checkPropertyValueIsInRangeOrSet(
+            getProperty_mesh_refinement_max_iterations(), 0,
+            std::numeric_limits<int>::max(), {});
+    checkPropertyValueIsPositive(getProperty_mesh_refinement_tolerance());
+    checkPropertyValueIsPositive(
+            getProperty_mesh_refinement_max_mesh_intervals());
+    casSolver->setEstimateMeshIntervalErrors(
+            get_mesh_refinement_max_iterations() > 0);
     casSolver->setPluginOptions(pluginOptions);
     casSolver->setSolverOptions(solverOptions);
     return casSolver;
@@ -351,6 +363,25 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
 #endif
 }
 
+std::vector<double> MocoCasADiSolver::refineMesh(
+        const std::vector<double>& mesh,
+        const std::vector<double>& errors) const {
+    OPENSIM_ASSERT_FRMOBJ(errors.size() + 1 == mesh.size());
+    std::vector<double> refined;
+    refined.reserve(2 * mesh.size());
+    bool wasRefined = false;
+    for (int imesh = 0; imesh < (int)errors.size(); ++imesh) {
+        refined.push_back(mesh[imesh]);
+        if (errors[imesh] > get_mesh_refinement_tolerance()) {
+            refined.push_back(0.5 * (mesh[imesh] + mesh[imesh + 1]));
+            wasRefined = true;
+        }
+    }
+    refined.push_back(mesh.back());
+    if (!wasRefined) return {};
+    return refined;
+}
+
 MocoSolution MocoCasADiSolver::solveImpl() const {
 #ifdef OPENSIM_WITH_CASADI
     const Stopwatch stopwatch;
@@ -382,24 +413,74 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     // log isn't flooded while computing finite differences.
     Logger::Level origLoggerLevel = Logger::getLevel();
     Logger::setLevel(Logger::Level::Warn);
-    CasOC::Solution casSolution;
-    try {
-        casSolution = casSolver->solve(casGuess);
-    } catch(const Exception& ex) {
-        OPENSIM_THROW_FRMOBJ(Exception,
-            fmt::format("MocoCasADiSolver failed internally with message: {}",
-                ex.getMessage()));
-    } catch(const casadi::CasadiException& ex) {
-        OPENSIM_THROW_FRMOBJ(Exception,
-            fmt::format("MocoCasADiSolver failed internally with message: {}",
-                ex.what()));
-    } catch (...) {
-        OPENSIM_THROW_FRMOBJ(Exception, "MocoCasADiSolver failed internally.");
-    }
-    OpenSim::Logger::setLevel(origLoggerLevel);
-
+    auto solveCasOC = [&](const CasOC::Solver& solver,
+                              const CasOC::Iterate& initialGuess) {
+        try {
+            return solver.solve(initialGuess);
+        } catch(const Exception& ex) {
+            OPENSIM_THROW_FRMOBJ(Exception,
+                fmt::format("MocoCasADiSolver failed internally with message: {}",
+                    ex.getMessage()));
+        } catch(const casadi::CasadiException& ex) {
+            OPENSIM_THROW_FRMOBJ(Exception,
+                fmt::format("MocoCasADiSolver failed internally with message: {}",
+                    ex.what()));
+        } catch (...) {
+            OPENSIM_THROW_FRMOBJ(Exception, "MocoCasADiSolver failed internally.");
+        }
+    };
+    CasOC::Solution casSolution = solveCasOC(*casSolver, casGuess);
     MocoSolution mocoSolution = convertToMocoTrajectory<MocoSolution>(
             casSolution, inputControlIndexes);
+    int numIterations = casSolution.stats.at("iter_count");
+    bool success = casSolution.stats.at("success");
+
+    // Mesh refinement.
+    // ----------------
+    // Split the mesh intervals with large errors and re-solve the problem,
+    // warm-started from the previous solution.
+    for (int iref = 0; iref < get_mesh_refinement_max_iterations(); ++iref) {
+        if (!success) break;
+        const std::vector<double> mesh = casSolver->getMesh();
+        const std::vector<double> errors =
+                casSolution.mesh_interval_errors.get_elements();
+        const double maxError =
+                *std::max_element(errors.begin(), errors.end());
+        const std::vector<double> refinedMesh = refineMesh(mesh, errors);
+        if (get_verbosity()) {
+            // The log level is lowered to Warn while solving (see above).
+            Logger::setLevel(origLoggerLevel);
+            log_info("Mesh refinement iteration {}: {} mesh intervals, "
+                     "max estimated error {:.3e} (tolerance {:.3e}).",
+                    iref, mesh.size() - 1, maxError,
+                    get_mesh_refinement_tolerance());
+            Logger::setLevel(Logger::Level::Warn);
+        }
+        if (refinedMesh.empty()) break;
+        if ((int)refinedMesh.size() - 1 >
+                get_mesh_refinement_max_mesh_intervals()) {
+            log_warn("MocoCasADiSolver: stopping mesh refinement since the "
+                     "refined mesh would have {} mesh intervals, more than "
+                     "mesh_refinement_max_mesh_intervals ({}).",
+                    refinedMesh.size() - 1,
+                    get_mesh_refinement_max_mesh_intervals());
+            break;
+        }
+
+        // Create a new CasOC problem and solver so that the functions are
+        // constructed from scratch for the new mesh.
+        casProblem = createCasOCProblem();
+        casSolver = createCasOCSolver(*casProblem);
+        casSolver->setMesh(refinedMesh);
+        casSolution = solveCasOC(*casSolver,
+                convertToCasOCIterate(mocoSolution, inputControlIndexes));
+        mocoSolution = convertToMocoTrajectory<MocoSolution>(
+                casSolution, inputControlIndexes);
+        const int refinedIterations = casSolution.stats.at("iter_count");
+        numIterations += refinedIterations;
+        success = casSolution.stats.at("success");
+    }
+    OpenSim::Logger::setLevel(origLoggerLevel);
 
     // If enforcing model constraints and not minimizing Lagrange multipliers,
     // check the rank of the constraint Jacobian and if rank-deficient, print
@@ -411,9 +492,9 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     }
 
     const long long elapsed = stopwatch.getElapsedTimeInNs();
-    setSolutionStats(mocoSolution, casSolution.stats.at("success"),
+    setSolutionStats(mocoSolution, success,
             casSolution.objective, casSolution.stats.at("return_status"),
-            casSolution.stats.at("iter_count"), SimTK::nsToSec(elapsed),
+            numIterations, SimTK::nsToSec(elapsed),
             casSolution.objective_breakdown);
 
     if (get_verbosity()) {
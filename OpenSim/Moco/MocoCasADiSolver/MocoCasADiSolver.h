@@ -112,6 +112,31 @@ parameters_require_initsystem property to false. Be careful, though: you
 will end up with incorrect results if your parameter does indeed require
 Model::initSystem(). To protect against this, ensure that you obtain the
 same results whether this setting is true or false.
+Parameters for the mass properties of a Body, the location of a PathPoint,
+and most properties of a DeGrooteFregly2016Muscle do not need
+Model::initSystem(): if all parameters are of these types, the models are
+updated in place even if parameters_require_initsystem is true.
+
+Mesh refinement
+===============
+Rather than resolving the entire trajectory with a uniformly fine mesh, you
+can let the solver refine the mesh automatically by setting
+`mesh_refinement_max_iterations` to a value greater than 0. The problem is
+first solved on the mesh given by `num_mesh_intervals` (or `mesh`). After each
+solve, the relative discretization error in each mesh interval is estimated
+from the solution, and every mesh interval whose error exceeds
+`mesh_refinement_tolerance` is split in half. The problem is then solved again
+on the refined mesh, using the previous solution as the initial guess. This
+repeats until all mesh intervals satisfy the tolerance, the maximum number of
+refinement iterations is reached, the number of mesh intervals would exceed
+`mesh_refinement_max_mesh_intervals`, or a solve fails. The refined mesh is
+concentrated in the portions of the trajectory that change most rapidly, so
+smooth phases of the motion remain coarse.
+
+The error estimate compares the change in each state across a mesh interval
+with a lower-order quadrature of the state derivatives, normalized by the
+magnitude of the state. For 'trapezoidal' transcription, this estimate is
+first order and therefore conservative.
 
 @note The software license of CasADi (LGPL) is more restrictive than that of
 the rest of Moco (Apache 2.0).
@@ -177,6 +202,18 @@ public:
             "enable this property to enforce MocoPathConstraints at mesh "
             "interval midpoints. Default: false.");
 
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_max_iterations, int,
+            "The maximum number of times the mesh is refined and the problem "
+            "is re-solved (warm-started from the previous solution). "
+            "0 disables mesh refinement (default: 0).");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_tolerance, double,
+            "Mesh intervals whose estimated relative discretization error "
+            "exceeds this tolerance are split in half during mesh refinement "
+            "(default: 1e-3).");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_max_mesh_intervals, int,
+            "Mesh refinement stops if refining would produce more than this "
+            "number of mesh intervals (default: 1000).");
+
     MocoCasADiSolver();
 
     /// Returns true if Moco was compiled with the CasADi library; returns false
@@ -233,6 +270,12 @@ protected:
     std::unique_ptr<CasOC::Solver> createCasOCSolver(
             const MocoCasOCProblem&) const;
 
+    /// Split each mesh interval whose error exceeds the mesh refinement
+    /// tolerance in half. Returns an empty vector if no interval requires
+    /// refinement.
+    std::vector<double> refineMesh(const std::vector<double>& mesh,
+            const std::vector<double>& errors) const;
+
     /// Check that the provided guess is compatible with the problem and this
     /// solver.
     void checkGuess(const MocoTrajectory& guess) const;
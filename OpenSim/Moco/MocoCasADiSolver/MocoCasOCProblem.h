@@ -539,6 +539,24 @@ private:
         m_jar->leave(std::move(mocoProblemRep));
         return names;
     }
+    void initializeOnGridTimes(
+            const std::vector<double>& times) const override {
+        // Evaluate the goals' reference data at the grid times once, and
+        // share the values among all the MocoProblemReps in the jar.
+        const SimTK::Vector simtkTimes((int)times.size(), times.data());
+        std::vector<std::unique_ptr<const MocoProblemRep>> reps;
+        const int jarSize = getJarSize();
+        for (int i = 0; i < jarSize; ++i) {
+            reps.push_back(m_jar->take());
+        }
+        reps[0]->precomputeGoalReferenceValues(simtkTimes);
+        for (int i = 1; i < jarSize; ++i) {
+            reps[i]->shareGoalReferenceValues(*reps[0]);
+        }
+        for (auto& rep : reps) {
+            m_jar->leave(std::move(rep));
+        }
+    }
     void intermediateCallbackImpl() const override {
         m_fileDeletionThrower->throwIfDeleted();
     }
@@ -309,6 +309,21 @@ int MocoContactTrackingGoal::findRecordOffset(
             halfSpaceBaseName, appliedToBody, group.get_external_force_name());
 }
 
+void MocoContactTrackingGoal::calcReferenceValuesImpl(
+        const SimTK::Vector& times, SimTK::Matrix& values) const {
+    values.resize(times.size(), 3 * (int)m_groups.size());
+    SimTK::Vector timeVec(1);
+    for (int itime = 0; itime < times.size(); ++itime) {
+        timeVec[0] = times[itime];
+        for (int ig = 0; ig < (int)m_groups.size(); ++ig) {
+            for (int ir = 0; ir < 3; ++ir) {
+                values(itime, 3 * ig + ir) =
+                        m_groups[ig].refSplines[ir].calcValue(timeVec);
+            }
+        }
+    }
+}
+
 void MocoContactTrackingGoal::calcIntegrandImpl(
         const IntegrandInput& input, double& integrand) const {
     const auto& state = input.state;
@@ -316,6 +331,9 @@ void MocoContactTrackingGoal::calcIntegrandImpl(
     getModel().realizeVelocity(state);
     SimTK::Vector timeVec(1, time);
 
+    // Use the reference values precomputed at the solver's grid if available.
+    const double* precomputed = findPrecomputedReferenceValues(time);
+
     integrand = 0;
     SimTK::Vec3 force_ref;
     for (int ig = 0; ig < (int)m_groups.size(); ++ig) {
@@ -334,8 +352,12 @@ void MocoContactTrackingGoal::calcIntegrandImpl(
         }
 
         // Reference force.
-        for (int ir = 0; ir < force_ref.size(); ++ir) {
-            force_ref[ir] = group.refSplines[ir].calcValue(timeVec);
+        if (precomputed) {
+            force_ref = SimTK::Vec3::getAs(precomputed + 3 * ig);
+        } else {
+            for (int ir = 0; ir < force_ref.size(); ++ir) {
+                force_ref[ir] = group.refSplines[ir].calcValue(timeVec);
+            }
         }
 
         // Re-express the reference force.
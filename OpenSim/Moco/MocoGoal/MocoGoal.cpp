@@ -20,6 +20,9 @@
 
 #include <OpenSim/Moco/Components/ControlDistributor.h>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace OpenSim;
 
 MocoGoal::MocoGoal() {
@@ -49,6 +52,57 @@ void MocoGoal::printDescription() const {
     printDescriptionImpl();
 }
 
+void MocoGoal::precomputeReferenceValues(const SimTK::Vector& times) const {
+    m_precomputedReferenceValues.reset();
+    if (!get_enabled()) { return; }
+
+    // Sort the times (and remove duplicates) so they can be searched.
+    auto precomputed = std::make_shared<PrecomputedReferenceValues>();
+    for (int itime = 0; itime < times.size(); ++itime) {
+        precomputed->times.push_back(times[itime]);
+    }
+    std::sort(precomputed->times.begin(), precomputed->times.end());
+    precomputed->times.erase(std::unique(precomputed->times.begin(),
+                                     precomputed->times.end()),
+            precomputed->times.end());
+    const int numTimes = (int)precomputed->times.size();
+    if (numTimes == 0) { return; }
+
+    SimTK::Matrix values;
+    calcReferenceValuesImpl(
+            SimTK::Vector(numTimes, precomputed->times.data()), values);
+    if (values.nrow() == 0) { return; }
+    OPENSIM_THROW_IF_FRMOBJ(values.nrow() != numTimes, Exception,
+            "Expected calcReferenceValuesImpl() to compute values at {} times, "
+            "but got {} rows.",
+            numTimes, values.nrow());
+
+    precomputed->numValues = values.ncol();
+    precomputed->values.resize(numTimes * values.ncol());
+    for (int itime = 0; itime < numTimes; ++itime) {
+        for (int ival = 0; ival < values.ncol(); ++ival) {
+            precomputed->values[itime * values.ncol() + ival] =
+                    values(itime, ival);
+        }
+    }
+    m_precomputedReferenceValues = std::move(precomputed);
+}
+
+const double* MocoGoal::findPrecomputedReferenceValues(double time) const {
+    if (!m_precomputedReferenceValues) { return nullptr; }
+    const auto& precomputed = *m_precomputedReferenceValues;
+    // The solver may compute the times from the grid slightly differently
+    // than the times it passed to precomputeReferenceValues().
+    const double tolerance = 1e-10 * (1.0 + std::abs(time));
+    const auto it = std::lower_bound(precomputed.times.begin(),
+            precomputed.times.end(), time - tolerance);
+    if (it == precomputed.times.end() || *it > time + tolerance) {
+        return nullptr;
+    }
+    const auto itime = it - precomputed.times.begin();
+    return precomputed.values.data() + itime * precomputed.numValues;
+}
+
 double MocoGoal::calcSystemDisplacement(const GoalInput& input) const {
     const SimTK::Vec3 comInitial =
             getModel().calcMassCenterPosition(input.initial_state);
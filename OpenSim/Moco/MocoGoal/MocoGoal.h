@@ -27,6 +27,9 @@
 #include <OpenSim/Moco/Components/ControlDistributor.h>
 #include <OpenSim/Moco/osimMocoDLL.h>
 
+#include <memory>
+#include <vector>
+
 namespace OpenSim {
 
 class Model;
@@ -296,6 +299,7 @@ public:
     ///       getInputControls() are valid.
     void initializeOnModel(const Model& model) const {
         m_model.reset(&model);
+        m_precomputedReferenceValues.reset();
         if (model.hasComponent<ControlDistributor>("/control_distributor")) {
             m_control_distributor.reset(
                     &model.getComponent<ControlDistributor>(
@@ -348,6 +352,26 @@ public:
                 "but it was not.");
     }
 
+    /// Solvers invoke this function before solving if the times at which
+    /// calcIntegrand() will be invoked are known in advance (e.g., the
+    /// collocation points when the initial and final times are fixed). Goals
+    /// that track reference data then evaluate their reference once at each of
+    /// these times rather than in every calcIntegrand(); at any other time,
+    /// the reference is evaluated as usual. This has no effect on goals that
+    /// do not override calcReferenceValuesImpl().
+    /// @precondition initializeOnModel() has been invoked.
+    void precomputeReferenceValues(const SimTK::Vector& times) const;
+
+    /// Use the reference values that `other` precomputed (see
+    /// precomputeReferenceValues()) instead of computing them again. `other`
+    /// must be a copy of this goal that was initialized on an equivalent model,
+    /// such as the same goal in another MocoProblemRep created from the same
+    /// MocoProblem. Solvers use this to share one set of reference values
+    /// among the copies of the problem used by different threads.
+    void shareReferenceValues(const MocoGoal& other) const {
+        m_precomputedReferenceValues = other.m_precomputedReferenceValues;
+    }
+
     /// Get a vector of the MocoScaleFactors added to this MocoGoal.
     /// @details Note: the return value is constructed fresh on every call from
     /// the internal property. Avoid repeated calls to this function.
@@ -466,6 +490,20 @@ protected:
             const GoalInput& input, SimTK::Vector& goal) const = 0;
     /// Print a more detailed description unique to each goal.
     virtual void printDescriptionImpl() const {};
+    /// Goals that track reference data can override this function to support
+    /// precomputeReferenceValues(). Resize `values` to have a row for each
+    /// element of `times` and a column for each reference value used in
+    /// calcIntegrandImpl(), and fill each row with the reference values at the
+    /// corresponding time. If `values` is left empty (the default), reference
+    /// values are not precomputed.
+    virtual void calcReferenceValuesImpl(const SimTK::Vector& /*times*/,
+            SimTK::Matrix& /*values*/) const {}
+    /// Get the reference values computed by calcReferenceValuesImpl() for the
+    /// given time, or nullptr if reference values were not precomputed at this
+    /// time. The returned array has one element for each column of the matrix
+    /// filled in by calcReferenceValuesImpl(). Use this in calcIntegrandImpl()
+    /// before evaluating the reference data.
+    const double* findPrecomputedReferenceValues(double time) const;
     /// For use within virtual function implementations.
     const Model& getModel() const {
         OPENSIM_THROW_IF_FRMOBJ(!m_model, Exception,
@@ -529,6 +567,18 @@ private:
     mutable Mode m_modeToUse;
     mutable SimTK::Stage m_stageDependency = SimTK::Stage::Acceleration;
     mutable int m_numIntegrals = -1;
+
+    // Reference values computed by calcReferenceValuesImpl(). These are never
+    // modified once computed, so copies of the goal can share them.
+    struct PrecomputedReferenceValues {
+        std::vector<double> times;
+        int numValues = 0;
+        // The values at times[i] are stored in elements
+        // [i * numValues, (i + 1) * numValues).
+        std::vector<double> values;
+    };
+    mutable std::shared_ptr<const PrecomputedReferenceValues>
+            m_precomputedReferenceValues;
 };
 
 inline void MocoGoal::calcIntegrandImpl(
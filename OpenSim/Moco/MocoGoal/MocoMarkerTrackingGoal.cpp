@@ -125,12 +125,32 @@ void MocoMarkerTrackingGoal::initializeOnModelImpl(const Model& model) const {
     setRequirements(1, 1, SimTK::Stage::Position);
 }
 
+void MocoMarkerTrackingGoal::calcReferenceValuesImpl(
+        const SimTK::Vector& times, SimTK::Matrix& values) const {
+    // Only the markers that are tracked, in the order of m_model_markers.
+    values.resize(times.size(), 3 * (int)m_refindices.size());
+    SimTK::Vector timeVec(1);
+    for (int itime = 0; itime < times.size(); ++itime) {
+        timeVec[0] = times[itime];
+        for (int i = 0; i < (int)m_refindices.size(); ++i) {
+            const int refidx = m_refindices[i];
+            for (int j = 0; j < 3; ++j) {
+                values(itime, 3 * i + j) =
+                        m_refsplines[3 * refidx + j].calcValue(timeVec);
+            }
+        }
+    }
+}
+
 void MocoMarkerTrackingGoal::calcIntegrandImpl(
         const IntegrandInput& input, SimTK::Real& integrand) const {
      const auto& time = input.state.getTime();
      getModel().realizePosition(input.state);
      SimTK::Vector timeVec(1, time);
 
+    // Use the reference values precomputed at the solver's grid if available.
+    const double* precomputed = findPrecomputedReferenceValues(time);
+
     for (int i = 0; i < (int)m_model_markers.size(); ++i) {
          const auto& modelValue =
                  m_model_markers[i]->getLocationInGround(input.state);
@@ -139,9 +159,13 @@ void MocoMarkerTrackingGoal::calcIntegrandImpl(
         // Get the markers reference index corresponding to the current
         // model marker and get the reference value.
         int refidx = m_refindices[i];
-        refValue[0] = m_refsplines[3 * refidx].calcValue(timeVec);
-        refValue[1] = m_refsplines[3 * refidx + 1].calcValue(timeVec);
-        refValue[2] = m_refsplines[3 * refidx + 2].calcValue(timeVec);
+        if (precomputed) {
+            refValue = SimTK::Vec3::getAs(precomputed + 3 * i);
+        } else {
+            refValue[0] = m_refsplines[3 * refidx].calcValue(timeVec);
+            refValue[1] = m_refsplines[3 * refidx + 1].calcValue(timeVec);
+            refValue[2] = m_refsplines[3 * refidx + 2].calcValue(timeVec);
+        }
 
         // Apply scale factors for this marker, if they exist.
         const auto& scaleFactorRef = m_scaleFactorRefs[i];
@@ -107,6 +107,8 @@ public:
 
 protected:
     void initializeOnModelImpl(const Model&) const override;
+    void calcReferenceValuesImpl(
+            const SimTK::Vector& times, SimTK::Matrix& values) const override;
     void calcIntegrandImpl(
             const IntegrandInput& input, SimTK::Real& integrand) const override;
     void calcGoalImpl(
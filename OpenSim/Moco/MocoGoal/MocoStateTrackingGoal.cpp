@@ -139,18 +139,32 @@ void MocoStateTrackingGoal::initializeOnModelImpl(const Model& model) const {
     setRequirements(1, 1, SimTK::Stage::Time);
 }
 
+void MocoStateTrackingGoal::calcReferenceValuesImpl(
+        const SimTK::Vector& times, SimTK::Matrix& values) const {
+    values.resize(times.size(), m_refsplines.getSize());
+    SimTK::Vector timeVec(1);
+    for (int itime = 0; itime < times.size(); ++itime) {
+        timeVec[0] = times[itime];
+        for (int iref = 0; iref < m_refsplines.getSize(); ++iref) {
+            values(itime, iref) = m_refsplines[iref].calcValue(timeVec);
+        }
+    }
+}
+
 void MocoStateTrackingGoal::calcIntegrandImpl(
         const IntegrandInput& input, SimTK::Real& integrand) const {
     const auto& time = input.time;
 
+    // Use the reference values precomputed at the solver's grid if available.
+    const double* precomputed = findPrecomputedReferenceValues(time);
     SimTK::Vector timeVec(1, time);
 
-    // TODO cache the reference coordinate values at the mesh points, rather
-    // than evaluating the spline.
     integrand = 0;
     for (int iref = 0; iref < m_refsplines.getSize(); ++iref) {
         const auto& modelValue = input.state.getY()[m_sysYIndices[iref]];
-        const auto& refValue = m_refsplines[iref].calcValue(timeVec);
+        const double refValue = precomputed
+                                        ? precomputed[iref]
+                                        : m_refsplines[iref].calcValue(timeVec);
 
         // If a scale factor exists for this state, retrieve its value.
         double scaleFactor = 1.0;
@@ -152,6 +152,8 @@ public:
 protected:
     // TODO check that the reference covers the entire possible time range.
     void initializeOnModelImpl(const Model&) const override;
+    void calcReferenceValuesImpl(
+            const SimTK::Vector& times, SimTK::Matrix& values) const override;
     void calcIntegrandImpl(
             const IntegrandInput& input, SimTK::Real& integrand) const override;
     void calcGoalImpl(
@@ -18,7 +18,11 @@
 
 #include "MocoParameter.h"
 #include "MocoUtilities.h"
+#include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+#include <OpenSim/Actuators/DeGrooteFregly2016MuscleBank.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/PathPoint.h>
+#include <OpenSim/Simulation/SimbodyEngine/Body.h>
 
 using namespace OpenSim;
 
@@ -83,6 +87,16 @@ void MocoParameter::initializeOnModel(Model& model) const {
     for (int i = 0; i < (int)getProperty_component_paths().size(); ++i) {
         // Get model component.
         auto& component = model.updComponent(get_component_paths(i));
+        // All components must allow the same kind of update; otherwise, fall
+        // back to initSystem().
+        const UpdateType updateType =
+                getUpdateType(model, component, get_property_name());
+        if (m_components.empty()) {
+            m_update_type = updateType;
+        } else if (updateType != m_update_type) {
+            m_update_type = Update_InitSystem;
+        }
+        m_components.emplace_back(&component);
         // Get component property.
         auto* ap = &component.updPropertyByName(get_property_name());
         OPENSIM_THROW_IF_FRMOBJ(ap->isListProperty(), Exception, 
@@ -129,6 +143,37 @@ void MocoParameter::initializeOnModel(Model& model) const {
     }
 }
 
+MocoParameter::UpdateType MocoParameter::getUpdateType(const Model& model,
+        const Component& component, const std::string& propertyName) {
+    if (dynamic_cast<const Body*>(&component)) {
+        if (propertyName == "mass" || propertyName == "mass_center" ||
+                propertyName == "inertia") {
+            return Update_MassProperties;
+        }
+    } else if (dynamic_cast<const PathPoint*>(&component)) {
+        if (propertyName == "location") return Update_PathPoint;
+    } else if (dynamic_cast<const DeGrooteFregly2016Muscle*>(&component)) {
+        // DeGrooteFregly2016MuscleBank copies the muscle properties when it is
+        // connected to the model.
+        if (model.countNumComponents<DeGrooteFregly2016MuscleBank>()) {
+            return Update_InitSystem;
+        }
+        // These properties are read whenever the muscle computes its
+        // dynamics, and do not affect the System's topology.
+        static const std::vector<std::string> runtimeProperties{
+                "max_isometric_force", "optimal_fiber_length",
+                "tendon_slack_length", "pennation_angle_at_optimal",
+                "max_contraction_velocity", "active_force_width_scale",
+                "fiber_damping", "passive_fiber_strain_at_one_norm_force",
+                "tendon_strain_at_one_norm_force"};
+        if (std::find(runtimeProperties.begin(), runtimeProperties.end(),
+                    propertyName) != runtimeProperties.end()) {
+            return Update_None;
+        }
+    }
+    return Update_InitSystem;
+}
+
 void MocoParameter::printDescription() const {
     const std::vector<std::string> componentPaths = getComponentPaths();
 
@@ -162,4 +207,18 @@ void MocoParameter::applyParameterToModelProperties(const double& value) const {
             }
         }
     }
+    // PathPoint keeps a copy of its location in its Station.
+    if (m_update_type == Update_PathPoint) {
+        for (auto& component : m_components) {
+            auto& pathPoint = static_cast<PathPoint&>(*component);
+            pathPoint.setLocation(pathPoint.get_location());
+        }
+    }
+}
+
+void MocoParameter::applyParameterToMassProperties() const {
+    if (m_update_type != Update_MassProperties) return;
+    for (auto& component : m_components) {
+        static_cast<Body&>(*component).updateMobilizedBodyMassProperties();
+    }
 }
@@ -26,6 +26,7 @@
 
 namespace OpenSim {
 
+class Component;
 class Model;
 
 /** A MocoParameter allows you to optimize property values in an OpenSim Model.
@@ -155,6 +156,26 @@ public:
     properties from multiple models. */
     void applyParameterToModelProperties(const double& value) const;
 
+    /** Can this parameter take effect without calling Model::initSystem() on
+    the models? This is the case for the mass properties (mass,
+    mass_center, inertia) of a Body, the location of a PathPoint, and the
+    properties of a DeGrooteFregly2016Muscle that are read during
+    simulation (e.g., max_isometric_force or tendon_slack_length). This is
+    only valid after initializeOnModel(). */
+    bool isAppliedWithoutInitSystem() const
+    {   return m_update_type != Update_InitSystem; }
+    /** Does this parameter change the mass properties of bodies? If so, and
+    if initSystem() is not used, applyParameterToMassProperties() must be
+    invoked after applyParameterToModelProperties(), and the models' System
+    topology must be realized again (e.g., with Model::initializeState()). */
+    bool getChangesMassProperties() const
+    {   return m_update_type == Update_MassProperties; }
+    /** Update the mass properties of the mobilized bodies in the models'
+    Systems from the stored Body properties (see
+    Body::updateMobilizedBodyMassProperties()). This has no effect if
+    getChangesMassProperties() is false. */
+    void applyParameterToMassProperties() const;
+
     /** Print the name, property name, component paths, property element (if it
     exists), and bounds for this parameter. */
     void printDescription() const;
@@ -177,6 +198,18 @@ private:
         Type_Vec6
     };
     mutable DataType m_data_type;
+    // How the models must be updated for new property values to take effect.
+    enum UpdateType {
+        Update_InitSystem,
+        Update_MassProperties,
+        Update_PathPoint,
+        Update_None
+    };
+    mutable UpdateType m_update_type = Update_InitSystem;
+    // The components that own the properties in m_property_refs.
+    mutable std::vector<SimTK::ReferencePtr<Component>> m_components;
+    static UpdateType getUpdateType(const Model& model,
+            const Component& component, const std::string& propertyName);
     void constructProperties();
     
 };
@@ -915,6 +915,32 @@ const MocoParameter& MocoProblemRep::getParameter(
     }
     OPENSIM_THROW(Exception, "No parameter with name '{}' found.", name);
 }
+void MocoProblemRep::precomputeGoalReferenceValues(
+        const SimTK::Vector& times) const {
+    for (const auto& cost : m_costs) {
+        cost->precomputeReferenceValues(times);
+    }
+    for (const auto& endpoint_constraint : m_endpoint_constraints) {
+        endpoint_constraint->precomputeReferenceValues(times);
+    }
+}
+
+void MocoProblemRep::shareGoalReferenceValues(
+        const MocoProblemRep& other) const {
+    OPENSIM_THROW_IF(other.m_costs.size() != m_costs.size() ||
+                    other.m_endpoint_constraints.size() !=
+                            m_endpoint_constraints.size(),
+            Exception,
+            "Expected the other MocoProblemRep to have the same goals.");
+    for (int i = 0; i < (int)m_costs.size(); ++i) {
+        m_costs[i]->shareReferenceValues(*other.m_costs[i]);
+    }
+    for (int i = 0; i < (int)m_endpoint_constraints.size(); ++i) {
+        m_endpoint_constraints[i]->shareReferenceValues(
+                *other.m_endpoint_constraints[i]);
+    }
+}
+
 const MocoGoal& MocoProblemRep::getCost(const std::string& name) const {
 
     for (const auto& c : m_costs) {
@@ -986,11 +1012,45 @@ void MocoProblemRep::applyParametersToModelProperties(
         m_parameters[i]->applyParameterToModelProperties(parameterValues(i));
     }
     if (initSystemAndDisableConstraints) {
+        // Parameters of the most common types take effect without rebuilding
+        // the models' Systems (see MocoParameter::isAppliedWithoutInitSystem()).
+        bool requiresInitSystem = false;
+        bool changesMassProperties = false;
+        for (const auto& param : m_parameters) {
+            if (!param->isAppliedWithoutInitSystem()) {
+                requiresInitSystem = true;
+            }
+            if (param->getChangesMassProperties()) {
+                changesMassProperties = true;
+            }
+        }
+        if (!requiresInitSystem) {
+            if (!changesMassProperties) {
+                // The new property values are read during realization;
+                // discard anything computed with the previous values.
+                m_state_base.invalidateAllCacheAtOrAbove(
+                        SimTK::Stage::Instance);
+                for (auto& stateDisCon : m_state_disabled_constraints) {
+                    stateDisCon.invalidateAllCacheAtOrAbove(
+                            SimTK::Stage::Instance);
+                }
+                return;
+            }
+            // Mass properties are part of the System's topology, but the
+            // topology can be realized again without rebuilding the System.
+            for (const auto& param : m_parameters) {
+                param->applyParameterToMassProperties();
+            }
+        }
+
         // TODO: Avoid these const_casts.
 
         // Model base.
         // -----------
-        const_cast<Model&>(m_model_base).initSystem();
+        Model& m_model_base_const_cast = const_cast<Model&>(m_model_base);
+        m_state_base = requiresInitSystem
+                               ? m_model_base_const_cast.initSystem()
+                               : m_model_base_const_cast.initializeState();
         // The PrescribedMotion is disabled by default in the model so that,
         // if there are constraints, the AssemblySolver does not complain about
         // having 0 parameters with which to satisfy the constraints. After
@@ -1006,7 +1066,10 @@ void MocoProblemRep::applyParametersToModelProperties(
                 const_cast<Model&>(m_model_disabled_constraints);
 
         m_state_disabled_constraints[0] =
-                m_model_disabled_constraints_const_cast.initSystem();
+                requiresInitSystem
+                        ? m_model_disabled_constraints_const_cast.initSystem()
+                        : m_model_disabled_constraints_const_cast
+                                  .initializeState();
         m_state_disabled_constraints[1] = m_state_disabled_constraints[0];
         // See comment above for m_position_motion_base.
         if (m_position_motion_disabled_constraints) {
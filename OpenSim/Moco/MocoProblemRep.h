@@ -240,6 +240,16 @@ public:
     /// in getPathConstraintNames(). Note: this does not perform a bounds check.
     const MocoPathConstraint& getPathConstraintByIndex(int index) const;
 
+    /// Invoke MocoGoal::precomputeReferenceValues() on all costs and endpoint
+    /// constraints. Solvers invoke this when the times at which integrands
+    /// are evaluated are known before solving (i.e., the initial and final
+    /// times are fixed).
+    void precomputeGoalReferenceValues(const SimTK::Vector& times) const;
+    /// Use the goal reference values precomputed by `other`, which must be
+    /// created from the same MocoProblem as this MocoProblemRep. See
+    /// MocoGoal::shareReferenceValues().
+    void shareGoalReferenceValues(const MocoProblemRep& other) const;
+
     /// Get the number of scalar path constraints in the MocoProblem. This does
     /// not include kinematic constraints equations.
     int getNumPathConstraintEquations() const {
@@ -322,7 +332,10 @@ public:
     /// method in order for provided parameter values to be applied to the
     /// model. You can pass `true` to have initSystem() called for you, and to
     /// also re-disable any constraints re-enabled by the initSystem() call
-    /// (see getModelDisabledConstraints()).
+    /// (see getModelDisabledConstraints()). If no parameter requires
+    /// initSystem() (see MocoParameter::isAppliedWithoutInitSystem()), the
+    /// models' existing Systems are updated in place instead, which is much
+    /// faster.
     void applyParametersToModelProperties(const SimTK::Vector& parameterValues,
             bool initSystemAndDisableConstraints = false) const;
 
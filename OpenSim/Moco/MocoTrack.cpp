@@ -45,6 +45,7 @@ void MocoTrack::constructProperties() {
     constructProperty_markers_weight_set(MocoWeightSet());
     constructProperty_allow_unused_references(false);
     constructProperty_guess_file("");
+    constructProperty_guess_library("");
     constructProperty_apply_tracked_states_to_guess(false);
     constructProperty_minimize_control_effort(true);
     constructProperty_control_effort_weight(0.001);
@@ -119,10 +120,29 @@ MocoStudy MocoTrack::initialize() {
     // Set the problem guess.
     // ----------------------
     // If the user provided a guess file, use that guess in the solver.
+    // Otherwise, if the user provided a guess library, use the closest stored
+    // solution, if any.
     if (!get_guess_file().empty()) {
         solver.setGuessFile(getFilePath(get_guess_file()));
     } else {
         solver.setGuess("bounds");
+        if (!get_guess_library().empty()) {
+            MocoTrajectoryLibrary library(getFilePath(get_guess_library()));
+            m_guessLibraryFeatures = MocoTrajectoryLibrary::computeFeatures(
+                    model, tracked_states, m_timeInfo.initial,
+                    m_timeInfo.final);
+            if (library.findNearest(m_guessLibraryFeatures) != -1) {
+                try {
+                    solver.setGuess(library.createGuess(m_guessLibraryFeatures,
+                            m_timeInfo.initial, m_timeInfo.final));
+                } catch (const Exception& ex) {
+                    log_warn("MocoTrack: could not use the guess from the "
+                             "guess library; using a guess constructed from "
+                             "the variable bounds instead. Reason: {}",
+                            ex.getMessage());
+                }
+            }
+        }
     }
 
     // Apply states from the reference data the to solver guess if specified by
@@ -145,6 +165,13 @@ MocoSolution MocoTrack::solveInternal(bool visualize) {
     MocoSolution solution = study.solve();
     if (visualize) { study.visualize(solution); }
 
+    // Store the solution so that future problems can use it as a guess.
+    if (get_guess_file().empty() && !get_guess_library().empty() &&
+            solution.success()) {
+        MocoTrajectoryLibrary library(getFilePath(get_guess_library()));
+        library.add(solution, m_guessLibraryFeatures);
+    }
+
     return solution;
 }
 
@@ -20,6 +20,7 @@
 
 #include "MocoStudy.h"
 #include "MocoTool.h"
+#include "MocoTrajectoryLibrary.h"
 #include "ModelOperatorsDGF.h"
 #include "OpenSim/Simulation/TableProcessor.h"
 #include "osimMocoDLL.h"
@@ -220,6 +221,15 @@ public:
             "provided, then a guess constructed from the variable bounds "
             "midpoints will be used.");
 
+    OpenSim_DECLARE_PROPERTY(guess_library, std::string,
+            "Path to a directory containing a MocoTrajectoryLibrary. If "
+            "provided (and no `guess_file` is provided), the guess is created "
+            "from the stored solution whose model structure, duration, and "
+            "states reference statistics are closest to this problem, and "
+            "successful solutions from solve() are added to the library. The "
+            "path can be absolute or relative to the setup file. "
+            "Default: empty.");
+
     OpenSim_DECLARE_PROPERTY(apply_tracked_states_to_guess, bool,
             "If a `states_reference` has been provided, use this setting to "
             "replace the states in the guess with the states reference data. "
@@ -272,6 +282,7 @@ public:
 private:
     Model m_model;
     TimeInfo m_timeInfo;
+    MocoTrajectoryLibrary::Features m_guessLibraryFeatures;
 
     void constructProperties();
 
@@ -0,0 +1,239 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoTrajectoryLibrary.cpp                                         *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2024 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoTrajectoryLibrary.h"
+
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Simulation/Model/Actuator.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace OpenSim;
+
+namespace {
+// 64-bit FNV-1a hash. Unlike std::hash, this hash does not depend on the
+// platform or standard library, so the library can be shared across machines.
+std::uint64_t hashString(const std::string& str) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char c : str) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool endsWith(const std::string& str, const std::string& suffix) {
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+} // anonymous namespace
+
+MocoTrajectoryLibrary::MocoTrajectoryLibrary(std::string directory)
+        : m_directory(std::move(directory)) {
+    OPENSIM_THROW_IF(m_directory.empty(), Exception,
+            "Expected a non-empty directory for the trajectory library.");
+    readIndex();
+}
+
+std::string MocoTrajectoryLibrary::getIndexPath() const {
+    return m_directory + "/moco_trajectory_library.txt";
+}
+
+void MocoTrajectoryLibrary::readIndex() {
+    m_entries.clear();
+    std::ifstream file(getIndexPath());
+    if (!file.good()) return;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ss(line);
+        Entry entry;
+        int numStatistics = 0;
+        ss >> entry.filename >> entry.features.model_hash >>
+                entry.features.duration >> numStatistics;
+        OPENSIM_THROW_IF(ss.fail() || numStatistics < 0, Exception,
+                "Could not parse line '{}' of trajectory library index "
+                "file '{}'.",
+                line, getIndexPath());
+        entry.features.reference_statistics.resize(numStatistics);
+        for (auto& value : entry.features.reference_statistics) {
+            ss >> value;
+        }
+        OPENSIM_THROW_IF(ss.fail(), Exception,
+                "Expected {} reference statistics in line '{}' of trajectory "
+                "library index file '{}'.",
+                numStatistics, line, getIndexPath());
+        m_entries.push_back(std::move(entry));
+    }
+}
+
+std::string MocoTrajectoryLibrary::computeModelHash(const Model& model) {
+    std::vector<std::string> names;
+    const auto stateNames = model.getStateVariableNames();
+    for (int i = 0; i < stateNames.getSize(); ++i) {
+        names.push_back(stateNames[i]);
+    }
+    for (const auto& actu : model.getComponentList<Actuator>()) {
+        names.push_back(actu.getAbsolutePathString());
+    }
+    std::sort(names.begin(), names.end());
+    std::string joined;
+    for (const auto& name : names) {
+        joined += name;
+        joined += '\n';
+    }
+    return fmt::format("{:016x}", hashString(joined));
+}
+
+MocoTrajectoryLibrary::Features MocoTrajectoryLibrary::computeFeatures(
+        const Model& model, const TimeSeriesTable& reference,
+        double initialTime, double finalTime) {
+    OPENSIM_THROW_IF(finalTime <= initialTime, Exception,
+            "Expected the final time ({}) to be greater than the initial time "
+            "({}).",
+            finalTime, initialTime);
+    Features features;
+    features.model_hash = computeModelHash(model);
+    features.duration = finalTime - initialTime;
+    const int numRows = (int)reference.getNumRows();
+    if (numRows == 0) return features;
+    for (int icol = 0; icol < (int)reference.getNumColumns(); ++icol) {
+        const auto column = reference.getDependentColumnAtIndex(icol);
+        const double mean = column.sum() / numRows;
+        double variance = 0;
+        for (int irow = 0; irow < numRows; ++irow) {
+            variance += SimTK::square(column[irow] - mean);
+        }
+        features.reference_statistics.push_back(mean);
+        features.reference_statistics.push_back(
+                std::sqrt(variance / numRows));
+    }
+    return features;
+}
+
+const MocoTrajectoryLibrary::Features& MocoTrajectoryLibrary::getFeatures(
+        int index) const {
+    OPENSIM_THROW_IF(index < 0 || index >= getNumEntries(), IndexOutOfRange,
+            index, 0, getNumEntries() - 1);
+    return m_entries[index].features;
+}
+
+MocoTrajectory MocoTrajectoryLibrary::getTrajectory(int index) const {
+    OPENSIM_THROW_IF(index < 0 || index >= getNumEntries(), IndexOutOfRange,
+            index, 0, getNumEntries() - 1);
+    return MocoTrajectory(m_directory + "/" + m_entries[index].filename);
+}
+
+void MocoTrajectoryLibrary::add(
+        const MocoTrajectory& trajectory, const Features& features) {
+    OPENSIM_THROW_IF(features.model_hash.empty(), Exception,
+            "Expected the features to contain a model hash.");
+    OPENSIM_THROW_IF(trajectory.empty(), Exception,
+            "Cannot add an empty trajectory to the library.");
+    IO::makeDir(m_directory);
+
+    // Find a filename that is not already in use.
+    int number = getNumEntries();
+    std::string filename;
+    do {
+        filename = fmt::format("trajectory_{:05d}.sto", number++);
+    } while (IO::FileExists(m_directory + "/" + filename));
+    trajectory.write(m_directory + "/" + filename);
+
+    std::ofstream file(getIndexPath(), std::ios_base::app);
+    OPENSIM_THROW_IF(!file.good(), Exception,
+            "Could not open trajectory library index file '{}'.",
+            getIndexPath());
+    file << std::setprecision(17) << filename << "\t" << features.model_hash
+         << "\t" << features.duration << "\t"
+         << features.reference_statistics.size();
+    for (const auto& value : features.reference_statistics) {
+        file << "\t" << value;
+    }
+    file << std::endl;
+    m_entries.push_back({filename, features});
+}
+
+int MocoTrajectoryLibrary::findNearest(const Features& features) const {
+    int nearest = -1;
+    double minDistance = SimTK::Infinity;
+    for (int i = 0; i < getNumEntries(); ++i) {
+        const auto& stored = m_entries[i].features;
+        if (stored.model_hash != features.model_hash) continue;
+        if (stored.reference_statistics.size() !=
+                features.reference_statistics.size()) {
+            continue;
+        }
+        double distance = SimTK::square(stored.duration - features.duration);
+        for (int j = 0; j < (int)stored.reference_statistics.size(); ++j) {
+            distance += SimTK::square(stored.reference_statistics[j] -
+                                      features.reference_statistics[j]);
+        }
+        if (distance < minDistance) {
+            minDistance = distance;
+            nearest = i;
+        }
+    }
+    return nearest;
+}
+
+MocoTrajectory MocoTrajectoryLibrary::createGuess(const Features& features,
+        double initialTime, double finalTime, int numTimes) const {
+    const int index = findNearest(features);
+    OPENSIM_THROW_IF(index == -1, Exception,
+            "The trajectory library in '{}' does not contain a trajectory "
+            "compatible with model hash '{}'.",
+            m_directory, features.model_hash);
+    OPENSIM_THROW_IF(finalTime <= initialTime, Exception,
+            "Expected the final time ({}) to be greater than the initial time "
+            "({}).",
+            finalTime, initialTime);
+    MocoTrajectory guess = getTrajectory(index);
+
+    // Map the time onto the new time range.
+    const double oldInitialTime = guess.getInitialTime();
+    const double oldDuration = guess.getFinalTime() - oldInitialTime;
+    const double newDuration = finalTime - initialTime;
+    SimTK::Vector time = guess.getTime();
+    for (int itime = 0; itime < time.size(); ++itime) {
+        time[itime] = initialTime + (time[itime] - oldInitialTime) /
+                                            oldDuration * newDuration;
+    }
+    guess.setTime(time);
+
+    // Rescale rates so that the kinematics are consistent with the new time.
+    const double ratio = oldDuration / newDuration;
+    for (const auto& name : guess.getStateNames()) {
+        if (endsWith(name, "/speed")) {
+            guess.setState(name, ratio * guess.getState(name));
+        }
+    }
+    for (const auto& name : guess.getDerivativeNames()) {
+        if (endsWith(name, "/accel")) {
+            guess.setDerivative(name, ratio * ratio * guess.getDerivative(name));
+        }
+    }
+
+    if (numTimes != -1) guess.resampleWithNumTimes(numTimes);
+    return guess;
+}
@@ -0,0 +1,134 @@
+#ifndef OPENSIM_MOCOTRAJECTORYLIBRARY_H
+#define OPENSIM_MOCOTRAJECTORYLIBRARY_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoTrajectoryLibrary.h                                           *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2024 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoTrajectory.h"
+
+namespace OpenSim {
+
+class Model;
+
+/** A persistent collection of solved MocoTrajectory%s that can be used to
+construct initial guesses for new problems. This is useful when solving many
+similar problems (e.g., tracking problems for a cohort of subjects scaled from
+the same generic model): the solution to a previous problem is often a much
+better initial guess than a guess constructed from the variable bounds.
+
+Each trajectory in the library is stored alongside a set of features that
+describe the problem it solves:
+- a hash of the model structure (the names of the state variables and
+  actuators, but not property values, so that models scaled from the same
+  generic model share a hash),
+- the duration of the trajectory, and
+- statistics (mean and standard deviation of each column) of the reference
+  data that was tracked, if any.
+
+When a new problem is solved, use findNearest() to obtain the stored
+trajectory whose model hash matches and whose remaining features are closest
+(in the Euclidean sense), or use createGuess() to obtain that trajectory
+mapped onto the time range of the new problem.
+
+The library lives in a directory on disk. Each trajectory is written to a
+separate STO file, and the features are written to an index file
+(`moco_trajectory_library.txt`) in the same directory.
+
+@code{.cpp}
+MocoTrajectoryLibrary library("solution_library");
+auto features = MocoTrajectoryLibrary::computeFeatures(model, reference,
+        initialTime, finalTime);
+if (library.findNearest(features) != -1) {
+    solver.setGuess(library.createGuess(features, initialTime, finalTime));
+}
+MocoSolution solution = study.solve();
+if (solution.success()) library.add(solution, features);
+@endcode
+
+@note The library is not safe to modify from multiple processes at once.
+@underdevelopment */
+class OSIMMOCO_API MocoTrajectoryLibrary {
+public:
+    /// The quantities used to determine which stored trajectory is closest to
+    /// a new problem.
+    struct Features {
+        std::string model_hash;
+        double duration = SimTK::NaN;
+        std::vector<double> reference_statistics;
+    };
+
+    /// Load the library stored in the provided directory. The directory is
+    /// created when the first trajectory is added, if it does not exist.
+    explicit MocoTrajectoryLibrary(std::string directory);
+
+    /// Compute the features for a problem using the provided model (on which
+    /// initSystem() must have been called) and reference data. The reference
+    /// may be empty, in which case only the model hash and duration are used.
+    static Features computeFeatures(const Model& model,
+            const TimeSeriesTable& reference, double initialTime,
+            double finalTime);
+
+    /// Compute a hash that identifies the structure of the model (the names
+    /// of its state variables and actuators). The hash is stable across
+    /// platforms and OpenSim versions.
+    /// @precondition initSystem() must have been called on the model.
+    static std::string computeModelHash(const Model& model);
+
+    /// The number of trajectories in the library.
+    int getNumEntries() const { return (int)m_entries.size(); }
+
+    /// The features of the trajectory at the provided index.
+    const Features& getFeatures(int index) const;
+
+    /// Load the trajectory at the provided index from file.
+    MocoTrajectory getTrajectory(int index) const;
+
+    /// Write the trajectory to the library directory and add it (with the
+    /// provided features) to the index file.
+    void add(const MocoTrajectory& trajectory, const Features& features);
+
+    /// Get the index of the stored trajectory with the same model hash whose
+    /// duration and reference statistics are closest to those provided.
+    /// Returns -1 if no trajectory with a matching model hash (and number of
+    /// reference statistics) exists.
+    int findNearest(const Features& features) const;
+
+    /// Create a guess from the nearest stored trajectory (see findNearest()).
+    /// The trajectory is mapped linearly onto [initialTime, finalTime], the
+    /// generalized speeds (and other states and derivatives whose names end
+    /// in "/speed" or "/accel") are rescaled by the ratio of durations, and
+    /// the trajectory is resampled with `numTimes` time points (or the
+    /// stored number of time points if `numTimes` is -1).
+    /// @throws Exception if there is no compatible trajectory in the library.
+    MocoTrajectory createGuess(const Features& features, double initialTime,
+            double finalTime, int numTimes = -1) const;
+
+private:
+    struct Entry {
+        std::string filename;
+        Features features;
+    };
+    std::string getIndexPath() const;
+    void readIndex();
+
+    std::string m_directory;
+    std::vector<Entry> m_entries;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MOCOTRAJECTORYLIBRARY_H
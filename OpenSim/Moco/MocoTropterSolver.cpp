@@ -23,6 +23,8 @@
 #include <OpenSim/Common/Assertion.h>
 #include <OpenSim/Common/Stopwatch.h>
 
+#include <thread>
+
 #ifdef OPENSIM_WITH_TROPTER
     #include "tropter/TropterProblem.h"
 #endif
@@ -35,6 +37,7 @@ void MocoTropterSolver::constructProperties() {
     constructProperty_optim_jacobian_approximation("exact");
     constructProperty_optim_sparsity_detection("random");
     constructProperty_exact_hessian_block_sparsity_mode();
+    constructProperty_parallel();
 }
 
 bool MocoTropterSolver::isAvailable() {
@@ -203,6 +206,27 @@ MocoTropterSolver::createTropterSolver(
             {"random", "initial-guess"});
     optsolver.set_sparsity_detection(get_optim_sparsity_detection());
 
+    // Compute finite differences in parallel.
+    int parallel = 0;
+    int parallelEV = getMocoParallelEnvironmentVariable();
+    if (getProperty_parallel().size()) {
+        OPENSIM_THROW_IF_FRMOBJ(get_parallel() < 0, Exception,
+                "Expected the property 'parallel' to be non-negative, but "
+                "got {}.", get_parallel());
+        parallel = get_parallel();
+    } else if (parallelEV != -1) {
+        parallel = parallelEV;
+    }
+    int numThreads;
+    if (parallel == 0) {
+        numThreads = 1;
+    } else if (parallel == 1) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    } else {
+        numThreads = parallel;
+    }
+    optsolver.set_findiff_num_threads(numThreads);
+
     // Set advanced settings.
     // for (int i = 0; i < getProperty_optim_solver_options(); ++i) {
     //    optsolver.set_advanced_option(TODO);
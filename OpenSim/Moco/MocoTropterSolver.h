@@ -85,6 +85,12 @@ public:
             "property must be set. Note: this option only takes effect when "
             "using "
             "IPOPT.");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(parallel, int,
+            "Compute the finite difference derivatives in parallel, using a "
+            "copy of the problem for each thread? 0: not parallel (default); "
+            "1: use all cores; greater than 1: use this number of threads. "
+            "The derivatives do not depend on this setting. This overrides the "
+            "OPENSIM_MOCO_PARALLEL environment variable.");
 
     MocoTropterSolver();
 
@@ -1397,6 +1397,106 @@ TEST_CASE("MocoGoal divide by displacement/duration/mass") {
         Catch::Matchers::WithinAbs(mass, SimTK::Eps));
 }
 
+/// This goal's reference value at time t is 2t. The integrand is the
+/// precomputed reference value, or -1 if it was not precomputed.
+class MocoPrecomputedReferenceTestingGoal : public MocoGoal {
+    OpenSim_DECLARE_CONCRETE_OBJECT(
+            MocoPrecomputedReferenceTestingGoal, MocoGoal);
+public:
+    MocoPrecomputedReferenceTestingGoal() = default;
+protected:
+    void initializeOnModelImpl(const Model&) const override {
+        setRequirements(1, 1, SimTK::Stage::Topology);
+    }
+    void calcReferenceValuesImpl(
+            const SimTK::Vector& times, SimTK::Matrix& values) const override {
+        values.resize(times.size(), 1);
+        for (int i = 0; i < times.size(); ++i) { values(i, 0) = 2 * times[i]; }
+    }
+    void calcIntegrandImpl(const IntegrandInput& input,
+            SimTK::Real& integrand) const override {
+        const double* reference = findPrecomputedReferenceValues(input.time);
+        integrand = reference ? reference[0] : -1;
+    }
+    void calcGoalImpl(
+            const GoalInput& input, SimTK::Vector& values) const override {
+        values[0] = input.integral;
+    }
+};
+
+TEST_CASE("MocoGoal precomputed reference values") {
+    Model model;
+    SimTK::State state = model.initSystem();
+    MocoPrecomputedReferenceTestingGoal goal;
+    goal.initializeOnModel(model);
+    auto integrand = [&](const MocoGoal& g, double time) {
+        return g.calcIntegrand({time, state, {}});
+    };
+    CHECK(integrand(goal, 0.5) == -1);
+
+    // The times need not be sorted or unique.
+    goal.precomputeReferenceValues(createVector({0.5, 0.0, 1.0, 0.5}));
+    CHECK(integrand(goal, 0.0) == 0);
+    CHECK(integrand(goal, 0.5) == 1.0);
+    CHECK(integrand(goal, 1.0) == 2.0);
+    // Times that differ only by roundoff use the precomputed values.
+    CHECK(integrand(goal, 0.5 + 1e-14) == 1.0);
+    CHECK(integrand(goal, 0.25) == -1);
+    CHECK(integrand(goal, 1.5) == -1);
+
+    // Copies can share the precomputed values.
+    MocoPrecomputedReferenceTestingGoal copy;
+    copy.initializeOnModel(model);
+    CHECK(integrand(copy, 0.5) == -1);
+    copy.shareReferenceValues(goal);
+    CHECK(integrand(copy, 0.5) == 1.0);
+
+    // Initializing again discards the precomputed values.
+    goal.initializeOnModel(model);
+    CHECK(integrand(goal, 0.5) == -1);
+}
+
+TEST_CASE("MocoStateTrackingGoal precomputed reference values") {
+    MocoProblem problem;
+    problem.setModel(createSlidingMassModel());
+    problem.setTimeBounds(0, 1);
+    problem.setStateInfo("/slider/position/value", {-1, 1});
+    problem.setStateInfo("/slider/position/speed", {-10, 10});
+
+    TimeSeriesTable reference;
+    reference.setColumnLabels({"/slider/position/value"});
+    for (int i = 0; i <= 20; ++i) {
+        const double time = 0.05 * i;
+        reference.appendRow(time, SimTK::RowVector(1, std::sin(3 * time)));
+    }
+    auto* tracking = problem.addGoal<MocoStateTrackingGoal>("tracking");
+    tracking->setReference(TableProcessor(reference));
+
+    MocoProblemRep rep = problem.createRep();
+    MocoProblemRep otherRep = problem.createRep();
+    const auto& goal = rep.getCost("tracking");
+    const auto& otherGoal = otherRep.getCost("tracking");
+    SimTK::State state = rep.getModelBase().getWorkingState();
+    state.updQ()[0] = 0.3;
+
+    const SimTK::Vector times = createVector({0.0, 0.13, 0.5, 0.87, 1.0});
+    std::vector<double> expected;
+    for (int i = 0; i < times.size(); ++i) {
+        state.setTime(times[i]);
+        expected.push_back(goal.calcIntegrand({times[i], state, {}}));
+    }
+
+    rep.precomputeGoalReferenceValues(times);
+    otherRep.shareGoalReferenceValues(rep);
+    for (int i = 0; i < times.size(); ++i) {
+        state.setTime(times[i]);
+        CHECK_THAT(goal.calcIntegrand({times[i], state, {}}),
+                Catch::Matchers::WithinAbs(expected[i], 1e-12));
+        CHECK_THAT(otherGoal.calcIntegrand({times[i], state, {}}),
+                Catch::Matchers::WithinAbs(expected[i], 1e-12));
+    }
+}
+
 TEST_CASE("MocoFrameDistanceConstraint de/serialization") {
 
     {
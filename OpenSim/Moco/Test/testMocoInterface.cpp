@@ -19,6 +19,7 @@
 #include <OpenSim/Actuators/BodyActuator.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Moco/osimMoco.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
@@ -184,6 +185,44 @@ TEMPLATE_TEST_CASE("Non-uniform mesh", "", MocoCasADiSolver, MocoTropterSolver)
     }
 }
 
+TEST_CASE("Mesh refinement", "[casadi]") {
+    auto transcriptionScheme =
+            GENERATE(as<std::string>{}, "trapezoidal", "hermite-simpson");
+    MocoStudy study;
+    study.setName("sliding_mass");
+    study.set_write_solution("false");
+    MocoProblem& mp = study.updProblem();
+    mp.setModel(createSlidingMassModel());
+    mp.setTimeBounds(0, 2.0);
+    mp.setStateInfo("/slider/position/value", {0, 1}, 0, 1);
+    mp.setStateInfo("/slider/position/speed", {-100, 100}, 0, 0);
+    mp.addGoal<MocoControlGoal>();
+
+    auto& ms = study.initSolver<MocoCasADiSolver>();
+    ms.set_transcription_scheme(transcriptionScheme);
+    ms.set_num_mesh_intervals(4);
+    MocoSolution coarse = study.solve();
+    REQUIRE(coarse.success());
+
+    ms.set_mesh_refinement_max_iterations(3);
+    ms.set_mesh_refinement_tolerance(1e-5);
+    MocoSolution refined = study.solve();
+    REQUIRE(refined.success());
+    CHECK(refined.getNumTimes() > coarse.getNumTimes());
+    CHECK(refined.getTime()[0] == Approx(0));
+    CHECK(refined.getFinalTime() == Approx(2.0));
+    // The refined solution must still satisfy the boundary conditions.
+    const auto position = refined.getState("/slider/position/value");
+    CHECK(position[0] == Approx(0).margin(1e-6));
+    CHECK(position[position.size() - 1] == Approx(1).margin(1e-6));
+
+    SECTION("Refinement is limited by the maximum number of mesh intervals") {
+        ms.set_mesh_refinement_max_mesh_intervals(4);
+        MocoSolution limited = study.solve();
+        CHECK(limited.getNumTimes() == coarse.getNumTimes());
+    }
+}
+
 /// This model is torque-actuated.
 std::unique_ptr<Model> createPendulumModel() {
     auto model = make_unique<Model>();
@@ -1650,6 +1689,80 @@ TEST_CASE("MocoTrajectory randomize") {
     }
 }
 
+TEST_CASE("MocoTrajectoryLibrary") {
+    auto model = createSlidingMassModel();
+    model->initSystem();
+    const std::string directory = "testMocoInterface_trajectory_library";
+    // Remove the files that the library writes, and its directory.
+    const auto removeLibrary = [&directory]() {
+        const int numEntries = MocoTrajectoryLibrary(directory).getNumEntries();
+        for (int i = 0; i < numEntries; ++i) {
+            std::remove(fmt::format("{}/trajectory_{:05d}.sto", directory, i)
+                                .c_str());
+        }
+        std::remove((directory + "/moco_trajectory_library.txt").c_str());
+        IO::removeDir(directory);
+    };
+    removeLibrary();
+
+    const auto time = createVectorLinspace(5, 0.0, 1.0);
+    SimTK::Matrix states(5, 2);
+    SimTK::Matrix controls(5, 1);
+    for (int i = 0; i < 5; ++i) {
+        states(i, 0) = time[i];
+        states(i, 1) = 1.0;
+        controls(i, 0) = 0.0;
+    }
+    MocoTrajectory traj(time,
+            {{"states", {{"/slider/position/value", "/slider/position/speed"},
+                                states}},
+                    {"controls", {{"/actuator"}, controls}}});
+
+    TimeSeriesTable reference;
+    reference.setColumnLabels({"/slider/position/value"});
+    reference.appendRow(0.0, SimTK::RowVector(1, 0.0));
+    reference.appendRow(1.0, SimTK::RowVector(1, 1.0));
+    const auto features = MocoTrajectoryLibrary::computeFeatures(
+            *model, reference, 0.0, 1.0);
+    CHECK(features.duration == Approx(1.0));
+    REQUIRE(features.reference_statistics.size() == 2);
+    CHECK(features.reference_statistics[0] == Approx(0.5));
+    CHECK(features.reference_statistics[1] == Approx(0.5));
+
+    {
+        MocoTrajectoryLibrary library(directory);
+        const int numEntries = library.getNumEntries();
+        library.add(traj, features);
+        CHECK(library.getNumEntries() == numEntries + 1);
+    }
+
+    // Reload the library from file.
+    MocoTrajectoryLibrary library(directory);
+    const int nearest = library.findNearest(features);
+    REQUIRE(nearest != -1);
+    CHECK(library.getFeatures(nearest).model_hash == features.model_hash);
+
+    // Map the stored trajectory onto a longer time range.
+    const auto guess = library.createGuess(features, 1.0, 3.0, 9);
+    CHECK(guess.getNumTimes() == 9);
+    CHECK(guess.getInitialTime() == Approx(1.0));
+    CHECK(guess.getFinalTime() == Approx(3.0));
+    const auto speed = guess.getState("/slider/position/speed");
+    for (int i = 0; i < speed.size(); ++i) {
+        CHECK(speed[i] == Approx(0.5));
+    }
+
+    // A model with a different structure is not compatible.
+    MocoTrajectoryLibrary::Features otherFeatures = features;
+    otherFeatures.model_hash = "0";
+    CHECK(library.findNearest(otherFeatures) == -1);
+    CHECK_THROWS_WITH(library.createGuess(otherFeatures, 0, 1),
+            ContainsSubstring("does not contain a trajectory"));
+
+
+    removeLibrary();
+}
+
 TEST_CASE("createPeriodicTrajectory") {
     const std::string hip_r = "hip_r/hip_flexion_r/value";
     const std::string hip_l = "hip_l/hip_flexion_l/value";
@@ -1827,6 +1940,24 @@ TEST_CASE("Sliding mass - MocoCasADiSolver") {
     testSlidingMass<MocoCasADiSolver>(transcription_scheme);
 }
 
+TEST_CASE("MocoTropterSolver parallel finite differences", "[tropter]") {
+    auto transcriptionScheme =
+            GENERATE(as<std::string>{}, "trapezoidal", "hermite-simpson");
+    auto study = createSlidingMassMocoStudy<MocoTropterSolver>(
+            transcriptionScheme);
+    auto& solver = study.updSolver<MocoTropterSolver>();
+    solver.set_optim_hessian_approximation("exact");
+    solver.set_parallel(0);
+    MocoSolution serial = study.solve();
+    solver.set_parallel(3);
+    MocoSolution parallel = study.solve();
+    // The derivatives do not depend on the number of threads, so the
+    // optimizer takes exactly the same steps.
+    CHECK(parallel.getNumIterations() == serial.getNumIterations());
+    CHECK(parallel.getObjective() == serial.getObjective());
+    CHECK(parallel.isNumericallyEqual(serial, 0));
+}
+
 TEMPLATE_TEST_CASE("Solving an empty MocoProblem", "",
         MocoCasADiSolver, MocoTropterSolver) {
     MocoStudy study;
@@ -259,3 +259,51 @@ TEMPLATE_TEST_CASE("See-saw center of mass", "",
 
     CHECK(sol_xCOM == Catch::Approx(xCOM).epsilon(0.003));
 }
+
+TEST_CASE("Parameters applied without initSystem") {
+    MocoProblem problem;
+    problem.setModel(createSeeSawModel());
+    problem.setTimeBounds(0, 1);
+    problem.addParameter("mass", "body", "mass", MocoBounds(0, 10));
+    problem.addParameter(
+            "com_location", "body", "mass_center", MocoBounds(-L, 0), 0);
+    MocoProblemRep rep = problem.createRep();
+    CHECK(rep.getParameter("mass").isAppliedWithoutInitSystem());
+    CHECK(rep.getParameter("mass").getChangesMassProperties());
+    CHECK(rep.getParameter("com_location").isAppliedWithoutInitSystem());
+
+    // Properties that are not handled specially still require initSystem().
+    auto model = createSeeSawModel();
+    model->finalizeFromProperties();
+    MocoParameter defaultValue("default_value", "/pin/rotation",
+            "default_value", MocoBounds(-1, 1));
+    defaultValue.initializeOnModel(*model);
+    CHECK_FALSE(defaultValue.isAppliedWithoutInitSystem());
+
+    // The accelerations must match those of a model built from scratch with
+    // the same properties.
+    for (const auto& values : std::vector<std::pair<double, double>>{
+                 {0.5 * MASS, 0.0}, {2 * MASS, 0.5 * xCOM}}) {
+        rep.applyParametersToModelProperties(
+                SimTK::Vector(SimTK::Vec2(values.first, values.second)), true);
+        const Model& modelBase = rep.getModelBase();
+        SimTK::State& state = rep.updStateBase();
+        state.updQ()[0] = 0.3;
+        state.updU()[0] = -0.1;
+        modelBase.realizeAcceleration(state);
+
+        auto expectedModel = createSeeSawModel();
+        auto& body = expectedModel->updComponent<Body>("/body");
+        body.setMass(values.first);
+        body.setMassCenter(SimTK::Vec3(values.second, 0, 0));
+        SimTK::State expectedState = expectedModel->initSystem();
+        expectedState.updQ()[0] = 0.3;
+        expectedState.updU()[0] = -0.1;
+        expectedModel->realizeAcceleration(expectedState);
+
+        CHECK(state.getUDot()[0] ==
+                Catch::Approx(expectedState.getUDot()[0]).margin(1e-10));
+        CHECK(modelBase.getTotalMass(state) ==
+                Catch::Approx(values.first).margin(1e-10));
+    }
+}
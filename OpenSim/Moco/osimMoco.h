@@ -58,6 +58,7 @@
 #include "MocoStudyFactory.h"
 #include "MocoTrack.h"
 #include "MocoTrajectory.h"
+#include "MocoTrajectoryLibrary.h"
 #include "MocoTropterSolver.h"
 #include "MocoUtilities.h"
 #include "MocoWeightSet.h"
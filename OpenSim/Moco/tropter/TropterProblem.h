@@ -46,10 +46,15 @@ inline tropter::FinalBounds convertBounds(const MocoFinalBounds& mb) {
 template <typename T>
 class MocoTropterSolver::TropterProblemBase : public tropter::Problem<T> {
 protected:
-    TropterProblemBase(const MocoTropterSolver& solver, bool implicit = false)
+    /// If probRep is provided, this problem uses (and owns) it instead of the
+    /// solver's MocoProblemRep; this is how concurrent copies are created.
+    TropterProblemBase(const MocoTropterSolver& solver, bool implicit = false,
+            std::unique_ptr<const MocoProblemRep> probRep = nullptr)
             : tropter::Problem<T>(solver.getProblemRep().getName()),
               m_mocoTropterSolver(solver),
-              m_mocoProbRep(solver.getProblemRep()),
+              m_ownedProbRep(std::move(probRep)),
+              m_mocoProbRep(m_ownedProbRep ? *m_ownedProbRep
+                                           : solver.getProblemRep()),
               m_modelBase(m_mocoProbRep.getModelBase()),
               m_stateBase(m_mocoProbRep.updStateBase()),
               m_modelDisabledConstraints(
@@ -78,10 +83,22 @@ protected:
         addKinematicConstraints();
         addGenericPathConstraints();
 
-        std::string formattedTimeString(getFormattedDateTime(true));
-        m_fileDeletionThrower = OpenSim::make_unique<FileDeletionThrower>(
-                fmt::format("delete_this_to_stop_optimization_{}_{}.txt",
-                        m_mocoProbRep.getName(), formattedTimeString));
+        // Concurrent copies share the file of the original problem.
+        if (!m_ownedProbRep) {
+            std::string formattedTimeString(getFormattedDateTime(true));
+            m_fileDeletionThrower = OpenSim::make_unique<FileDeletionThrower>(
+                    fmt::format("delete_this_to_stop_optimization_{}_{}.txt",
+                            m_mocoProbRep.getName(), formattedTimeString));
+        }
+    }
+
+    /// Each concurrent copy of this problem (see make_concurrent_copy())
+    /// evaluates its own MocoProblemRep, so that the copies do not share any
+    /// models or states.
+    std::unique_ptr<const MocoProblemRep> createConcurrentProblemRep() const {
+        auto probRep = m_mocoTropterSolver.createProblemRepJar(1)->take();
+        probRep->shareGoalReferenceValues(m_mocoProbRep);
+        return probRep;
     }
 
     void addStateVariables() {
@@ -270,9 +287,28 @@ protected:
         }
     }
 
+    void initialize_on_mesh(const Eigen::VectorXd& mesh) const override final {
+        // Concurrent copies share the reference values of the original problem
+        // (see createConcurrentProblemRep()).
+        if (m_ownedProbRep) return;
+        // With fixed initial and final times, the times of the mesh points are
+        // known before solving, and goals can evaluate their reference data
+        // at these times once.
+        const auto initialBounds = m_mocoProbRep.getTimeInitialBounds();
+        const auto finalBounds = m_mocoProbRep.getTimeFinalBounds();
+        if (!initialBounds.isEquality() || !finalBounds.isEquality()) return;
+        const double initialTime = initialBounds.getLower();
+        const double finalTime = finalBounds.getLower();
+        SimTK::Vector times((int)mesh.size());
+        for (int i = 0; i < times.size(); ++i) {
+            times[i] = (finalTime - initialTime) * mesh[i] + initialTime;
+        }
+        m_mocoProbRep.precomputeGoalReferenceValues(times);
+    }
+
     void initialize_on_iterate(
             const Eigen::VectorXd& parameters) const override final {
-        m_fileDeletionThrower->throwIfDeleted();
+        if (m_fileDeletionThrower) m_fileDeletionThrower->throwIfDeleted();
         // If they exist, apply parameter values to the model.
         this->applyParametersToModelProperties(parameters);
     }
@@ -409,6 +445,7 @@ protected:
     }
 
     const MocoTropterSolver& m_mocoTropterSolver;
+    std::unique_ptr<const MocoProblemRep> m_ownedProbRep;
     const MocoProblemRep& m_mocoProbRep;
     const Model& m_modelBase;
     SimTK::State& m_stateBase;
@@ -562,9 +599,15 @@ template <typename T>
 class MocoTropterSolver::ExplicitTropterProblem
         : public MocoTropterSolver::TropterProblemBase<T> {
 public:
-    ExplicitTropterProblem(const MocoTropterSolver& solver)
-            : MocoTropterSolver::TropterProblemBase<T>(solver) {}
-    void initialize_on_mesh(const Eigen::VectorXd&) const override {}
+    ExplicitTropterProblem(const MocoTropterSolver& solver,
+            std::unique_ptr<const MocoProblemRep> probRep = nullptr)
+            : MocoTropterSolver::TropterProblemBase<T>(
+                      solver, false, std::move(probRep)) {}
+    std::shared_ptr<const tropter::Problem<T>> make_concurrent_copy()
+            const override {
+        return std::make_shared<ExplicitTropterProblem<T>>(
+                this->m_mocoTropterSolver, this->createConcurrentProblemRep());
+    }
     void calc_differential_algebraic_equations(const tropter::Input<T>& in,
             tropter::Output<T> out) const override {
         // Unpack variables.
@@ -635,8 +678,9 @@ template <typename T>
 class MocoTropterSolver::ImplicitTropterProblem
         : public MocoTropterSolver::TropterProblemBase<T> {
 public:
-    ImplicitTropterProblem(const MocoTropterSolver& solver)
-            : TropterProblemBase<T>(solver, true) {
+    ImplicitTropterProblem(const MocoTropterSolver& solver,
+            std::unique_ptr<const MocoProblemRep> probRep = nullptr)
+            : TropterProblemBase<T>(solver, true, std::move(probRep)) {
         OPENSIM_THROW_IF(this->m_numKinematicConstraintEquations, Exception,
                 "Cannot use implicit dynamics mode with kinematic "
                 "constraints.");
@@ -661,6 +705,11 @@ public:
             this->add_path_constraint(name.substr(0, leafpos) + "residual", 0);
         }
     }
+    std::shared_ptr<const tropter::Problem<T>> make_concurrent_copy()
+            const override {
+        return std::make_shared<ImplicitTropterProblem<T>>(
+                this->m_mocoTropterSolver, this->createConcurrentProblemRep());
+    }
     void calc_differential_algebraic_equations(const tropter::Input<T>& in,
             tropter::Output<T> out) const override {
 
@@ -25,11 +25,61 @@
 #include "Model/Model.h"
 #include <OpenSim/Common/FunctionSet.h>
 
+#include <algorithm>
+#include <future>
+
 using namespace std;
 using namespace SimTK;
 
 namespace OpenSim {
 
+namespace {
+void checkCoordinateFunctions(const SimTK::State& s, const FunctionSet& Qs,
+        const std::vector<int>& coordinatesToSpeedsIndexMap) {
+    if (Qs.getSize() != s.getNQ()) {
+        throw Exception("InverseDynamicsSolver::solve invalid number of q functions.");
+    }
+    if ((int)coordinatesToSpeedsIndexMap.size() != s.getNU()) {
+        throw Exception("InverseDynamicsSolver::solve coordinatesToSpeedsIndexMap must be 'nu' long");
+    }
+}
+
+// Evaluate the coordinate functions and their first and second derivatives at
+// all times at once; GCVSplines are evaluated in a single pass over the
+// times instead of searching their knots for every time.
+std::vector<Matrix> evaluateCoordinateFunctions(
+        const FunctionSet& Qs, const Array_<double>& times) {
+    Vector timesVec((int)times.size());
+    for (int i = 0; i < (int)times.size(); ++i) {
+        timesVec[i] = times[i];
+    }
+    std::vector<Matrix> coordValues;
+    Qs.calcValues(timesVec, 2, coordValues);
+    return coordValues;
+}
+
+// Same as InverseDynamicsSolver::solve(s, Qs, coordinatesToSpeedsIndexMap,
+// time), but using coordinate function values from
+// evaluateCoordinateFunctions() at the time with index itime.
+Vector solveAtTimeIndex(InverseDynamicsSolver& solver, SimTK::State& s,
+        const std::vector<Matrix>& coordValues,
+        const std::vector<int>& coordinatesToSpeedsIndexMap, double time,
+        int itime) {
+    s.updTime() = time;
+    Vector& q = s.updQ();
+    Vector& u = s.updU();
+    Vector& udot = s.updUDot();
+    for (int i = 0; i < q.size(); ++i) {
+        q[i] = coordValues[0](itime, i);
+    }
+    for (int i = 0; i < u.size(); ++i) {
+        u[i] = coordValues[1](itime, coordinatesToSpeedsIndexMap[i]);
+        udot[i] = coordValues[2](itime, coordinatesToSpeedsIndexMap[i]);
+    }
+    return solver.solve(s, udot);
+}
+} // anonymous namespace
+
 //______________________________________________________________________________
 /**
  * An implementation of the InverseDynamicsSolver 
@@ -182,17 +232,99 @@ void InverseDynamicsSolver::solve(SimTK::State& s, const FunctionSet& Qs,
     int nCoords = getModel().getNumCoordinates();
     int nt = times.size();
 
+    checkCoordinateFunctions(s, Qs, coordinatesToSpeedsIndexMap);
+
     // Preallocate if not done already
     genForceTrajectory.resize(nt, Vector(nCoords));
 
+    const auto coordValues = evaluateCoordinateFunctions(Qs, times);
     AnalysisSet& analysisSet =
             const_cast<AnalysisSet&>(getModel().getAnalysisSet());
     // fill in results for each time
     for (int i = 0; i < nt; i++) {
-        genForceTrajectory[i] =
-                solve(s, Qs, coordinatesToSpeedsIndexMap, times[i]);
+        genForceTrajectory[i] = solveAtTimeIndex(*this, s, coordValues,
+                coordinatesToSpeedsIndexMap, times[i], i);
         analysisSet.step(s, i);
     }
 }
 
+void InverseDynamicsSolver::solve(SimTK::State& s, const FunctionSet& Qs,
+        const std::vector<int>& coordinatesToSpeedsIndexMap,
+        const Array_<double>& times, Array_<Vector>& genForceTrajectory,
+        int numThreads) {
+    OPENSIM_THROW_IF(numThreads < 1, Exception,
+            "Expected numThreads to be at least 1, but got {}.", numThreads);
+    const int nt = (int)times.size();
+    numThreads = std::min(numThreads, nt);
+
+    // Analyses must be stepped in order, so they require a sequential solve.
+    if (numThreads <= 1 || getModel().getAnalysisSet().getSize() > 0) {
+        solve(s, Qs, coordinatesToSpeedsIndexMap, times, genForceTrajectory);
+        return;
+    }
+
+    checkCoordinateFunctions(s, Qs, coordinatesToSpeedsIndexMap);
+    genForceTrajectory.resize(nt);
+
+    // Evaluate the coordinate functions once, up front. Functions used by the
+    // model's components (e.g., the data of an ExternalForce) are evaluated on
+    // all threads, and create their SimTK::Function on first use under a lock
+    // (see Function::getSimTKFunction()).
+    const auto coordValues = evaluateCoordinateFunctions(Qs, times);
+
+    // Each thread solves a contiguous block of time points using its own
+    // copy of the state, and writes to separate elements of the trajectory.
+    std::vector<SimTK::State> states(numThreads, s);
+    const int blockSize = nt / numThreads;
+    std::vector<std::future<void>> futures;
+    futures.reserve(numThreads);
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        const int begin = ithread * blockSize;
+        const int end = (ithread == numThreads - 1) ? nt : begin + blockSize;
+        futures.push_back(std::async(std::launch::async,
+                [&, ithread, begin, end]() {
+                    SimTK::State& threadState = states[ithread];
+                    for (int i = begin; i < end; ++i) {
+                        genForceTrajectory[i] = solveAtTimeIndex(*this,
+                                threadState, coordValues,
+                                coordinatesToSpeedsIndexMap, times[i], i);
+                    }
+                }));
+    }
+    for (auto& future : futures) { future.get(); }
+
+    // Leave the state at the last time point, as in the sequential solve.
+    s = states.back();
+}
+
+TimeSeriesTable InverseDynamicsSolver::solve(SimTK::State& s,
+        const FunctionSet& Qs,
+        const std::vector<int>& coordinatesToSpeedsIndexMap,
+        const std::vector<double>& times, int numThreads) {
+    const Array_<double> timesArray(times.begin(), times.end());
+    Array_<Vector> genForceTrajectory;
+    solve(s, Qs, coordinatesToSpeedsIndexMap, timesArray, genForceTrajectory,
+            numThreads);
+
+    // Generalized forces are in multibody tree order.
+    const auto coords = getModel().getCoordinatesInMultibodyTreeOrder();
+    const int nu = s.getNU();
+    OPENSIM_THROW_IF((int)coords.size() != nu, Exception,
+            "Expected the number of coordinates ({}) to match the number of "
+            "generalized speeds ({}).", coords.size(), nu);
+    std::vector<std::string> labels;
+    labels.reserve(nu);
+    for (const auto& coord : coords) {
+        labels.push_back(coord->getName() +
+                (coord->getMotionType() == Coordinate::Rotational ? "_moment"
+                                                                  : "_force"));
+    }
+
+    SimTK::Matrix genForces((int)times.size(), nu);
+    for (int i = 0; i < (int)times.size(); ++i) {
+        genForces.updRow(i) = ~genForceTrajectory[i];
+    }
+    return TimeSeriesTable(times, genForces, labels);
+}
+
 } // end of namespace OpenSim
\ No newline at end of file
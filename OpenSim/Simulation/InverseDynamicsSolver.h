@@ -25,6 +25,7 @@
 
 #include "Solver.h"
 #include "SimTKcommon/internal/State.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
 
 namespace OpenSim {
 
@@ -121,7 +122,30 @@ public:
             const std::vector<int> coordinatesToSpeedsIndexMap,
             const SimTK::Array_<double>& times,
             SimTK::Array_<SimTK::Vector>& genForceTrajectory);
+
+    /** Same as above, but the time points are divided into contiguous blocks
+        that are solved concurrently by `numThreads` threads, each using its
+        own copy of the provided SimTK::State. The generalized forces are
+        always in the same order as `times`, and upon return, `s` contains the
+        state at the last time point. If the model has any analyses, or
+        `numThreads` is 1, the time points are solved sequentially (so that
+        the analyses are stepped in order). Make sure any custom forces in the
+        model are threadsafe if you use more than one thread. */
+    void solve(SimTK::State& s, const FunctionSet& Qs,
+            const std::vector<int>& coordinatesToSpeedsIndexMap,
+            const SimTK::Array_<double>& times,
+            SimTK::Array_<SimTK::Vector>& genForceTrajectory,
+            int numThreads);
 #endif
+
+    /** Solve for the generalized forces at the provided times (see the
+        trajectory solve() above) and return them as a table. The column
+        labels are the names of the coordinates in multibody tree order, with
+        the suffix "_moment" for rotational coordinates and "_force"
+        otherwise, as in the output of the InverseDynamicsTool. */
+    TimeSeriesTable solve(SimTK::State& s, const FunctionSet& Qs,
+            const std::vector<int>& coordinatesToSpeedsIndexMap,
+            const std::vector<double>& times, int numThreads = 1);
 //=============================================================================
 };  // END of class InverseDynamicsSolver
 //=============================================================================
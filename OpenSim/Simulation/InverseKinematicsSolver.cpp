@@ -24,6 +24,7 @@
 #include "InverseKinematicsSolver.h"
 #include "Model/Model.h"
 #include "Model/MarkerSet.h"
+#include "SimbodyEngine/Constraint.h"
 
 #include "simbody/internal/AssemblyCondition_Markers.h"
 #include "simbody/internal/AssemblyCondition_OrientationSensors.h"
@@ -122,6 +123,8 @@ InverseKinematicsSolver::InverseKinematicsSolver(const Model& model,
     }
 }
 
+InverseKinematicsSolver::~InverseKinematicsSolver() = default;
+
 int InverseKinematicsSolver::getNumMarkersInUse() const
 {
     return _markerAssemblyCondition->getNumMarkers();
@@ -228,9 +231,12 @@ SimTK::Vec3 InverseKinematicsSolver::computeCurrentMarkerLocation(int markerInde
 /* Compute and return the spatial locations of all markers in ground. */
 void InverseKinematicsSolver::computeCurrentMarkerLocations(SimTK::Array_<SimTK::Vec3> &markerLocations)
 {
-    markerLocations.resize(_markerAssemblyCondition->getNumMarkers());
+    SimTK::Vector_<SimTK::Vec3> locations;
+    _markerStations.calcLocationsInGround(
+            getAssembler().getInternalState(), locations);
+    markerLocations.resize(locations.size());
     for(unsigned int i=0; i<markerLocations.size(); i++)
-        markerLocations[i] = _markerAssemblyCondition->findCurrentMarkerLocation(SimTK::Markers::MarkerIx(i));
+        markerLocations[i] = locations[i];
 }
 
 
@@ -372,6 +378,9 @@ std::string InverseKinematicsSolver::
     of the base assembly solver, that is going to do the assembly.  */
 void InverseKinematicsSolver::setupGoals(SimTK::State &s)
 {
+    // The structure of the sparse problem is analyzed again for the new goals.
+    _sparseTracking.reset();
+
     // Setup coordinates performed by the base class
     AssemblySolver::setupGoals(s);
 
@@ -419,6 +428,15 @@ void InverseKinematicsSolver::setupMarkersGoal(SimTK::State &s)
         }
     }
 
+    _markerStations = StationKinematics();
+    const SimbodyMatterSubsystem& matter = getModel().getMatterSubsystem();
+    for (Markers::MarkerIx mx(0);
+            mx < _markerAssemblyCondition->getNumMarkers(); ++mx) {
+        _markerStations.addStation(matter,
+                _markerAssemblyCondition->getMarkerBody(mx),
+                _markerAssemblyCondition->getMarkerStation(mx));
+    }
+
     // Add marker goal to the ik objective and transfer ownership of the 
     // goal (AssemblyCondition) to Assembler
     updAssembler().adoptAssemblyGoal(condOwner.release());
@@ -511,4 +529,428 @@ void InverseKinematicsSolver::updateGoals(SimTK::State &s)
     }
 }
 
+//______________________________________________________________________________
+/*
+ * Sparse tracking
+ *
+ * The tracking problem is a nonlinear least-squares problem in the free
+ * coordinates q (the free q's of the SimTK::Assembler). Each marker only
+ * depends on the coordinates of the mobilizers between its body and ground, so
+ * the Jacobian of a marker is computed only for those coordinates, from the
+ * columns of the mobilizers' hinge matrices. The normal equations J^T W J
+ * then only couple coordinates of which one is an ancestor of the other in the
+ * kinematic tree. Such a matrix can be factored as L^T D L without fill-in by
+ * eliminating the coordinates from the leaves of the tree to its root (see
+ * Featherstone, Rigid Body Dynamics Algorithms, 2008, section 6.5), so the
+ * factorization only visits the entries given by the ancestors of each
+ * coordinate. The ancestors are found once, when the problem is analyzed.
+ */
+struct InverseKinematicsSolver::SparseTracking {
+    // Whether the problem can be solved with the sparse solver.
+    bool isSupported = true;
+
+    // A free coordinate that is solved for. The variables are ordered by
+    // their q index, so every variable comes after its ancestors.
+    struct Variable {
+        SimTK::MobilizedBodyIndex body;
+        SimTK::MobilizerUIndex mobilizerU;
+        SimTK::QIndex q;
+        // The closest preceding variable that moves this variable's body
+        // (-1 if none).
+        int parent;
+    };
+    std::vector<Variable> variables;
+
+    // For each marker in the Markers goal, the last variable that moves the
+    // marker (-1 if none). Following the parents of this variable visits all
+    // variables that move the marker.
+    std::vector<int> markerVariables;
+
+    struct CoordinateGoal {
+        int variable;
+        // The index of the goal in getCoordinateReferences().
+        int reference;
+        double weight;
+    };
+    std::vector<CoordinateGoal> coordinateGoals;
+
+    // The ranges of the clamped coordinates.
+    struct Range {
+        int variable;
+        double min;
+        double max;
+    };
+    std::vector<Range> ranges;
+
+    // Working memory. Only the lower triangle of the normal equations is
+    // stored.
+    SimTK::Matrix normal;
+    SimTK::Matrix factor;
+    SimTK::Vector gradient;
+    SimTK::Vector step;
+    std::vector<SimTK::Vec3> columns;
+    std::vector<int> columnVariables;
+
+    int getNumVariables() const { return (int)variables.size(); }
+
+    // Factor the matrix (stored in the lower triangle of factor) in place into
+    // L^T D L, where L is unit lower triangular.
+    void factorize() {
+        for (int k = getNumVariables() - 1; k >= 0; --k) {
+            for (int i = variables[k].parent; i != -1;
+                    i = variables[i].parent) {
+                const double a = factor(k, i) / factor(k, k);
+                for (int j = i; j != -1; j = variables[j].parent) {
+                    factor(i, j) -= factor(k, j) * a;
+                }
+                factor(k, i) = a;
+            }
+        }
+    }
+
+    // Solve L^T D L x = b with the factors from factorize(); x overwrites b.
+    void solve(SimTK::Vector& b) const {
+        const int n = getNumVariables();
+        for (int k = n - 1; k >= 0; --k) {
+            for (int i = variables[k].parent; i != -1;
+                    i = variables[i].parent) {
+                b[i] -= factor(k, i) * b[k];
+            }
+        }
+        for (int k = 0; k < n; ++k) b[k] /= factor(k, k);
+        for (int k = 0; k < n; ++k) {
+            for (int i = variables[k].parent; i != -1;
+                    i = variables[i].parent) {
+                b[k] -= factor(k, i) * b[i];
+            }
+        }
+    }
+};
+
+void InverseKinematicsSolver::track(SimTK::State &s)
+{
+    if (!_useSparseTracking) {
+        AssemblySolver::track(s);
+        return;
+    }
+    OPENSIM_THROW_IF(!getAssembler().isInitialized(), Exception,
+            "InverseKinematicsSolver::track() failed: assemble() must be "
+            "called first.");
+    if (!_sparseTracking) setupSparseTracking(s);
+    if (!_sparseTracking->isSupported) {
+        AssemblySolver::track(s);
+        return;
+    }
+    updateGoals(s);
+    trackSparse(s);
+}
+
+void InverseKinematicsSolver::setupSparseTracking(const SimTK::State& s)
+{
+    _sparseTracking.reset(new SparseTracking());
+    SparseTracking& sparse = *_sparseTracking;
+    const Model& model = getModel();
+    const SimbodyMatterSubsystem& matter = model.getMatterSubsystem();
+    const SimTK::Assembler& assembler = getAssembler();
+
+    const auto unsupported = [&](const std::string& reason) {
+        log_warn("InverseKinematicsSolver: sparse tracking is not supported "
+                 "because {}. Using the SimTK::Assembler instead.", reason);
+        sparse.isSupported = false;
+    };
+    if (_orientationsReference && _orientationsReference->getNumRefs() > 0) {
+        unsupported("orientation sensors are tracked");
+        return;
+    }
+    for (const auto& constraint : model.getComponentList<Constraint>()) {
+        if (constraint.isEnforced(s)) {
+            unsupported(fmt::format(
+                    "constraint '{}' is enforced", constraint.getName()));
+            return;
+        }
+    }
+    for (const auto& coord : model.getComponentList<Coordinate>()) {
+        if (coord.isPrescribed(s)) {
+            unsupported(fmt::format(
+                    "coordinate '{}' is prescribed", coord.getName()));
+            return;
+        }
+    }
+    // The Jacobian is formed for the generalized speeds, so the coordinate
+    // derivatives must equal the speeds. This is checked at a random
+    // configuration, since the two can coincide at particular configurations
+    // (e.g., of a gimbal joint).
+    if (matter.getNQ(s) != matter.getNU(s)) {
+        unsupported("the model has more coordinates than speeds");
+        return;
+    }
+    {
+        SimTK::State sRandom = s;
+        Random::Uniform random(-1, 1);
+        for (int i = 0; i < sRandom.getNQ(); ++i) {
+            sRandom.updQ()[i] = random.getValue();
+        }
+        model.getMultibodySystem().realize(sRandom, Stage::Position);
+        Vector u(sRandom.getNU());
+        for (int i = 0; i < u.size(); ++i) u[i] = random.getValue();
+        Vector qdot;
+        matter.multiplyByN(sRandom, false, u, qdot);
+        if (max(abs(qdot - u)) > SimTK::SignificantReal) {
+            unsupported("the model has joints whose coordinate derivatives "
+                        "differ from their speeds (e.g., ball or gimbal "
+                        "joints)");
+            return;
+        }
+    }
+
+    // Find the variables and the last variable that moves each body.
+    std::vector<int> variableOfQ(s.getNQ(), -1);
+    std::vector<int> lastVariable(matter.getNumBodies(), -1);
+    for (MobilizedBodyIndex mbx(1); mbx < matter.getNumBodies(); ++mbx) {
+        const MobilizedBody& mobod = matter.getMobilizedBody(mbx);
+        int last = lastVariable[mobod.getParentMobilizedBody()
+                                        .getMobilizedBodyIndex()];
+        for (int iu = 0; iu < mobod.getNumU(s); ++iu) {
+            // Each q has the same index as its u.
+            const QIndex qx(mobod.getFirstQIndex(s) + iu);
+            if (!assembler.getFreeQIndexOfQ(qx).isValid()) continue;
+            sparse.variables.push_back({mbx, MobilizerUIndex(iu), qx, last});
+            last = sparse.getNumVariables() - 1;
+            variableOfQ[qx] = last;
+        }
+        lastVariable[mbx] = last;
+    }
+
+    if (!_markerAssemblyCondition.empty()) {
+        const SimTK::Markers& markers = *_markerAssemblyCondition;
+        for (Markers::MarkerIx mx(0); mx < markers.getNumMarkers(); ++mx) {
+            sparse.markerVariables.push_back(
+                    lastVariable[markers.getMarkerBody(mx)]);
+        }
+    }
+
+    const SimTK::Array_<CoordinateReference>& coordinateReferences =
+            getCoordinateReferences();
+    const CoordinateSet& coordSet = model.getCoordinateSet();
+    for (int i = 0; i < (int)coordinateReferences.size(); ++i) {
+        const Coordinate& coord =
+                coordSet.get(coordinateReferences[i].getName());
+        if (coord.get_is_free_to_satisfy_constraints()) continue;
+        const QIndex qx(matter.getMobilizedBody(coord.getBodyIndex())
+                                .getFirstQIndex(s) +
+                        coord.getMobilizerQIndex());
+        if (variableOfQ[qx] == -1) continue;
+        sparse.coordinateGoals.push_back({variableOfQ[qx], i,
+                coordinateReferences[i].getWeight(s)});
+    }
+    for (int i = 0; i < coordSet.getSize(); ++i) {
+        const Coordinate& coord = coordSet[i];
+        if (!coord.getClamped(s)) continue;
+        const QIndex qx(matter.getMobilizedBody(coord.getBodyIndex())
+                                .getFirstQIndex(s) +
+                        coord.getMobilizerQIndex());
+        if (variableOfQ[qx] == -1) continue;
+        sparse.ranges.push_back({variableOfQ[qx], coord.getRangeMin(),
+                coord.getRangeMax()});
+    }
+
+    const int n = sparse.getNumVariables();
+    sparse.normal.resize(n, n);
+    sparse.factor.resize(n, n);
+    sparse.gradient.resize(n);
+    sparse.step.resize(n);
+    log_debug("InverseKinematicsSolver: sparse tracking of {} markers and {} "
+              "coordinate goals with {} free coordinates.",
+            sparse.markerVariables.size(), sparse.coordinateGoals.size(), n);
+}
+
+void InverseKinematicsSolver::trackSparse(SimTK::State& s)
+{
+    SparseTracking& sparse = *_sparseTracking;
+    const MultibodySystem& system = getModel().getMultibodySystem();
+    const SimbodyMatterSubsystem& matter = getModel().getMatterSubsystem();
+    const int n = sparse.getNumVariables();
+
+    const SimTK::Array_<CoordinateReference>& coordinateReferences =
+            getCoordinateReferences();
+    std::vector<double> coordinateValues;
+    for (const auto& goal : sparse.coordinateGoals) {
+        coordinateValues.push_back(
+                coordinateReferences[goal.reference].getValue(s));
+    }
+
+    // Compute the objective of the SimTK::Assembler: the weighted mean of
+    // the squared marker errors plus the weighted squared coordinate errors.
+    // Optionally, also compute the gradient (divided by 2) and the
+    // Gauss-Newton approximation of the Hessian (divided by 2).
+    const auto calcObjective = [&](bool withDerivatives) {
+        system.realize(s, Stage::Position);
+        if (withDerivatives) {
+            sparse.normal.setToZero();
+            sparse.gradient.setToZero();
+        }
+        double markerObjective = 0;
+        double totalWeight = 0;
+        if (!_markerAssemblyCondition.empty()) {
+            const SimTK::Markers& markers = *_markerAssemblyCondition;
+            for (Markers::MarkerIx mx(0); mx < markers.getNumMarkers(); ++mx) {
+                const double weight = markers.getMarkerWeight(mx);
+                const Markers::ObservationIx ox =
+                        markers.getObservationIxForMarker(mx);
+                if (weight == 0 || !ox.isValid()) continue;
+                const Vec3& observation = markers.getObservation(ox);
+                if (!observation.isFinite()) continue;
+                const MobilizedBody& mobod =
+                        matter.getMobilizedBody(markers.getMarkerBody(mx));
+                const Vec3 location = mobod.findStationLocationInGround(
+                        s, markers.getMarkerStation(mx));
+                const Vec3 error = location - observation;
+                markerObjective += weight * error.normSqr();
+                totalWeight += weight;
+                if (!withDerivatives) continue;
+
+                // The velocity of the marker due to each variable that
+                // moves it, ordered from the leaves to the root.
+                sparse.columns.clear();
+                sparse.columnVariables.clear();
+                for (int v = sparse.markerVariables[mx]; v != -1;
+                        v = sparse.variables[v].parent) {
+                    const auto& variable = sparse.variables[v];
+                    const MobilizedBody& ancestor =
+                            matter.getMobilizedBody(variable.body);
+                    const SpatialVec H =
+                            ancestor.getHCol(s, variable.mobilizerU);
+                    sparse.columns.push_back(H[1] +
+                            H[0] % (location -
+                                           ancestor.getBodyOriginLocation(s)));
+                    sparse.columnVariables.push_back(v);
+                }
+                for (int a = 0; a < (int)sparse.columns.size(); ++a) {
+                    const int va = sparse.columnVariables[a];
+                    sparse.gradient[va] +=
+                            weight * dot(sparse.columns[a], error);
+                    for (int b = a; b < (int)sparse.columns.size(); ++b) {
+                        sparse.normal(va, sparse.columnVariables[b]) +=
+                                weight * dot(sparse.columns[a],
+                                                 sparse.columns[b]);
+                    }
+                }
+            }
+        }
+        if (totalWeight > 0) {
+            markerObjective /= totalWeight;
+            if (withDerivatives) {
+                sparse.normal /= totalWeight;
+                sparse.gradient /= totalWeight;
+            }
+        }
+        double coordinateObjective = 0;
+        for (int i = 0; i < (int)sparse.coordinateGoals.size(); ++i) {
+            const auto& goal = sparse.coordinateGoals[i];
+            const double error =
+                    s.getQ()[sparse.variables[goal.variable].q] -
+                    coordinateValues[i];
+            coordinateObjective += goal.weight * error * error;
+            if (withDerivatives) {
+                sparse.gradient[goal.variable] += goal.weight * error;
+                sparse.normal(goal.variable, goal.variable) += goal.weight;
+            }
+        }
+        return markerObjective + coordinateObjective;
+    };
+
+    // Levenberg-Marquardt iterations.
+    const double accuracy = getAccuracy();
+    const int maxIterations = 100;
+    double damping = 1e-3;
+    double objective = calcObjective(true);
+    const double initialObjective = objective;
+    Vector q;
+    int iter = 0;
+    for (; iter < maxIterations; ++iter) {
+        sparse.factor = sparse.normal;
+        for (int k = 0; k < n; ++k) {
+            sparse.factor(k, k) += damping * sparse.factor(k, k) +
+                                   SimTK::SignificantReal;
+        }
+        sparse.step = -sparse.gradient;
+        // A clamped coordinate that sits at a bound with the gradient pointing
+        // out of its range is held fixed: its row and column are removed from
+        // the normal equations, so the step of the other variables does not
+        // assume it moves.
+        for (const auto& range : sparse.ranges) {
+            const int v = range.variable;
+            const double value = s.getQ()[sparse.variables[v].q];
+            if (!(value <= range.min && sparse.gradient[v] > 0) &&
+                    !(value >= range.max && sparse.gradient[v] < 0)) {
+                continue;
+            }
+            for (int i = sparse.variables[v].parent; i != -1;
+                    i = sparse.variables[i].parent) {
+                sparse.factor(v, i) = 0;
+            }
+            for (int k = v + 1; k < n; ++k) {
+                for (int i = sparse.variables[k].parent; i != -1;
+                        i = sparse.variables[i].parent) {
+                    if (i == v) {
+                        sparse.factor(k, v) = 0;
+                        break;
+                    }
+                }
+            }
+            sparse.factor(v, v) = 1;
+            sparse.step[v] = 0;
+        }
+        sparse.factorize();
+        sparse.solve(sparse.step);
+
+        q = s.getQ();
+        for (int k = 0; k < n; ++k) {
+            s.updQ()[sparse.variables[k].q] += sparse.step[k];
+        }
+        for (const auto& range : sparse.ranges) {
+            double& value = s.updQ()[sparse.variables[range.variable].q];
+            value = SimTK::clamp(range.min, value, range.max);
+        }
+        const double trialObjective = calcObjective(false);
+        // Convergence is judged by the change in the coordinates after
+        // clamping, since the step of a clamped coordinate is not taken.
+        double change = 0;
+        for (int k = 0; k < n; ++k) {
+            const SimTK::QIndex qk = sparse.variables[k].q;
+            change = std::max(change, std::abs(s.getQ()[qk] - q[qk]));
+        }
+        const bool converged = change <= accuracy;
+        if (trialObjective <= objective) {
+            damping = std::max(0.1 * damping, 1e-12);
+            if (converged) {
+                objective = trialObjective;
+                break;
+            }
+            objective = calcObjective(true);
+        } else {
+            s.updQ() = q;
+            if (converged) break;
+            damping *= 10;
+        }
+    }
+    system.realize(s, Stage::Position);
+    if (iter == maxIterations) {
+        log_warn("InverseKinematicsSolver: sparse tracking did not converge "
+                 "in {} iterations at time {}.", maxIterations, s.getTime());
+    }
+    log_debug("Sparse tracking: t= {} (iterations={} initial cost={} "
+              "cost={})", s.getTime(), std::min(iter + 1, maxIterations),
+            initialObjective, objective);
+
+    // Keep the SimTK::Assembler (and therefore the reported marker locations
+    // and errors) consistent with the solution.
+    SimTK::Assembler& assembler = updAssembler();
+    Vector freeQs(assembler.getNumFreeQs());
+    for (Assembler::FreeQIndex fx(0); fx < freeQs.size(); ++fx) {
+        freeQs[fx] = s.getQ()[assembler.getQIndexOfFreeQ(fx)];
+    }
+    assembler.setInternalStateFromFreeQs(freeQs);
+}
+
 } // end of namespace OpenSim
@@ -26,6 +26,7 @@
 #include "AssemblySolver.h"
 #include "MarkersReference.h"
 #include "BufferedOrientationsReference.h"
+#include "Model/StationKinematics.h"
 
 namespace SimTK {
 class Markers;
@@ -74,7 +75,7 @@ public:
     //--------------------------------------------------------------------------
     // CONSTRUCTION
     //--------------------------------------------------------------------------
-    virtual ~InverseKinematicsSolver() {}
+    ~InverseKinematicsSolver() override;
     // No need for copy constructor or operator
     InverseKinematicsSolver(const InverseKinematicsSolver& other)            = delete;
     InverseKinematicsSolver& operator=(const InverseKinematicsSolver& other) = delete;
@@ -126,13 +127,38 @@ public:
         does not have to satisfy the constraints. */
     //virtual void assemble(SimTK::State &s);
 
-    /* Obtain a model configuration that meets the InverseKinematics conditions  
-        (desired values and constraints) given a state that satisfies or
-        is close to satisfying the constraints. Note there can be no change
-        in the number of constraints or desired coordinates. Desired
+    /** Obtain a model configuration that meets the InverseKinematics
+        conditions (desired values and constraints) given a state that
+        satisfies or is close to satisfying the constraints. Note there can be
+        no change in the number of constraints or desired coordinates. Desired
         coordinate values can and should be updated between repeated calls
-        to track a desired trajectory of coordinate values. */
-    //virtual void track(SimTK::State &s);
+        to track a desired trajectory of coordinate values.
+        If sparse tracking is enabled (see setUseSparseTracking()), the
+        configuration is found with the sparse solver instead of the
+        SimTK::Assembler. */
+    void track(SimTK::State &s) override;
+
+    /** Use a Levenberg-Marquardt solver that exploits the structure of the
+        kinematic tree in track(), instead of the SimTK::Assembler. Each
+        marker only depends on the coordinates of the joints between its body
+        and ground, so the solver assembles the Jacobian of each marker only
+        for those coordinates, and factors the normal equations without
+        fill-in, in time proportional to the number of marker-coordinate
+        dependencies rather than to the cube of the number of coordinates.
+        The structure is analyzed once, the first time track() is called
+        after assemble(). The solver minimizes the same objective as the
+        SimTK::Assembler; clamped coordinates are kept within their ranges by
+        projection.
+        Sparse tracking supports marker and coordinate goals for models whose
+        coordinate derivatives equal their generalized speeds (e.g., models
+        with only pin, slider, universal, and custom joints). If the problem
+        has orientation sensors, enforced constraints, prescribed coordinates,
+        or other joints, track() uses the SimTK::Assembler and logs a warning.
+        assemble() always uses the SimTK::Assembler. The default is false. */
+    void setUseSparseTracking(bool useSparseTracking) {
+        _useSparseTracking = useSparseTracking;
+    }
+    bool getUseSparseTracking() const { return _useSparseTracking; }
 
     /** Return the number of markers used to solve for model coordinates.
         It is a count of the number of markers in the intersection of 
@@ -259,6 +285,12 @@ private:
         assembly problem. */
     void setupOrientationsGoal(SimTK::State &s);
 
+    /** Analyze the structure of the tracking problem for the sparse solver.
+        This is done at the first call to track() after assemble(). */
+    void setupSparseTracking(const SimTK::State& s);
+    /** Track the goals with the sparse solver. */
+    void trackSparse(SimTK::State& s);
+
     // The marker reference values and weightings
     std::shared_ptr<MarkersReference> _markersReference;
 
@@ -269,6 +301,10 @@ private:
     // SimTK::Assembler and the memory is managed by the Assembler
     SimTK::ReferencePtr<SimTK::Markers> _markerAssemblyCondition;
 
+    // The model markers of the Markers goal, in the goal's order, to compute
+    // all of their locations at once.
+    StationKinematics _markerStations;
+
     // OrientationSensors collectively form a single assembly condition for
     // the SimTK::Assembler and the memory is managed by the Assembler
     SimTK::ReferencePtr<SimTK::OrientationSensors> _orientationAssemblyCondition;
@@ -277,6 +313,14 @@ private:
     // controlled by the driver porgram (typically based on pre-recorded data).
     bool _advanceTimeFromReference{false};
 
+    // Use the sparse solver, rather than the SimTK::Assembler, in track().
+    bool _useSparseTracking{false};
+
+    // The structure of the tracking problem, which is analyzed once for the
+    // sparse solver. Defined in the .cpp file.
+    struct SparseTracking;
+    std::unique_ptr<SparseTracking> _sparseTracking;
+
 //=============================================================================
 };  // END of class InverseKinematicsSolver
 //=============================================================================
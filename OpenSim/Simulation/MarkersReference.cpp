@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "MarkersReference.h"
+#include <OpenSim/Common/TRCFileAdapter.h>
 #include <SimTKcommon/internal/State.h>
 #include <cmath>
 
@@ -64,7 +65,15 @@ void MarkersReference::initializeFromMarkersFile(const std::string& markerFile,
                      "Supported file types are -- STO, TRC.");
 
     if(fileExt == "trc") {
-        _markerTable = TimeSeriesTableVec3{markerFile};
+        // Only parse the markers that are tracked, if specified.
+        TRCFileAdapter trcAdapter{};
+        std::vector<std::string> markerNames;
+        for (int i = 0; i < markerWeightSet.getSize(); ++i)
+            markerNames.push_back(markerWeightSet[i].getName());
+        trcAdapter.setMarkerNames(markerNames);
+        auto tables = trcAdapter.read(markerFile);
+        _markerTable = std::move(*std::static_pointer_cast<TimeSeriesTableVec3>(
+                tables.at(TRCFileAdapter::_markers)));
     } else {
         try {
             _markerTable = (TimeSeriesTable{markerFile}).pack<SimTK::Vec3>();
@@ -122,6 +122,18 @@ void Blankevoort1991Ligament::extendAddToSystem(
     this->_forceTotalCV = addCacheVariable("force_total", 0.0, SimTK::Stage::Velocity);
 }
 
+void Blankevoort1991Ligament::extendRealizeDynamics(
+        const SimTK::State& state) const {
+    Super::extendRealizeDynamics(state);
+
+    // If forces are evaluated in parallel, realize the cache entries of the
+    // frames on the path (shared with other forces) before computeForce().
+    if (shouldBeParallelized() && appliesForce(state)) {
+        getPath().getLength(state);
+        getPath().getLengtheningSpeed(state);
+    }
+}
+
 //=============================================================================
 // SCALING
 //=============================================================================
@@ -333,6 +333,10 @@ public:
         SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
         SimTK::Vector& generalizedForces) const override;
 
+    /** The path is realized in extendRealizeDynamics() when forces are
+    evaluated in parallel. */
+    bool supportsParallelEvaluation() const override { return true; }
+
     double computePotentialEnergy(
         const SimTK::State& state) const override;
 
@@ -353,6 +357,7 @@ protected:
 
     void extendFinalizeFromProperties() override;
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void extendRealizeDynamics(const SimTK::State& state) const override;
 
     double calcSpringForce(const SimTK::State& state) const;
     double calcDampingForce(const SimTK::State& state) const;
@@ -0,0 +1,231 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  CompiledExpressions.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//=============================================================================
+// INCLUDES
+//=============================================================================
+#include "CompiledExpressions.h"
+
+#include <OpenSim/Common/Exception.h>
+#include <lepton/Operation.h>
+#include <lepton/ParsedExpression.h>
+#include <lepton/Parser.h>
+
+#include <algorithm>
+#include <cctype>
+
+using namespace OpenSim;
+
+CompiledExpressions::CompiledExpressions(const CompiledExpressions& other) {
+    *this = other;
+}
+
+CompiledExpressions& CompiledExpressions::operator=(
+        const CompiledExpressions& other) {
+    if (this == &other) return *this;
+    _variableNames = other._variableNames;
+    _expressions = other._expressions;
+    _programs = other._programs;
+    _programIndices = other._programIndices;
+    {
+        std::lock_guard<std::mutex> lock(other._derivativesMutex);
+        _derivativesCompiled.store(
+                other._derivativesCompiled.load(std::memory_order_acquire),
+                std::memory_order_release);
+        _derivativePrograms = other._derivativePrograms;
+        _derivativeProgramIndices = other._derivativeProgramIndices;
+    }
+    bindSlots(_variableNames, _programs);
+    bindSlots(_variableNames, _derivativePrograms);
+    clearWorkspaces();
+    return *this;
+}
+
+CompiledExpressions::WorkspaceLease::WorkspaceLease(
+        const CompiledExpressions& owner) : _owner(owner) {
+    {
+        std::lock_guard<std::mutex> lock(_owner._workspacesMutex);
+        if (!_owner._workspaces.empty()) {
+            _workspace = std::move(_owner._workspaces.back());
+            _owner._workspaces.pop_back();
+            return;
+        }
+    }
+    // Copying the programs compiles nothing, but allocates memory; this
+    // happens once per thread that evaluates the expressions at the same time.
+    _workspace.reset(new Workspace());
+    _workspace->programs = _owner._programs;
+    bindSlots(_owner._variableNames, _workspace->programs);
+    _workspace->programValues.resize(_owner._programs.size());
+}
+
+CompiledExpressions::WorkspaceLease::~WorkspaceLease() {
+    std::lock_guard<std::mutex> lock(_owner._workspacesMutex);
+    _owner._workspaces.push_back(std::move(_workspace));
+}
+
+void CompiledExpressions::clearWorkspaces() {
+    std::lock_guard<std::mutex> lock(_workspacesMutex);
+    _workspaces.clear();
+}
+
+void CompiledExpressions::compile(const std::vector<std::string>& expressions,
+        const std::vector<std::string>& variableNames) {
+    _variableNames = variableNames;
+    _expressions.clear();
+    _programs.clear();
+    _programIndices.clear();
+    _derivativesCompiled = false;
+    _derivativePrograms.clear();
+    _derivativeProgramIndices.clear();
+    clearWorkspaces();
+
+    std::vector<Lepton::ParsedExpression> compiled;
+    for (std::string expression : expressions) {
+        expression.erase(std::remove_if(expression.begin(), expression.end(),
+                                 ::isspace),
+                expression.end());
+        _expressions.push_back(expression);
+        const auto parsed = Lepton::Parser::parse(expression).optimize();
+        _programIndices.push_back(
+                addProgram(parsed, expression, compiled, _programs));
+    }
+    bindSlots(_variableNames, _programs);
+}
+
+int CompiledExpressions::addProgram(const Lepton::ParsedExpression& parsed,
+        const std::string& description,
+        std::vector<Lepton::ParsedExpression>& compiled,
+        std::vector<Program>& programs) const {
+    for (int i = 0; i < (int)compiled.size(); ++i) {
+        if (compiled[i].getRootNode() == parsed.getRootNode()) return i;
+    }
+
+    Program program;
+    if (parsed.getRootNode().getOperation().getId() ==
+            Lepton::Operation::CONSTANT) {
+        program.isConstant = true;
+        program.constant = parsed.evaluate();
+    } else {
+        program.expression = parsed.createCompiledExpression();
+        for (const auto& name : program.expression.getVariables()) {
+            const auto it = std::find(
+                    _variableNames.begin(), _variableNames.end(), name);
+            OPENSIM_THROW_IF(it == _variableNames.end(), Exception,
+                    "Expression '{}' uses the unknown variable '{}'.",
+                    description, name);
+            program.variables.push_back(int(it - _variableNames.begin()));
+        }
+    }
+    compiled.push_back(parsed);
+    programs.push_back(std::move(program));
+    return (int)programs.size() - 1;
+}
+
+void CompiledExpressions::bindSlots(
+        const std::vector<std::string>& variableNames,
+        std::vector<Program>& programs) {
+    for (auto& program : programs) {
+        program.slots.clear();
+        for (int ivar : program.variables) {
+            program.slots.push_back(&program.expression.getVariableReference(
+                    variableNames[ivar]));
+        }
+    }
+}
+
+double CompiledExpressions::evaluateProgram(
+        Program& program, const double* variableValues) {
+    if (program.isConstant) return program.constant;
+    for (int i = 0; i < (int)program.slots.size(); ++i) {
+        *program.slots[i] = variableValues[program.variables[i]];
+    }
+    return program.expression.evaluate();
+}
+
+void CompiledExpressions::evaluate(
+        const double* variableValues, double* values) const {
+    WorkspaceLease workspace(*this);
+    auto& programs = workspace->programs;
+    // Programs that are shared by several expressions are evaluated once.
+    const int numPrograms = (int)programs.size();
+    const int numExpressions = getNumExpressions();
+    if (numPrograms == numExpressions) {
+        for (int i = 0; i < numExpressions; ++i) {
+            values[i] = evaluateProgram(
+                    programs[_programIndices[i]], variableValues);
+        }
+        return;
+    }
+    auto& programValues = workspace->programValues;
+    for (int i = 0; i < numPrograms; ++i) {
+        programValues[i] = evaluateProgram(programs[i], variableValues);
+    }
+    for (int i = 0; i < numExpressions; ++i) {
+        values[i] = programValues[_programIndices[i]];
+    }
+}
+
+void CompiledExpressions::compileDerivatives() const {
+    if (_derivativesCompiled.load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> lock(_derivativesMutex);
+    if (_derivativesCompiled.load(std::memory_order_relaxed)) return;
+    std::vector<Lepton::ParsedExpression> compiled;
+    _derivativePrograms.clear();
+    _derivativeProgramIndices.clear();
+    for (const auto& expression : _expressions) {
+        const auto parsed = Lepton::Parser::parse(expression);
+        for (const auto& variable : _variableNames) {
+            const auto derivative = parsed.differentiate(variable).optimize();
+            _derivativeProgramIndices.push_back(addProgram(derivative,
+                    "d(" + expression + ")/d" + variable, compiled,
+                    _derivativePrograms));
+        }
+    }
+    bindSlots(_variableNames, _derivativePrograms);
+    _derivativesCompiled.store(true, std::memory_order_release);
+}
+
+void CompiledExpressions::evaluateDerivatives(
+        const double* variableValues, double* derivatives) const {
+    compileDerivatives();
+    WorkspaceLease workspace(*this);
+    if (!workspace->hasDerivativePrograms) {
+        // The derivative programs are not modified once compiled.
+        workspace->derivativePrograms = _derivativePrograms;
+        bindSlots(_variableNames, workspace->derivativePrograms);
+        workspace->derivativeProgramValues.resize(_derivativePrograms.size());
+        workspace->hasDerivativePrograms = true;
+    }
+    auto& programs = workspace->derivativePrograms;
+    auto& programValues = workspace->derivativeProgramValues;
+    // Most derivatives of typical expressions are zero or repeated, so
+    // evaluate each distinct program once.
+    const int numPrograms = (int)programs.size();
+    for (int i = 0; i < numPrograms; ++i) {
+        programValues[i] = evaluateProgram(programs[i], variableValues);
+    }
+    for (int i = 0; i < (int)_derivativeProgramIndices.size(); ++i) {
+        derivatives[i] = programValues[_derivativeProgramIndices[i]];
+    }
+}
@@ -0,0 +1,160 @@
+#ifndef OPENSIM_COMPILED_EXPRESSIONS_H_
+#define OPENSIM_COMPILED_EXPRESSIONS_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  CompiledExpressions.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+// INCLUDE
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <lepton/CompiledExpression.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Lepton {
+class ParsedExpression;
+}
+
+namespace OpenSim {
+
+/**
+ * A group of Lepton expressions of the same variables, compiled once and then
+ * evaluated many times (e.g., by the expression-based forces).
+ *
+ * The variables of each expression are bound to their storage when the
+ * expressions are compiled, so evaluating the expressions neither looks up
+ * variables by name nor allocates memory. Expressions that are identical after
+ * simplification are compiled once, and constant expressions are not
+ * evaluated at all. The partial derivatives of the expressions with respect to
+ * the variables are derived symbolically, and are compiled the first time
+ * they are evaluated.
+ *
+ * A compiled expression holds the values of its variables, so each thread
+ * that evaluates the expressions uses its own copy of the compiled
+ * expressions, taken from a pool owned by this object. Evaluating the same
+ * object on multiple threads at once is therefore safe; compile() is not.
+ */
+class OSIMSIMULATION_API CompiledExpressions {
+public:
+    CompiledExpressions() = default;
+    CompiledExpressions(const CompiledExpressions& other);
+    CompiledExpressions& operator=(const CompiledExpressions& other);
+
+    /** Parse and compile the expressions. The expressions may only use the
+    variables in `variableNames`; otherwise, an exception is thrown. The order
+    of `variableNames` is the order of the values passed to evaluate(). */
+    void compile(const std::vector<std::string>& expressions,
+            const std::vector<std::string>& variableNames);
+
+    int getNumExpressions() const { return (int)_programIndices.size(); }
+    int getNumVariables() const { return (int)_variableNames.size(); }
+
+    /** Evaluate all expressions. `variableValues` has getNumVariables()
+    elements and `values` has getNumExpressions() elements. */
+    void evaluate(const double* variableValues, double* values) const;
+
+    /** Evaluate the partial derivative of each expression with respect to each
+    variable. `derivatives` has getNumExpressions() * getNumVariables()
+    elements; the derivatives of expression i are stored in elements
+    [i * getNumVariables(), (i + 1) * getNumVariables()). The derivatives
+    are compiled in the first call. */
+    void evaluateDerivatives(
+            const double* variableValues, double* derivatives) const;
+
+private:
+    // A compiled expression and the storage of the variables it uses.
+    struct Program {
+        bool isConstant = false;
+        double constant = 0;
+        Lepton::CompiledExpression expression;
+        // Indices (in _variableNames) of the variables the expression uses,
+        // and the corresponding storage within the compiled expression.
+        std::vector<int> variables;
+        std::vector<double*> slots;
+    };
+
+    // The programs that one thread evaluates, and the values of the programs.
+    // The derivative programs are copied the first time the workspace is used
+    // to evaluate the derivatives.
+    struct Workspace {
+        std::vector<Program> programs;
+        bool hasDerivativePrograms = false;
+        std::vector<Program> derivativePrograms;
+        std::vector<double> programValues;
+        std::vector<double> derivativeProgramValues;
+    };
+
+    // Take a workspace from the pool, creating one if the pool is empty, and
+    // return it to the pool when the evaluation is done.
+    class WorkspaceLease {
+    public:
+        explicit WorkspaceLease(const CompiledExpressions& owner);
+        ~WorkspaceLease();
+        Workspace& operator*() const { return *_workspace; }
+        Workspace* operator->() const { return _workspace.get(); }
+    private:
+        const CompiledExpressions& _owner;
+        std::unique_ptr<Workspace> _workspace;
+    };
+
+    // Add a program for the parsed expression to `programs`, unless an
+    // identical expression was already added; returns the program's index.
+    int addProgram(const Lepton::ParsedExpression& parsed,
+            const std::string& description,
+            std::vector<Lepton::ParsedExpression>& compiled,
+            std::vector<Program>& programs) const;
+    // The storage of a compiled expression moves when it is copied, so the
+    // slots must be bound again after copying.
+    static void bindSlots(const std::vector<std::string>& variableNames,
+            std::vector<Program>& programs);
+    static double evaluateProgram(
+            Program& program, const double* variableValues);
+    void clearWorkspaces();
+    // Compile the derivatives if they have not been compiled yet; safe to
+    // call on multiple threads at once.
+    void compileDerivatives() const;
+
+    std::vector<std::string> _variableNames;
+    std::vector<std::string> _expressions;
+    std::vector<Program> _programs;
+    // The program that computes each expression.
+    std::vector<int> _programIndices;
+
+    mutable std::atomic<bool> _derivativesCompiled{false};
+    mutable std::mutex _derivativesMutex;
+    mutable std::vector<Program> _derivativePrograms;
+    // The program that computes each derivative, ordered like the output of
+    // evaluateDerivatives().
+    mutable std::vector<int> _derivativeProgramIndices;
+
+    // Copies of the programs that are not in use by any thread. The programs
+    // above are never evaluated; they are copied into new workspaces.
+    mutable std::mutex _workspacesMutex;
+    mutable std::vector<std::unique_ptr<Workspace>> _workspaces;
+
+}; // class CompiledExpressions
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPILED_EXPRESSIONS_H_
@@ -24,10 +24,10 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
-#include <Lepton.h>
-
 #include "ExpressionBasedBushingForce.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace SimTK;
 using namespace OpenSim;
@@ -201,12 +201,7 @@ void ExpressionBasedBushingForce::extendFinalizeFromProperties()
     Super::extendFinalizeFromProperties(); // base class first
 
     // must initialize the 6 force functions using the user provided expressions
-    setMxExpression(get_Mx_expression());
-    setMyExpression(get_My_expression());
-    setMzExpression(get_Mz_expression());
-    setFxExpression(get_Fx_expression());
-    setFyExpression(get_Fy_expression());
-    setFzExpression(get_Fz_expression());
+    compileExpressions();
 
     // fill damping matrix with damping from vector property
     for (int i = 0; i<3; i++) {
@@ -215,60 +210,70 @@ void ExpressionBasedBushingForce::extendFinalizeFromProperties()
     }
 }
 
-/** Set the expression for the Mx function and create it's lepton program */
+/** Set the expression for the Mx function and compile the expressions */
 void ExpressionBasedBushingForce::setMxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mx_expression(expression);
-    MxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileExpressions();
 }
 
-/** Set the expression for the My function and create it's lepton program */
+/** Set the expression for the My function and compile the expressions */
 void ExpressionBasedBushingForce::setMyExpression(std::string expression) 
 {
     
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_My_expression(expression);
-    MyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileExpressions();
 }
 
-/** Set the expression for the Mz function and create it's lepton program */
+/** Set the expression for the Mz function and compile the expressions */
 void ExpressionBasedBushingForce::setMzExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mz_expression(expression);
-    MzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileExpressions();
 }
 
-/** Set the expression for the Fx function and create it's lepton program */
+/** Set the expression for the Fx function and compile the expressions */
 void ExpressionBasedBushingForce::setFxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fx_expression(expression);
-    FxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileExpressions();
 }
 
-/** Set the expression for the Fy function and create it's lepton program */
+/** Set the expression for the Fy function and compile the expressions */
 void ExpressionBasedBushingForce::setFyExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fy_expression(expression);
-    FyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileExpressions();
 }
 
-/** Set the expression for the Fz function and create it's lepton program */
+/** Set the expression for the Fz function and compile the expressions */
 void ExpressionBasedBushingForce::setFzExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fz_expression(expression);
-    FzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileExpressions();
 }
+
+void ExpressionBasedBushingForce::compileExpressions()
+{
+    // Identical expressions (e.g., the default "0.0") are compiled once.
+    _stiffnessExpressions.compile({get_Mx_expression(), get_My_expression(),
+            get_Mz_expression(), get_Fx_expression(), get_Fy_expression(),
+            get_Fz_expression()}, {"theta_x", "theta_y", "theta_z",
+            "delta_x", "delta_y", "delta_z"});
+}
+
 //=============================================================================
 // COMPUTATION
 //=============================================================================
@@ -280,25 +285,29 @@ SimTK::Vec6 ExpressionBasedBushingForce::
     // the deviation of the two frames measured by dq
     Vec6 dq = computeDeflection(s);
 
-    Vec6 fk = Vec6(0.0);
+    Vec6 fk;
+    _stiffnessExpressions.evaluate(&dq[0], &fk[0]);
 
-    std::map<std::string, double> deflectionVars;
-    deflectionVars["theta_x"] = dq[0];
-    deflectionVars["theta_y"] = dq[1];
-    deflectionVars["theta_z"] = dq[2];
-    deflectionVars["delta_x"] = dq[3];
-    deflectionVars["delta_y"] = dq[4];
-    deflectionVars["delta_z"] = dq[5];
+    return -fk;
+}
 
+/* Calculate the derivatives of the stiffness force w.r.t. the deflection. */
+SimTK::Mat66 ExpressionBasedBushingForce::
+    calcStiffnessMatrix(const SimTK::State& s) const
+{
+    Vec6 dq = computeDeflection(s);
 
-    fk[0] = MxProg.evaluate(deflectionVars);
-    fk[1] = MyProg.evaluate(deflectionVars);
-    fk[2] = MzProg.evaluate(deflectionVars);
-    fk[3] = FxProg.evaluate(deflectionVars);
-    fk[4] = FyProg.evaluate(deflectionVars);
-    fk[5] = FzProg.evaluate(deflectionVars);
+    // evaluateDerivatives() fills the derivatives row by row.
+    double dfk[36];
+    _stiffnessExpressions.evaluateDerivatives(&dq[0], dfk);
 
-    return -fk;
+    Mat66 K;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            K(i, j) = -dfk[6 * i + j];
+        }
+    }
+    return K;
 }
 
 /* Calculate the bushing force contribution due to its damping. */
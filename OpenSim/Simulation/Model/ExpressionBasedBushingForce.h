@@ -26,6 +26,7 @@
 
 // INCLUDE
 #include "Force.h"
+#include "CompiledExpressions.h"
 #include <OpenSim/Simulation/Model/TwoFrameLinker.h>
 
 namespace OpenSim {
@@ -222,6 +223,13 @@ public:
         on frame2 from frame1 in the basis of the deflection (dq). */
     SimTK::Vec6 calcStiffnessForce(const SimTK::State& state) const;
 
+    /** Calculate the partial derivatives of the stiffness force (see
+        calcStiffnessForce()) with respect to the deflection (dq); element
+        (i, j) is the derivative of force component i with respect to deflection
+        component j. The derivatives are obtained by differentiating the
+        expressions symbolically. */
+    SimTK::Mat66 calcStiffnessMatrix(const SimTK::State& state) const;
+
     /** Calculate the bushing force contribution due to its damping. This is a
         function of the deflection rate between the bushing frames. It is the 
         force on frame2 from frame1 in the basis of the deflection rate (dqdot).*/
@@ -269,11 +277,14 @@ private:
 
     void setNull();
     void constructProperties();
+    // compile the six expressions (Mx, My, Mz, Fx, Fy, Fz) together
+    void compileExpressions();
 
     SimTK::Mat66 _dampingMatrix{ 0.0 };
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    // compiled expressions of Mx, My, Mz, Fx, Fy, Fz (in that order) in terms
+    // of the deflections
+    CompiledExpressions _stiffnessExpressions;
 
 //==============================================================================
 };  // END of class ExpressionBasedBushingForce
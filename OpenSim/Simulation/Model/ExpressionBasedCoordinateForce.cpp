@@ -26,8 +26,6 @@
 //=============================================================================
 #include "ExpressionBasedCoordinateForce.h"
 #include <OpenSim/Simulation/Model/Model.h>
-#include <lepton/Parser.h>
-#include <lepton/ParsedExpression.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -83,21 +81,29 @@ void ExpressionBasedCoordinateForce::constructProperties()
 }
 
 //=============================================================================
-// Connect this force element to the rest of the model.
+// Compile the expression.
 //=============================================================================
-void ExpressionBasedCoordinateForce::extendConnectToModel(Model& aModel)
+void ExpressionBasedCoordinateForce::extendFinalizeFromProperties()
 {
-    Super::extendConnectToModel(aModel);
-
-    string errorMessage;
-    const string& coordName = get_coordinate();
+    Super::extendFinalizeFromProperties();
 
     string& expression = upd_expression();
     expression.erase(
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpression.compile({expression}, {"q", "qdot"});
+}
+
+//=============================================================================
+// Connect this force element to the rest of the model.
+//=============================================================================
+void ExpressionBasedCoordinateForce::extendConnectToModel(Model& aModel)
+{
+    Super::extendConnectToModel(aModel);
+
+    string errorMessage;
+    const string& coordName = get_coordinate();
 
     // Look up the coordinate
     if (!_model->updCoordinateSet().contains(coordName)) {
@@ -134,17 +140,22 @@ void ExpressionBasedCoordinateForce::computeForce(const SimTK::State& s,
 // Compute the force
 double ExpressionBasedCoordinateForce::calcExpressionForce(const SimTK::State& s ) const
 {
-    using namespace SimTK;
-    double q = _coord->getValue(s);
-    double qdot = _coord->getSpeedValue(s);
-    std::map<std::string, double> forceVars;
-    forceVars["q"] = q;
-    forceVars["qdot"] = qdot;
-    double forceMag = _forceProg.evaluate(forceVars);
+    const double forceVars[2] = {_coord->getValue(s), _coord->getSpeedValue(s)};
+    double forceMag;
+    _forceExpression.evaluate(forceVars, &forceMag);
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
     return forceMag;
 }
 
+SimTK::Vec2 ExpressionBasedCoordinateForce::calcForceMagnitudeDerivatives(
+        const SimTK::State& s) const
+{
+    const double forceVars[2] = {_coord->getValue(s), _coord->getSpeedValue(s)};
+    SimTK::Vec2 derivatives;
+    _forceExpression.evaluateDerivatives(forceVars, &derivatives[0]);
+    return derivatives;
+}
+
 // get the force magnitude that has already been computed
 const double& ExpressionBasedCoordinateForce::
     getForceMagnitude(const SimTK::State& s)
@@ -24,7 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
+#include "CompiledExpressions.h"
 
 namespace OpenSim {
 
@@ -100,6 +100,12 @@ public:
     /** Force calculation operator. **/
     double calcExpressionForce( const SimTK::State& s) const;
 
+    /** Compute the partial derivatives of the force magnitude with respect to
+    the coordinate value (element 0) and its time derivative (element 1). The
+    derivatives are obtained by differentiating the expression symbolically.
+    The model must have been connected (e.g., by Model::initSystem()). **/
+    SimTK::Vec2 calcForceMagnitudeDerivatives(const SimTK::State& s) const;
+
 //==============================================================================
 // Reporting
 //==============================================================================
@@ -118,6 +124,7 @@ protected:
 //==============================================================================
 // ModelComponent interface
 //==============================================================================
+    void extendFinalizeFromProperties() override;
     void extendConnectToModel(Model& model) override;
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 
@@ -126,8 +133,8 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression of the force magnitude in terms of q and qdot
+    CompiledExpressions _forceExpression;
 
     // Corresponding generalized coordinate to which the force
     // is applied.
@@ -26,8 +26,6 @@
 //=============================================================================
 #include "ExpressionBasedPointToPointForce.h"
 #include <OpenSim/Simulation/Model/Model.h>
-#include <lepton/Parser.h>
-#include <lepton/ParsedExpression.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -105,6 +103,21 @@ void ExpressionBasedPointToPointForce::constructProperties()
     constructProperty_expression( zero );
 }
 
+//=============================================================================
+// Compile the expression.
+//=============================================================================
+void ExpressionBasedPointToPointForce::extendFinalizeFromProperties()
+{
+    Super::extendFinalizeFromProperties();
+
+    string& expression = upd_expression();
+    expression.erase(
+            remove_if(expression.begin(), expression.end(), ::isspace), 
+                      expression.end() );
+    
+    _forceExpression.compile({expression}, {"d", "ddot"});
+}
+
 //=============================================================================
 // Connect this force element to the rest of the model.
 //=============================================================================
@@ -131,13 +144,6 @@ void ExpressionBasedPointToPointForce::extendConnectToModel(Model& model)
 
     if(getName() == "")
         setName("expressionP2PForce_"+body1Name+"To"+body2Name);
-
-    string& expression = upd_expression();
-    expression.erase(
-            remove_if(expression.begin(), expression.end(), ::isspace), 
-                      expression.end() );
-    
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
 }
 
 //=============================================================================
@@ -162,36 +168,46 @@ extendAddToSystem(SimTK::MultibodySystem& system) const
 //=============================================================================
 // Computing
 //=============================================================================
-// Compute and apply the force
-void ExpressionBasedPointToPointForce::computeForce(const SimTK::State& s, 
-                              SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
-                              SimTK::Vector& generalizedForces) const
+// Compute the kinematics of the points that determine the force
+void ExpressionBasedPointToPointForce::calcPointKinematics(
+        const SimTK::State& s, SimTK::Vec3& s1_G, SimTK::Vec3& s2_G,
+        SimTK::Vec3& r_G, double& d, double& ddot) const
 {
     using namespace SimTK;
 
     const Transform& X_GB1 = _b1->getBodyTransform(s);
     const Transform& X_GB2 = _b2->getBodyTransform(s);
 
-    const Vec3 s1_G = X_GB1.R() * getPoint1();
-    const Vec3 s2_G = X_GB2.R() * getPoint2();
+    s1_G = X_GB1.R() * getPoint1();
+    s2_G = X_GB2.R() * getPoint2();
 
     const Vec3 p1_G = X_GB1.p() + s1_G; // point measured from ground origin
     const Vec3 p2_G = X_GB2.p() + s2_G;
-    const Vec3 r_G = p2_G - p1_G; // vector from point1 to point2
-    const double d = r_G.norm();  // distance between the points
+    r_G = p2_G - p1_G; // vector from point1 to point2
+    d = r_G.norm();  // distance between the points
 
     const Vec3 v1_G = _b1->findStationVelocityInGround(s, getPoint1());
     const Vec3 v2_G = _b2->findStationVelocityInGround(s, getPoint2());
     const Vec3 vRel = v2_G - v1_G; // relative velocity
 
     //speed along the line connecting the two bodies
-    const double ddot = dot(vRel, r_G)/d;
+    ddot = dot(vRel, r_G)/d;
+}
+
+// Compute and apply the force
+void ExpressionBasedPointToPointForce::computeForce(const SimTK::State& s, 
+                              SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
+                              SimTK::Vector& generalizedForces) const
+{
+    using namespace SimTK;
 
-    std::map<std::string, double> forceVars;
-    forceVars["d"] = d;
-    forceVars["ddot"] = ddot;
+    Vec3 s1_G, s2_G, r_G;
+    double forceVars[2]; // d, ddot
+    calcPointKinematics(s, s1_G, s2_G, r_G, forceVars[0], forceVars[1]);
+    const double d = forceVars[0];
 
-    double forceMag = _forceProg.evaluate(forceVars);
+    double forceMag;
+    _forceExpression.evaluate(forceVars, &forceMag);
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
 
     const Vec3 f1_G = (forceMag/d) * r_G;
@@ -200,6 +216,18 @@ void ExpressionBasedPointToPointForce::computeForce(const SimTK::State& s,
     bodyForces[_b2->getMobilizedBodyIndex()] -=  SpatialVec(s2_G % f1_G, f1_G);
 }
 
+SimTK::Vec2 ExpressionBasedPointToPointForce::calcForceMagnitudeDerivatives(
+        const SimTK::State& s) const
+{
+    SimTK::Vec3 s1_G, s2_G, r_G;
+    double forceVars[2]; // d, ddot
+    calcPointKinematics(s, s1_G, s2_G, r_G, forceVars[0], forceVars[1]);
+
+    SimTK::Vec2 derivatives;
+    _forceExpression.evaluateDerivatives(forceVars, &derivatives[0]);
+    return derivatives;
+}
+
 // get the force magnitude that has already been computed
 const double& ExpressionBasedPointToPointForce::
     getForceMagnitude(const SimTK::State& s)
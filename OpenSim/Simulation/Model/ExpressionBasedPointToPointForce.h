@@ -24,7 +24,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
+#include "CompiledExpressions.h"
 
 namespace SimTK {
 class MobilizedBody;
@@ -144,6 +144,12 @@ public:
                               SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
                               SimTK::Vector& generalizedForces) const override;
 
+    /** Compute the partial derivatives of the force magnitude with respect to
+    the distance between the points, d (element 0), and its time derivative,
+    ddot (element 1). The derivatives are obtained by differentiating the
+    expression symbolically. The state must be realized to Velocity. */
+    SimTK::Vec2 calcForceMagnitudeDerivatives(const SimTK::State& s) const;
+
 
     //-----------------------------------------------------------------------------
     // Reporting
@@ -162,6 +168,7 @@ protected:
     //-----------------------------------------------------------------------------
     // ModelComponent interface
     //-----------------------------------------------------------------------------
+    void extendFinalizeFromProperties() override;
     void extendConnectToModel(Model& model) override;
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 
@@ -169,8 +176,14 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // Compute the points expressed in ground relative to their bodies
+    // (s1_G, s2_G), the vector from point1 to point2 (r_G), the distance
+    // between the points (d) and its time derivative (ddot).
+    void calcPointKinematics(const SimTK::State& s, SimTK::Vec3& s1_G,
+            SimTK::Vec3& s2_G, SimTK::Vec3& r_G, double& d, double& ddot) const;
+
+    // compiled expression of the force magnitude in terms of d and ddot
+    CompiledExpressions _forceExpression;
 
     // Temporary solution until implemented with Sockets
     SimTK::ReferencePtr<const PhysicalFrame> _body1;
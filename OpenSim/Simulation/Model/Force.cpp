@@ -155,6 +155,12 @@ void Force::setAppliesForce(SimTK::State& s, bool applyForce) const
     }
 }
 
+bool Force::shouldBeParallelized() const
+{
+    return supportsParallelEvaluation() && hasModel() &&
+           getModel().isParallelForceEvaluationEnabled();
+}
+
 bool Force::appliesForce(const SimTK::State& s) const
 {
     if(_index.isValid()){
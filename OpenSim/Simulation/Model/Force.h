@@ -72,11 +72,23 @@ public:
     * that set this flag to false will be put in series on a
     * thread that is running in parallel with other forces
     * that marked this flag as true.
+    *
+    * The default implementation returns true if this force supports parallel
+    * evaluation (see supportsParallelEvaluation()) and the model has enabled
+    * parallel force evaluation (see Model::setUseParallelForces()).
     */
-    virtual bool shouldBeParallelized() const
-    {
-        return false;
-    }
+    virtual bool shouldBeParallelized() const;
+
+    /**
+    * Return true if computeForce() and computePotentialEnergy() can be
+    * evaluated concurrently with other forces. While computing forces, such
+    * a force must only write to its own cache variables; if
+    * shouldBeParallelized() is true, any shared cache entries it depends on
+    * (e.g., the transforms of frames and the model's controls) must be
+    * realized beforehand (e.g., in extendRealizeDynamics(), which is invoked
+    * before the force subsystem computes forces). The default is false.
+    */
+    virtual bool supportsParallelEvaluation() const { return false; }
 
     /** Return if the Force is applied (or enabled) or not.                   */
     bool appliesForce(const SimTK::State& s) const;
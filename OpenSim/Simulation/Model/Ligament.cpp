@@ -96,6 +96,12 @@ void Ligament::extendFinalizeFromProperties()
 void Ligament::extendRealizeDynamics(const SimTK::State& state) const {
     Super::extendRealizeDynamics(state); // Mandatory first line
 
+    // If forces are evaluated in parallel, realize the cache entries of the
+    // frames on the path (shared with other forces) before computeForce().
+    if (shouldBeParallelized() && appliesForce(state)) {
+        getPath().getLength(state);
+    }
+
     if(appliesForce(state)){
         const SimTK::Vec3 color = computePathColor(state);
         if (!color.isNaN())
@@ -130,6 +130,9 @@ public:
     void computeForce(const SimTK::State& s, 
                       SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
                       SimTK::Vector& generalizedForces) const override;
+    /** The path is realized in extendRealizeDynamics() when forces are
+    evaluated in parallel. **/
+    bool supportsParallelEvaluation() const override { return true; }
 
     //--------------------------------------------------------------------------
     // SCALE
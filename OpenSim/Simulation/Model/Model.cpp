@@ -38,6 +38,7 @@
 #include "ForceSet.h"
 #include "Ligament.h"
 #include "MarkerSet.h"
+#include "MuscleBank.h"
 #include "ProbeSet.h"
 #include "SimTKcommon/internal/SystemGuts.h"
 
@@ -60,6 +61,7 @@
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -1105,6 +1107,32 @@ void Model::extendAddToSystem(SimTK::MultibodySystem& system) const
         Stage::Velocity, Stage::Acceleration);
 
     mutableThis->_modelControlsIndex = modelControls.getSubsystemMeasureIndex();
+
+    // Simbody queries Force::shouldBeParallelized() after all components
+    // have been added to the system, so decide here whether forces that
+    // support it are evaluated in parallel.
+    int numParallelizableForces = 0;
+    if (_useParallelForces) {
+        for (const auto& force : getComponentList<Force>()) {
+            if (force.get_appliesForce() &&
+                    force.supportsParallelEvaluation()) {
+                ++numParallelizableForces;
+            }
+        }
+    }
+    mutableThis->_parallelForceEvaluationEnabled = _useParallelForces &&
+            numParallelizableForces >= _parallelForcesThreshold;
+    if (_parallelForceEvaluationEnabled) {
+        log_debug("Model '{}': evaluating {} forces in parallel.", getName(),
+                numParallelizableForces);
+    }
+}
+
+void Model::setParallelForcesThreshold(int numForces) {
+    OPENSIM_THROW_IF_FRMOBJ(numForces < 0, Exception,
+            "Expected a non-negative number of forces, but got {}.",
+            numForces);
+    _parallelForcesThreshold = numForces;
 }
 
 
@@ -1280,9 +1308,32 @@ void Model::equilibrateMuscles(SimTK::State& state)
     bool failed = false;
     string errorMsg = "";
 
+    // Muscles in a MuscleBank are equilibrated together by the bank.
+    std::unordered_set<const Muscle*> bankedMuscles;
+    for (const auto& bank : getComponentList<MuscleBank>()) {
+        for (int i = 0; i < bank.getNumMuscles(); ++i) {
+            bankedMuscles.insert(&bank.getMuscle(i));
+        }
+        try {
+            const auto stats = bank.equilibrateMuscles(state);
+            log_debug("Model::equilibrateMuscles(): MuscleBank '{}' "
+                      "equilibrated {} of {} muscles in at most {} iterations "
+                      "({} Newton and {} bisection steps).",
+                    bank.getName(), stats.numConverged, stats.numProblems,
+                    stats.maxIterations, stats.numNewtonSteps,
+                    stats.numBisectionSteps);
+        } catch (const std::exception& e) {
+            if (!failed) {
+                errorMsg = e.what();
+                failed = true;
+            }
+        }
+    }
+
     auto muscles = getComponentList<Muscle>();
 
     for (auto& muscle : muscles) {
+        if (bankedMuscles.count(&muscle)) continue;
         if (muscle.appliesForce(state)){
             try{
                 muscle.computeEquilibrium(state);
@@ -342,6 +342,32 @@ public:
     take effect at the next call to initSystem() on this %Model. **/
     bool getUseVisualizer() const {return _useVisualizer;}
 
+    /** Request that Force%s that support it (e.g., Muscle%s and other
+    PathActuator%s, Ligament%s, and Blankevoort1991Ligament%s) be evaluated in
+    parallel by Simbody's force subsystem. Parallel evaluation is only used
+    if the model contains at least getParallelForcesThreshold() such forces,
+    since for smaller models the overhead of distributing the forces among
+    threads outweighs the benefit. This flag takes effect at the next call to
+    initSystem(). The default is serial evaluation; make sure any custom
+    Controller%s and Force%s that support parallel evaluation are threadsafe
+    before enabling it.
+    @see Force::shouldBeParallelized() **/
+    void setUseParallelForces(bool parallel) {_useParallelForces=parallel;}
+    /** Return the current setting of the "use parallel forces" flag. **/
+    bool getUseParallelForces() const {return _useParallelForces;}
+    /** %Set the minimum number of forces that support parallel evaluation
+    that the model must contain for them to be evaluated in parallel (see
+    setUseParallelForces()). The default is 32. **/
+    void setParallelForcesThreshold(int numForces);
+    /** @copydoc setParallelForcesThreshold() **/
+    int getParallelForcesThreshold() const {return _parallelForcesThreshold;}
+    /** Return true if Force%s that support parallel evaluation are evaluated
+    in parallel, based on the flags above and the forces in the model at the
+    most recent call to initSystem(). **/
+    bool isParallelForceEvaluationEnabled() const {
+        return _parallelForceEvaluationEnabled;
+    }
+
     /** Test whether a ModelVisualizer has been created for this Model. Even
     if visualization has been requested there will be no visualizer present
     until initSystem() has been successfully invoked. Use this method prior
@@ -461,7 +487,9 @@ public:
 
 
     /**
-     * Update the state of all Muscles so they are in equilibrium.
+     * Update the state of all Muscles so they are in equilibrium. Muscles
+     * that belong to a MuscleBank are equilibrated together by the bank
+     * (see MuscleBank::equilibrateMuscles()).
      */
     void equilibrateMuscles(SimTK::State& state);
 
@@ -1274,6 +1302,14 @@ private:
     // Global flag used to disable all Controllers.
     bool _allControllersEnabled;
 
+    // If this flag is set when initSystem() is called, forces that support
+    // parallel evaluation are evaluated in parallel, provided there are at
+    // least _parallelForcesThreshold of them.
+    bool _useParallelForces{false};
+    int _parallelForcesThreshold{32};
+    // Determined when the system is built.
+    bool _parallelForceEvaluationEnabled{false};
+
 
     //                      SIMBODY MULTIBODY SYSTEM
     // We dynamically allocate these because they are not available at
@@ -0,0 +1,57 @@
+#ifndef OPENSIM_MUSCLE_BANK_H_
+#define OPENSIM_MUSCLE_BANK_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  MuscleBank.h                            *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Simulation/Model/ModelComponent.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
+
+namespace OpenSim {
+
+/** A ModelComponent that evaluates a group of Muscle%s of the model together,
+rather than one muscle at a time. Model::equilibrateMuscles() asks each
+%MuscleBank in the model to equilibrate its muscles with a single call to
+equilibrateMuscles(), and only calls Muscle::computeEquilibrium() for the
+muscles that do not belong to a bank. */
+class OSIMSIMULATION_API MuscleBank : public ModelComponent {
+    OpenSim_DECLARE_ABSTRACT_OBJECT(MuscleBank, ModelComponent);
+
+public:
+    /// The number of muscles in this bank.
+    virtual int getNumMuscles() const = 0;
+    /// Get a muscle of this bank by index, in [0, getNumMuscles()).
+    virtual const Muscle& getMuscle(int index) const = 0;
+
+    /// Set the state of all muscles in this bank such that their fibers and
+    /// tendons are in equilibrium (see Muscle::computeEquilibrium()), and
+    /// return the iteration statistics of the solve.
+    /// @throws Exception if equilibrium could not be found for a muscle; the
+    ///     other muscles are equilibrated nonetheless.
+    virtual BatchRootSolveStatistics equilibrateMuscles(
+            SimTK::State& s) const = 0;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MUSCLE_BANK_H_
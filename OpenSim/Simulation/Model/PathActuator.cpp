@@ -204,6 +204,15 @@ void PathActuator::extendRealizeDynamics(const SimTK::State& state) const
 {
     Super::extendRealizeDynamics(state); // Mandatory first line
 
+    // If forces are evaluated in parallel, realize the cache entries that are
+    // shared with other forces (the model's controls, and the transforms and
+    // velocities of the frames on the path) before computeForce() is called.
+    if (shouldBeParallelized() && appliesForce(state)) {
+        getPath().getLength(state);
+        getPath().getLengtheningSpeed(state);
+        getControls(state);
+    }
+
     // if this force is disabled OR it is being overridden (not computing dynamics)
     // then don't compute the color of the path.
     if (appliesForce(state) && !isActuationOverridden(state)){
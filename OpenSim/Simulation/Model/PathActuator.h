@@ -139,6 +139,11 @@ public:
                                SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
                                SimTK::Vector& mobilityForces) const override;
 
+    /** PathActuator%s (including Muscle%s) only write to their own cache
+    variables in computeForce(); the path and the controls are realized in
+    extendRealizeDynamics() when forces are evaluated in parallel. **/
+    bool supportsParallelEvaluation() const override { return true; }
+
     //--------------------------------------------------------------------------
     // COMPUTATIONS
     //--------------------------------------------------------------------------
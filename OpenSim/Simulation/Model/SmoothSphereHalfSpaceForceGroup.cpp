@@ -0,0 +1,472 @@
+/* -------------------------------------------------------------------------- *
+ *               OpenSim: SmoothSphereHalfSpaceForceGroup.cpp                 *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SmoothSphereHalfSpaceForceGroup.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace OpenSim;
+
+//=============================================================================
+//  SMOOTH SPHERE HALF SPACE FORCE GROUP
+//=============================================================================
+// Uses default (compiler-generated) destructor, copy constructor, copy
+// assignment operator.
+
+SmoothSphereHalfSpaceForceGroup::SmoothSphereHalfSpaceForceGroup() {
+    constructProperties();
+}
+
+SmoothSphereHalfSpaceForceGroup::SmoothSphereHalfSpaceForceGroup(
+        const std::string& name, const ContactHalfSpace& contactHalfSpace) {
+    setName(name);
+    connectSocket_half_space(contactHalfSpace);
+
+    constructProperties();
+}
+
+void SmoothSphereHalfSpaceForceGroup::constructProperties() {
+    constructProperty_stiffness(1.0);
+    constructProperty_dissipation(0.0);
+    constructProperty_static_friction(0.0);
+    constructProperty_dynamic_friction(0.0);
+    constructProperty_viscous_friction(0.0);
+    constructProperty_transition_velocity(0.01);
+    constructProperty_constant_contact_force(1e-5);
+    constructProperty_hertz_smoothing(300.0);
+    constructProperty_hunt_crossley_smoothing(50.0);
+}
+
+void SmoothSphereHalfSpaceForceGroup::addContactSphere(
+        const ContactSphere& contactSphere) {
+    appendSocketConnectee_spheres(contactSphere);
+}
+
+int SmoothSphereHalfSpaceForceGroup::getNumContactSpheres() const {
+    return (int)getSocket<ContactSphere>("spheres").getNumConnectees();
+}
+
+void SmoothSphereHalfSpaceForceGroup::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+
+    const auto& spheres = getSocket<ContactSphere>("spheres");
+    const int numSpheres = (int)spheres.getNumConnectees();
+    _sphereGroups.clear();
+    _sphereBodies.resize(numSpheres);
+    _centers.resize(numSpheres);
+    _radii.resize(numSpheres);
+    for (int i = 0; i < numSpheres; ++i) {
+        const ContactSphere& sphere = spheres.getConnectee(i);
+        const SimTK::MobilizedBodyIndex body =
+                sphere.getFrame().getMobilizedBodyIndex();
+        _sphereBodies[i] = body;
+        _centers[i] = sphere.getFrame().findTransformInBaseFrame() *
+                      sphere.get_location();
+        _radii[i] = sphere.getRadius();
+
+        auto group = std::find_if(_sphereGroups.begin(), _sphereGroups.end(),
+                [&](const SphereGroup& g) { return g.body == body; });
+        if (group == _sphereGroups.end()) {
+            _sphereGroups.push_back({body, {}});
+            group = _sphereGroups.end() - 1;
+        }
+        group->indices.push_back(i);
+    }
+
+    const auto& halfSpace = getConnectee<ContactHalfSpace>("half_space");
+    _halfSpaceBody = halfSpace.getFrame().getMobilizedBodyIndex();
+    _halfSpaceFrame = halfSpace.getFrame().findTransformInBaseFrame() *
+                      halfSpace.getTransform();
+
+    this->_contactsCV = addCacheVariable(
+            "contacts", Contacts(), SimTK::Stage::Velocity);
+}
+
+//=============================================================================
+//  CONTACT MODEL
+//=============================================================================
+double SmoothSphereHalfSpaceForceGroup::calcFrictionCoefficient(
+        double slipSpeed, double* derivative) const {
+    const double us = get_static_friction();
+    const double ud = get_dynamic_friction();
+    const double uv = get_viscous_friction();
+    const double vt = get_transition_velocity();
+
+    const double vrel = slipSpeed / vt;
+    const double stribeck = ud + 2 * (us - ud) / (1 + vrel * vrel);
+    const double dStribeck_dvrel =
+            -4 * (us - ud) * vrel / SimTK::square(1 + vrel * vrel);
+    if (vrel < 1) {
+        if (derivative) {
+            *derivative = (stribeck + vrel * dStribeck_dvrel) / vt + uv;
+        }
+        return vrel * stribeck + uv * slipSpeed;
+    }
+    if (derivative) *derivative = dStribeck_dvrel / vt + uv;
+    return stribeck + uv * slipSpeed;
+}
+
+void SmoothSphereHalfSpaceForceGroup::calcContacts(
+        const SimTK::State& s, Contacts& contacts) const {
+    const auto& matter = getModel().getMatterSubsystem();
+    const int numSpheres = (int)_radii.size();
+    contacts.points.resize(numSpheres);
+    contacts.velocities.resize(numSpheres);
+    contacts.indentations.resize(numSpheres);
+    contacts.indentationVelocities.resize(numSpheres);
+    contacts.normalForces.resize(numSpheres);
+    contacts.forces.resize(numSpheres);
+
+    // The half space occupies x > 0 in its frame H, so its outward normal is
+    // the -x axis of H.
+    const SimTK::MobilizedBody& halfSpaceBody =
+            matter.getMobilizedBody(_halfSpaceBody);
+    const SimTK::Transform& X_GHB = halfSpaceBody.getBodyTransform(s);
+    const SimTK::SpatialVec& V_GHB = halfSpaceBody.getBodyVelocity(s);
+    const SimTK::Transform X_GH = X_GHB * _halfSpaceFrame;
+    const SimTK::Vec3 normal = X_GH.R() * SimTK::Vec3(-1, 0, 0);
+    contacts.normal = normal;
+
+    // Kinematics, fetching the transform and velocity of each body once.
+    for (const auto& group : _sphereGroups) {
+        const SimTK::MobilizedBody& body = matter.getMobilizedBody(group.body);
+        const SimTK::Transform& X_GB = body.getBodyTransform(s);
+        const SimTK::SpatialVec& V_GB = body.getBodyVelocity(s);
+        for (int i : group.indices) {
+            const double radius = _radii[i];
+            const SimTK::Vec3 center = X_GB * _centers[i];
+            const double indentation =
+                    radius - SimTK::dot(normal, center - X_GH.p());
+            // The contact point is halfway through the indentation.
+            const SimTK::Vec3 point =
+                    center - (radius - 0.5 * indentation) * normal;
+            const SimTK::Vec3 velocity =
+                    V_GB[1] + V_GB[0] % (point - X_GB.p()) -
+                    (V_GHB[1] + V_GHB[0] % (point - X_GHB.p()));
+            contacts.points[i] = point;
+            contacts.velocities[i] = velocity;
+            contacts.indentations[i] = indentation;
+            contacts.indentationVelocities[i] = -SimTK::dot(normal, velocity);
+        }
+    }
+
+    // Normal force: the smoothed Hertz force times the smoothed Hunt-Crossley
+    // damping.
+    const double k = 0.5 * std::pow(get_stiffness(), 2.0 / 3.0);
+    const double c = get_dissipation();
+    const double cf = get_constant_contact_force();
+    const double bd = get_hertz_smoothing();
+    const double bv = get_hunt_crossley_smoothing();
+    const double* x = contacts.indentations.data();
+    const double* xdot = contacts.indentationVelocities.data();
+    double* fn = contacts.normalForces.data();
+    for (int i = 0; i < numSpheres; ++i) {
+        const double hertz = (4.0 / 3.0) * k * std::sqrt(_radii[i] * k) *
+                             std::pow(x[i] * x[i] + cf, 0.75);
+        const double hertzSmoothing = 0.5 + 0.5 * std::tanh(bd * x[i]);
+        const double huntCrossleySmoothing =
+                0.5 + 0.5 * std::tanh(bv * (xdot[i] + 2.0 / (3.0 * c)));
+        fn[i] = hertz * hertzSmoothing * (1 + 1.5 * c * xdot[i]) *
+                huntCrossleySmoothing;
+    }
+
+    // Friction force, opposing the slip velocity.
+    for (int i = 0; i < numSpheres; ++i) {
+        const SimTK::Vec3 tangentialVelocity =
+                contacts.velocities[i] + xdot[i] * normal;
+        const double slipSpeed =
+                std::sqrt(tangentialVelocity.normSqr() + cf);
+        const double friction = fn[i] * calcFrictionCoefficient(slipSpeed);
+        contacts.forces[i] = fn[i] * normal -
+                             (friction / slipSpeed) * tangentialVelocity;
+    }
+}
+
+const SmoothSphereHalfSpaceForceGroup::Contacts&
+SmoothSphereHalfSpaceForceGroup::getContacts(const SimTK::State& s) const {
+    if (!isCacheVariableValid(s, _contactsCV)) {
+        calcContacts(s, updCacheVariableValue(s, _contactsCV));
+        markCacheVariableValid(s, _contactsCV);
+    }
+    return getCacheVariableValue(s, _contactsCV);
+}
+
+void SmoothSphereHalfSpaceForceGroup::computeForce(const SimTK::State& s,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& generalizedForces) const {
+    const Contacts& contacts = getContacts(s);
+
+    const auto& matter = getModel().getMatterSubsystem();
+    const SimTK::Vec3& p_GHB =
+            matter.getMobilizedBody(_halfSpaceBody).getBodyOriginLocation(s);
+    for (const auto& group : _sphereGroups) {
+        const SimTK::Vec3& p_GB =
+                matter.getMobilizedBody(group.body).getBodyOriginLocation(s);
+        for (int i : group.indices) {
+            const SimTK::Vec3& point = contacts.points[i];
+            const SimTK::Vec3& force = contacts.forces[i];
+            bodyForces[group.body] +=
+                    SimTK::SpatialVec((point - p_GB) % force, force);
+            bodyForces[_halfSpaceBody] -=
+                    SimTK::SpatialVec((point - p_GHB) % force, force);
+        }
+    }
+}
+
+void SmoothSphereHalfSpaceForceGroup::calcContactForces(
+        const SimTK::State& s, SimTK::Vector_<SimTK::Vec3>& forces) const {
+    const Contacts& contacts = getContacts(s);
+    forces.resize((int)contacts.forces.size());
+    for (int i = 0; i < (int)contacts.forces.size(); ++i) {
+        forces[i] = contacts.forces[i];
+    }
+}
+
+SimTK::SpatialVec SmoothSphereHalfSpaceForceGroup::getSphereForce(
+        const SimTK::State& s, int index) const {
+    OPENSIM_THROW_IF_FRMOBJ(index < 0 || index >= (int)_radii.size(),
+            Exception, "Expected the sphere index to be in [0, {}), but got {}.",
+            _radii.size(), index);
+    const Contacts& contacts = getContacts(s);
+    const SimTK::Vec3& p_GB = getModel().getMatterSubsystem()
+            .getMobilizedBody(_sphereBodies[index]).getBodyOriginLocation(s);
+    const SimTK::Vec3& force = contacts.forces[index];
+    return {(contacts.points[index] - p_GB) % force, force};
+}
+
+void SmoothSphereHalfSpaceForceGroup::calcContactForceJacobians(
+        const SimTK::State& s, SimTK::Matrix& dFdq,
+        SimTK::Matrix& dFdu) const {
+    OPENSIM_THROW_IF_FRMOBJ(_halfSpaceBody != SimTK::GroundIndex, Exception,
+            "Expected the half space to be attached to Ground.");
+    const Contacts& contacts = getContacts(s);
+
+    const auto& matter = getModel().getMatterSubsystem();
+    const int numSpheres = (int)_radii.size();
+    const int nq = s.getNQ();
+    const int nu = s.getNU();
+    dFdq.resize(3 * numSpheres, nq);
+    dFdu.resize(3 * numSpheres, nu);
+
+    const double k = 0.5 * std::pow(get_stiffness(), 2.0 / 3.0);
+    const double c = get_dissipation();
+    const double cf = get_constant_contact_force();
+    const double bd = get_hertz_smoothing();
+    const double bv = get_hunt_crossley_smoothing();
+    const SimTK::Vec3& normal = contacts.normal;
+    const SimTK::Mat33 tangentProjection =
+            SimTK::Mat33(1) - normal * ~normal;
+
+    // Spatial velocities are shifted to the ground origin (Pluecker
+    // coordinates). Moving mobility j of an ancestor A of a body B moves the
+    // bodies from A to B rigidly, which changes the velocity of B by
+    // H_j x (V_B - V_A) (Featherstone, Rigid Body Dynamics Algorithms, 2008,
+    // section 2.9). The hinge matrix of A's mobilizer is taken to be constant
+    // in the mobilizer's inboard frame, so the motion also changes the
+    // velocity of A relative to its parent through the origin of the
+    // mobilizer's outboard frame M only, about which A rotates.
+    const auto atOrigin = [](const SimTK::SpatialVec& V,
+                                  const SimTK::Vec3& origin) {
+        return SimTK::SpatialVec(V[0], V[1] - V[0] % origin);
+    };
+    const auto crossMotion = [](const SimTK::SpatialVec& a,
+                                     const SimTK::SpatialVec& b) {
+        return SimTK::SpatialVec(a[0] % b[0], a[0] % b[1] + a[1] % b[0]);
+    };
+    SimTK::Vector_<SimTK::Vec3> dvdu(nu);
+    SimTK::Vector_<SimTK::Vec3> dvdq(nq);
+    SimTK::Vector dvduComponent(nu);
+    SimTK::Vector dvdqComponent(nq);
+    SimTK::Vector dxdu(nu);
+    SimTK::Vector dxdq(nq);
+    SimTK::Matrix JS;
+    for (int i = 0; i < numSpheres; ++i) {
+        const double x = contacts.indentations[i];
+        const double xdot = contacts.indentationVelocities[i];
+        const double fn = contacts.normalForces[i];
+
+        // Derivatives of the normal force with respect to the indentation
+        // and its rate.
+        const double stiffness = (4.0 / 3.0) * k * std::sqrt(_radii[i] * k);
+        const double hertz = stiffness * std::pow(x * x + cf, 0.75);
+        const double dHertz = stiffness * 1.5 * x * std::pow(x * x + cf, -0.25);
+        const double tanhD = std::tanh(bd * x);
+        const double hertzSmoothing = 0.5 + 0.5 * tanhD;
+        const double dHertzSmoothing = 0.5 * bd * (1 - tanhD * tanhD);
+        const double tanhV = std::tanh(bv * (xdot + 2.0 / (3.0 * c)));
+        const double huntCrossleySmoothing = 0.5 + 0.5 * tanhV;
+        const double dHuntCrossleySmoothing = 0.5 * bv * (1 - tanhV * tanhV);
+        const double damping = 1 + 1.5 * c * xdot;
+        const double dfn_dx = (dHertz * hertzSmoothing +
+                                      hertz * dHertzSmoothing) *
+                              damping * huntCrossleySmoothing;
+        const double dfn_dxdot = hertz * hertzSmoothing *
+                                 (1.5 * c * huntCrossleySmoothing +
+                                         damping * dHuntCrossleySmoothing);
+
+        // F = fn * (normal - g * vt), with g = mu(vslip) / vslip.
+        const SimTK::Vec3 vt = tangentProjection * contacts.velocities[i];
+        const double vslip = std::sqrt(vt.normSqr() + cf);
+        double dmu;
+        const double mu = calcFrictionCoefficient(vslip, &dmu);
+        const double g = mu / vslip;
+        const double dg = (dmu * vslip - mu) / (vslip * vslip);
+        const SimTK::Vec3 direction = normal - g * vt;
+
+        const SimTK::Vec3 dF_dx = dfn_dx * direction;
+        // xdot = -normal . v, and d(vslip)/dv = vt / vslip.
+        const SimTK::Mat33 dF_dv = -dfn_dxdot * direction * ~normal -
+                                   fn * ((dg / vslip) * vt * ~vt +
+                                           g * tangentProjection);
+
+        const SimTK::MobilizedBodyIndex body = _sphereBodies[i];
+        const SimTK::Transform& X_GB =
+                matter.getMobilizedBody(body).getBodyTransform(s);
+
+        // The indentation changes with q only through the sphere's center:
+        // dx/dq = -normal^T J_center N^-1.
+        matter.multiplyByStationJacobianTranspose(
+                s, body, _centers[i], -normal, dxdu);
+        matter.multiplyByNInv(s, true, dxdu, dxdq);
+
+        // The contact-point velocity is v = v_c - (r - x/2) w x normal, where
+        // v_c is the velocity of the sphere's center and w is the angular
+        // velocity of its body. Holding u fixed, it changes with q through
+        // the body velocity, the center, and the indentation.
+        const SimTK::MobilizedBody& mobod = matter.getMobilizedBody(body);
+        const SimTK::SpatialVec V_B =
+                atOrigin(mobod.getBodyVelocity(s), X_GB.p());
+        const SimTK::Vec3 center = X_GB * _centers[i];
+        const double lever = _radii[i] - 0.5 * x;
+        dvdu.setToZero();
+        for (const SimTK::MobilizedBody* ancestor = &mobod;
+                ancestor->getMobilizedBodyIndex() != SimTK::GroundIndex;
+                ancestor = &ancestor->getParentMobilizedBody()) {
+            const SimTK::MobilizedBody& parent =
+                    ancestor->getParentMobilizedBody();
+            const SimTK::Vec3& origin = ancestor->getBodyOriginLocation(s);
+            const SimTK::SpatialVec V_A =
+                    atOrigin(ancestor->getBodyVelocity(s), origin);
+            const SimTK::Vec3 outboardOrigin =
+                    ancestor->getBodyTransform(s) *
+                    ancestor->getOutboardFrame(s).p();
+            const SimTK::Vec3 w_PA =
+                    V_A[0] - parent.getBodyAngularVelocity(s);
+            const SimTK::UIndex firstU = ancestor->getFirstUIndex(s);
+            for (int k = 0; k < ancestor->getNumU(s); ++k) {
+                const SimTK::SpatialVec H = atOrigin(
+                        ancestor->getHCol(s, SimTK::MobilizerUIndex(k)),
+                        origin);
+                SimTK::SpatialVec dV = crossMotion(H, V_B - V_A);
+                dV[1] += (H[1] + H[0] % outboardOrigin) % w_PA;
+                const SimTK::Vec3 dcenter = H[1] + H[0] % center;
+                const double dx = -SimTK::dot(normal, dcenter);
+                dvdu[firstU + k] = dV[1] + dV[0] % center +
+                                   V_B[0] % dcenter +
+                                   0.5 * dx * (V_B[0] % normal) -
+                                   lever * (dV[0] % normal);
+            }
+        }
+        for (int r = 0; r < 3; ++r) {
+            for (int j = 0; j < nu; ++j) dvduComponent[j] = dvdu[j][r];
+            matter.multiplyByNInv(s, true, dvduComponent, dvdqComponent);
+            for (int j = 0; j < nq; ++j) dvdq[j][r] = dvdqComponent[j];
+        }
+
+        for (int j = 0; j < nq; ++j) {
+            const SimTK::Vec3 dF = dF_dx * dxdq[j] + dF_dv * dvdq[j];
+            for (int r = 0; r < 3; ++r) dFdq(3 * i + r, j) = dF[r];
+        }
+
+        // The velocity of the contact point is v = J_point u.
+        matter.calcStationJacobian(
+                s, body, ~X_GB * contacts.points[i], JS);
+        for (int j = 0; j < nu; ++j) {
+            const SimTK::Vec3 dF =
+                    dF_dv * SimTK::Vec3(JS(0, j), JS(1, j), JS(2, j));
+            for (int r = 0; r < 3; ++r) dFdu(3 * i + r, j) = dF[r];
+        }
+    }
+}
+
+//=============================================================================
+//  REPORTING
+//=============================================================================
+OpenSim::Array<std::string>
+SmoothSphereHalfSpaceForceGroup::getRecordLabels() const {
+    OpenSim::Array<std::string> labels("");
+
+    const auto& spheres = getSocket<ContactSphere>("spheres");
+    for (unsigned i = 0; i < spheres.getNumConnectees(); ++i) {
+        const std::string prefix =
+                getName() + "." + spheres.getConnectee(i).getName();
+        labels.append(prefix + ".force.X");
+        labels.append(prefix + ".force.Y");
+        labels.append(prefix + ".force.Z");
+        labels.append(prefix + ".torque.X");
+        labels.append(prefix + ".torque.Y");
+        labels.append(prefix + ".torque.Z");
+    }
+
+    labels.append(getName() + ".HalfSpace" + ".force.X");
+    labels.append(getName() + ".HalfSpace" + ".force.Y");
+    labels.append(getName() + ".HalfSpace" + ".force.Z");
+    labels.append(getName() + ".HalfSpace" + ".torque.X");
+    labels.append(getName() + ".HalfSpace" + ".torque.Y");
+    labels.append(getName() + ".HalfSpace" + ".torque.Z");
+
+    return labels;
+}
+
+OpenSim::Array<double> SmoothSphereHalfSpaceForceGroup::getRecordValues(
+        const SimTK::State& state) const {
+    OpenSim::Array<double> values(1);
+
+    const Contacts& contacts = getContacts(state);
+
+    const auto& matter = getModel().getMatterSubsystem();
+    const SimTK::Vec3& p_GHB = matter.getMobilizedBody(_halfSpaceBody)
+                                       .getBodyOriginLocation(state);
+    SimTK::Vec3 halfSpaceForce(0);
+    SimTK::Vec3 halfSpaceTorque(0);
+    for (int i = 0; i < (int)_radii.size(); ++i) {
+        const SimTK::Vec3& p_GB = matter.getMobilizedBody(_sphereBodies[i])
+                                          .getBodyOriginLocation(state);
+        const SimTK::Vec3& point = contacts.points[i];
+        SimTK::Vec3 force = contacts.forces[i];
+        SimTK::Vec3 torque = (point - p_GB) % force;
+        values.append(3, &force[0]);
+        values.append(3, &torque[0]);
+
+        halfSpaceForce -= force;
+        halfSpaceTorque -= (point - p_GHB) % force;
+    }
+    values.append(3, &halfSpaceForce[0]);
+    values.append(3, &halfSpaceTorque[0]);
+
+    return values;
+}
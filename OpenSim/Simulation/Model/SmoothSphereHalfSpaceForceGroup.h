@@ -0,0 +1,214 @@
+#ifndef OPENSIM_SMOOTH_SPHERE_HALF_SPACE_FORCE_GROUP_H_
+#define OPENSIM_SMOOTH_SPHERE_HALF_SPACE_FORCE_GROUP_H_
+/* -------------------------------------------------------------------------- *
+ *                OpenSim: SmoothSphereHalfSpaceForceGroup.h                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Force.h"
+#include "ContactHalfSpace.h"
+#include "ContactSphere.h"
+
+namespace OpenSim {
+
+/** The contact forces between several spheres and one half space, each
+computed with the same smooth Hunt-Crossley model as
+SmoothSphereHalfSpaceForce. A group produces the same forces as one
+SmoothSphereHalfSpaceForce per sphere with the same properties, but evaluates
+all of the spheres together: the kinematics of each body is fetched once for
+all spheres attached to it, and the contact model is evaluated in simple loops
+over contiguous arrays of all spheres, which the compiler can vectorize. This
+is useful for foot-ground contact in gait models, which have many spheres per
+foot that share the same contact parameters.
+
+This force connects to the spheres via the list Socket 'spheres', and to the
+half space via the Socket 'half_space'.
+
+In addition to the forces, this component provides the Jacobians of the
+contact forces with respect to the generalized coordinates and speeds (see
+calcContactForceJacobians()), which are useful for gradient-based
+optimization and implicit integration.
+
+@see SmoothSphereHalfSpaceForce */
+class OSIMSIMULATION_API SmoothSphereHalfSpaceForceGroup : public Force {
+    OpenSim_DECLARE_CONCRETE_OBJECT(SmoothSphereHalfSpaceForceGroup, Force);
+
+public:
+    //=========================================================================
+    // PROPERTIES
+    //=========================================================================
+    OpenSim_DECLARE_PROPERTY(stiffness, double,
+            "The stiffness constant (i.e., plain strain modulus), "
+            "default is 1 (N/m^2)");
+    OpenSim_DECLARE_PROPERTY(dissipation, double,
+            "The dissipation coefficient, default is 0 (s/m).");
+    OpenSim_DECLARE_PROPERTY(static_friction, double,
+            "The coefficient of static friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(dynamic_friction, double,
+            "The coefficient of dynamic friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(viscous_friction, double,
+            "The coefficient of viscous friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(transition_velocity, double,
+            "The transition velocity, default is 0.01 (m/s).");
+    OpenSim_DECLARE_PROPERTY(constant_contact_force, double,
+            "The constant that enforces non-null derivatives, "
+            "default is 1e-5 (N).");
+    OpenSim_DECLARE_PROPERTY(hertz_smoothing, double,
+            "The parameter that determines the smoothness of the transition "
+            "of the tanh used to smooth the Hertz force. The larger the "
+            "steeper the transition but the worse for optimization, "
+            "default is 300.");
+    OpenSim_DECLARE_PROPERTY(hunt_crossley_smoothing, double,
+            "The parameter that determines the smoothness of the transition "
+            "of the tanh used to smooth the Hunt-Crossley force. The larger "
+            "the steeper the transition but the worse for optimization, "
+            "default is 50.");
+
+    //=========================================================================
+    // SOCKETS
+    //=========================================================================
+    OpenSim_DECLARE_LIST_SOCKET(spheres, ContactSphere,
+            "The spheres participating in this contact.");
+    OpenSim_DECLARE_SOCKET(half_space, ContactHalfSpace,
+            "The half-space participating in this contact.");
+
+    //=========================================================================
+    // PUBLIC METHODS
+    //=========================================================================
+    SmoothSphereHalfSpaceForceGroup();
+
+    SmoothSphereHalfSpaceForceGroup(const std::string& name,
+            const ContactHalfSpace& contactHalfSpace);
+
+    /// Add a sphere to the group. Call finalizeConnections() on the model
+    /// afterwards.
+    void addContactSphere(const ContactSphere& contactSphere);
+    int getNumContactSpheres() const;
+
+    /// Compute the contact force applied to each sphere, expressed in ground,
+    /// in the order of the 'spheres' Socket. The force applied to the half
+    /// space is the opposite of this force. The state must be realized to
+    /// Velocity.
+    void calcContactForces(const SimTK::State& s,
+            SimTK::Vector_<SimTK::Vec3>& forces) const;
+
+    /// Compute the Jacobians of the contact forces (see calcContactForces())
+    /// with respect to the generalized coordinates and speeds. `dFdq` has
+    /// 3 rows per sphere (the x, y, and z components of its force) and a
+    /// column per generalized coordinate; `dFdu` has a column per generalized
+    /// speed. The derivatives with respect to the indentations and the
+    /// contact-point velocities are analytic. The velocities of the contact
+    /// points also depend on the coordinates when the speeds are nonzero;
+    /// these derivatives are formed from the hinge matrix columns of the
+    /// ancestors of each sphere's body, assuming that each mobilizer's hinge
+    /// matrix is constant in its inboard frame (as for pin, slider, planar,
+    /// and free joints, but not for custom joints whose axes depend on the
+    /// coordinates). The half space must be attached to Ground. The state
+    /// must be realized to Velocity.
+    void calcContactForceJacobians(const SimTK::State& s,
+            SimTK::Matrix& dFdq, SimTK::Matrix& dFdu) const;
+
+    /// Get a SimTK::SpatialVec containing the forces and torques applied to
+    /// the body of sphere `index` by its contact with the half space.
+    SimTK::SpatialVec getSphereForce(const SimTK::State& s, int index) const;
+
+    //=========================================================================
+    // REPORTING
+    //=========================================================================
+    /// Obtain names of the quantities (column labels) of the force values to
+    /// be reported. The order is the three forces (XYZ) and three torques
+    /// (XYZ) applied on each sphere's body by that sphere's contact, followed
+    /// by the three forces (XYZ) and three torques (XYZ) applied on the half
+    /// space by all spheres. Forces and torques are expressed in the ground
+    /// frame.
+    OpenSim::Array<std::string> getRecordLabels() const override;
+    /// Obtain the values to be reported that correspond to the labels. The
+    /// values are expressed in the ground frame.
+    OpenSim::Array<double> getRecordValues(
+            const SimTK::State& state) const override;
+
+    bool supportsParallelEvaluation() const override { return true; }
+
+protected:
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void computeForce(const SimTK::State& s,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& generalizedForces) const override;
+
+private:
+    // INITIALIZATION
+    void constructProperties();
+
+    // The contact of every sphere, stored as arrays over the spheres.
+    struct Contacts {
+        // The outward normal of the half space, in ground.
+        SimTK::Vec3 normal;
+        // The contact points (halfway through the indentation) in ground.
+        std::vector<SimTK::Vec3> points;
+        // The velocity of each contact point on the sphere's body relative to
+        // the contact point on the half space's body, in ground.
+        std::vector<SimTK::Vec3> velocities;
+        std::vector<double> indentations;
+        std::vector<double> indentationVelocities;
+        std::vector<double> normalForces;
+        // The forces applied to the spheres, in ground.
+        std::vector<SimTK::Vec3> forces;
+        friend std::ostream& operator<<(std::ostream& o, const Contacts&) {
+            o << "SmoothSphereHalfSpaceForceGroup::Contacts should not be "
+                 "serialized!" << std::endl;
+            return o;
+        }
+    };
+    // The spheres attached to one mobilized body.
+    struct SphereGroup {
+        SimTK::MobilizedBodyIndex body;
+        // The index of each sphere in the 'spheres' Socket.
+        std::vector<int> indices;
+    };
+
+    // Compute the contacts of all spheres in the state `s`.
+    void calcContacts(const SimTK::State& s, Contacts& contacts) const;
+    // The contacts of all spheres in the state `s`, computed once per
+    // realization of the Velocity stage.
+    const Contacts& getContacts(const SimTK::State& s) const;
+    // The friction coefficient for the given slip speed, and its derivative.
+    double calcFrictionCoefficient(double slipSpeed,
+            double* derivative = nullptr) const;
+
+    // Computed in extendAddToSystem().
+    mutable std::vector<SphereGroup> _sphereGroups;
+    mutable std::vector<SimTK::MobilizedBodyIndex> _sphereBodies;
+    // The centers of the spheres, expressed in their bodies' frames.
+    mutable std::vector<SimTK::Vec3> _centers;
+    mutable std::vector<double> _radii;
+    mutable SimTK::MobilizedBodyIndex _halfSpaceBody;
+    // The transform of the half space's frame in its body's frame.
+    mutable SimTK::Transform _halfSpaceFrame;
+    mutable CacheVariable<Contacts> _contactsCV;
+
+//=============================================================================
+}; // END of class SmoothSphereHalfSpaceForceGroup
+//=============================================================================
+//=============================================================================
+
+} // namespace OpenSim
+
+#endif // OPENSIM_SMOOTH_SPHERE_HALF_SPACE_FORCE_GROUP_H_
@@ -0,0 +1,111 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  StationKinematics.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//=============================================================================
+// INCLUDES
+//=============================================================================
+#include "StationKinematics.h"
+
+#include "Frame.h"
+#include "Model.h"
+#include "PhysicalFrame.h"
+#include <OpenSim/Common/Exception.h>
+
+using namespace OpenSim;
+
+int StationKinematics::addStation(
+        const Frame& frame, const SimTK::Vec3& station) {
+    const auto* base = dynamic_cast<const PhysicalFrame*>(
+            &frame.findBaseFrame());
+    OPENSIM_THROW_IF(!base, Exception,
+            "Expected the base frame of frame '{}' to be a PhysicalFrame.",
+            frame.getAbsolutePathString());
+    return addStation(frame.getModel().getMatterSubsystem(),
+            base->getMobilizedBodyIndex(),
+            frame.findTransformInBaseFrame() * station);
+}
+
+int StationKinematics::addStation(const SimTK::SimbodyMatterSubsystem& matter,
+        SimTK::MobilizedBodyIndex body, const SimTK::Vec3& station) {
+    OPENSIM_THROW_IF(_matter && _matter != &matter, Exception,
+            "All stations must belong to the same model.");
+    OPENSIM_THROW_IF(!body.isValid() || body >= matter.getNumBodies(),
+            Exception, "Invalid mobilized body index {}.", int(body));
+    _matter = &matter;
+    if ((int)_groupOfBody.size() < matter.getNumBodies()) {
+        _groupOfBody.resize(matter.getNumBodies(), -1);
+    }
+    if (_groupOfBody[body] == -1) {
+        _groupOfBody[body] = (int)_groups.size();
+        _groups.push_back({body, {}, {}});
+    }
+    Group& group = _groups[_groupOfBody[body]];
+    group.indices.push_back(_numStations);
+    group.stations.push_back(station);
+    return _numStations++;
+}
+
+void StationKinematics::calcLocationsInGround(const SimTK::State& s,
+        SimTK::Vector_<SimTK::Vec3>& locations) const {
+    locations.resize(_numStations);
+    for (const auto& group : _groups) {
+        const SimTK::Transform& X_GB =
+                _matter->getMobilizedBody(group.body).getBodyTransform(s);
+        for (int i = 0; i < (int)group.indices.size(); ++i) {
+            locations[group.indices[i]] = X_GB * group.stations[i];
+        }
+    }
+}
+
+void StationKinematics::calcVelocitiesInGround(const SimTK::State& s,
+        SimTK::Vector_<SimTK::Vec3>& velocities) const {
+    velocities.resize(_numStations);
+    for (const auto& group : _groups) {
+        const SimTK::MobilizedBody& mobod =
+                _matter->getMobilizedBody(group.body);
+        const SimTK::Rotation& R_GB = mobod.getBodyRotation(s);
+        const SimTK::SpatialVec& V_GB = mobod.getBodyVelocity(s);
+        for (int i = 0; i < (int)group.indices.size(); ++i) {
+            // The station's position relative to the body origin, in Ground.
+            const SimTK::Vec3 r = R_GB * group.stations[i];
+            velocities[group.indices[i]] = V_GB[1] + V_GB[0] % r;
+        }
+    }
+}
+
+void StationKinematics::calcAccelerationsInGround(const SimTK::State& s,
+        SimTK::Vector_<SimTK::Vec3>& accelerations) const {
+    accelerations.resize(_numStations);
+    for (const auto& group : _groups) {
+        const SimTK::MobilizedBody& mobod =
+                _matter->getMobilizedBody(group.body);
+        const SimTK::Rotation& R_GB = mobod.getBodyRotation(s);
+        const SimTK::Vec3& w = mobod.getBodyAngularVelocity(s);
+        const SimTK::SpatialVec& A_GB = mobod.getBodyAcceleration(s);
+        for (int i = 0; i < (int)group.indices.size(); ++i) {
+            const SimTK::Vec3 r = R_GB * group.stations[i];
+            accelerations[group.indices[i]] =
+                    A_GB[1] + A_GB[0] % r + w % (w % r);
+        }
+    }
+}
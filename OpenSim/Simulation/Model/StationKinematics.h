@@ -0,0 +1,110 @@
+#ifndef OPENSIM_STATION_KINEMATICS_H_
+#define OPENSIM_STATION_KINEMATICS_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  StationKinematics.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+// INCLUDE
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <simbody/internal/SimbodyMatterSubsystem.h>
+
+#include <vector>
+
+namespace OpenSim {
+
+class Frame;
+
+/**
+ * The kinematics of many stations (points fixed on frames) of a model,
+ * computed together. This is useful when the locations, velocities, or
+ * accelerations of many points (e.g., markers or centers of mass) are needed
+ * at the same time, as in analyses and reporters.
+ *
+ * The stations are grouped by the mobilized body that their frames are
+ * attached to, and are stored in the body's frame. Each calc method fetches
+ * the transform (and velocity or acceleration) of each body once, and writes
+ * the results for all stations to a single contiguous array, in the order in
+ * which the stations were added.
+ *
+ * Stations may only be added after the model's System has been created (e.g.,
+ * with Model::initSystem()); stations must be added again if the System is
+ * recreated. The calc methods require the state to be realized to the
+ * Position, Velocity, or Acceleration stage, respectively.
+ *
+ * @code
+ * StationKinematics stations;
+ * for (const auto& marker : model.getComponentList<Marker>()) {
+ *     stations.addStation(marker.getParentFrame(), marker.get_location());
+ * }
+ * model.realizePosition(state);
+ * SimTK::Vector_<SimTK::Vec3> locations;
+ * stations.calcLocationsInGround(state, locations);
+ * @endcode
+ */
+class OSIMSIMULATION_API StationKinematics {
+public:
+    StationKinematics() = default;
+
+    /** Add a station, expressed in `frame`. Returns the index of the station
+    in the outputs of the calc methods. All stations must belong to the same
+    model. */
+    int addStation(const Frame& frame, const SimTK::Vec3& station);
+    /** Add a station fixed on a mobilized body of `matter`, expressed in the
+    body's frame. Returns the index of the station in the outputs of the calc
+    methods. */
+    int addStation(const SimTK::SimbodyMatterSubsystem& matter,
+            SimTK::MobilizedBodyIndex body, const SimTK::Vec3& station);
+
+    int getNumStations() const { return _numStations; }
+
+    /** Compute the locations of all stations, expressed in Ground. */
+    void calcLocationsInGround(const SimTK::State& s,
+            SimTK::Vector_<SimTK::Vec3>& locations) const;
+    /** Compute the velocities of all stations in Ground, expressed in
+    Ground. */
+    void calcVelocitiesInGround(const SimTK::State& s,
+            SimTK::Vector_<SimTK::Vec3>& velocities) const;
+    /** Compute the accelerations of all stations in Ground, expressed in
+    Ground. */
+    void calcAccelerationsInGround(const SimTK::State& s,
+            SimTK::Vector_<SimTK::Vec3>& accelerations) const;
+
+private:
+    // The stations fixed on one mobilized body.
+    struct Group {
+        SimTK::MobilizedBodyIndex body;
+        // The index of each station in the outputs.
+        std::vector<int> indices;
+        // The stations, expressed in the body's frame.
+        std::vector<SimTK::Vec3> stations;
+    };
+
+    const SimTK::SimbodyMatterSubsystem* _matter = nullptr;
+    std::vector<Group> _groups;
+    // The index in _groups of each mobilized body's group (-1 if none).
+    std::vector<int> _groupOfBody;
+    int _numStations = 0;
+
+}; // class StationKinematics
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STATION_KINEMATICS_H_
@@ -50,6 +50,7 @@
 #include "Model/ElasticFoundationForce.h"
 #include "Model/HuntCrossleyForce.h"
 #include "Model/SmoothSphereHalfSpaceForce.h"
+#include "Model/SmoothSphereHalfSpaceForceGroup.h"
 #include "Model/Ligament.h"
 #include "Model/Blankevoort1991Ligament.h"
 #include "Model/JointSet.h"
@@ -251,6 +252,7 @@ OSIMSIMULATION_API void RegisterTypes_osimSimulation()
     Object::registerType( ContactSphere() );
     Object::registerType( CoordinateLimitForce() );
     Object::registerType( SmoothSphereHalfSpaceForce() );
+    Object::registerType( SmoothSphereHalfSpaceForceGroup() );
     Object::registerType( HuntCrossleyForce() );
     Object::registerType( ElasticFoundationForce() );
     Object::registerType( HuntCrossleyForce::ContactParameters() );
@@ -322,6 +324,11 @@ OSIMSIMULATION_API void RegisterTypes_osimSimulation()
     Object::renameType("MuscleMetabolicPowerProbeUmberger2010_MetabolicMuscleParameterSet",  
         "Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet");
 
+    // Display-only types, which may be read lazily from model files (see
+    // Object::setLazyDeserialization()).
+    Object::registerDeferrableType(Appearance::getClassName());
+    Object::registerDeferrableType(ModelVisualPreferences::getClassName());
+
   } catch (const std::exception& e) {
     std::cerr 
         << "ERROR during osimSimulation Object registration:\n"
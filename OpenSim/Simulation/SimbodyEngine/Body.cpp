@@ -26,6 +26,7 @@
 //=============================================================================
 #include "Body.h"
 #include <OpenSim/Common/ScaleSet.h>
+#include "simbody/internal/MobilizedBody.h"
 
 //=============================================================================
 // STATICS
@@ -379,6 +380,36 @@ SimTK::MassProperties Body::getMassProperties() const
     }
 }
 
+void Body::updateMobilizedBodyMassProperties()
+{
+    // The inertia property may have been edited directly.
+    _inertia = SimTK::Inertia{};
+    const SimTK::MassProperties& massProps = getMassProperties();
+
+    // Partition the mass among the master and its slaves as in
+    // extendConnectToModel().
+    int nslaves = (int)_slaves.size();
+    SimTK::MassProperties internalMassProps = massProps;
+    if (nslaves) {
+        int nbods = nslaves + 1; // include the master
+        internalMassProps = SimTK::MassProperties(massProps.getMass() / nbods,
+            massProps.getMassCenter(), massProps.getUnitInertia());
+    }
+
+    _internalRigidBody = SimTK::Body::Rigid(internalMassProps);
+    updMobilizedBody().setDefaultMassProperties(internalMassProps);
+
+    for (int i = 0; i < nslaves; ++i) {
+        _slaves[i]->_internalRigidBody =
+                SimTK::Body::Rigid(internalMassProps);
+        _slaves[i]->setInertia(internalMassProps.getUnitInertia());
+        _slaves[i]->setMass(internalMassProps.getMass());
+        _slaves[i]->setMassCenter(internalMassProps.getMassCenter());
+        _slaves[i]->updMobilizedBody().setDefaultMassProperties(
+                internalMassProps);
+    }
+}
+
 //=============================================================================
 // I/O
 //=============================================================================
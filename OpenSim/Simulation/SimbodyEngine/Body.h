@@ -105,6 +105,14 @@ public:
     void scaleInertialProperties(const SimTK::Vec3& scaleFactors, bool scaleMass = true);
 
     void scaleMass(double aScaleFactor);
+
+    /** Update the default mass properties of the SimTK::MobilizedBody that
+    backs this Body (and of its slaves, if the Body was split to break a
+    kinematic loop) after the mass, mass_center, or inertia property was
+    edited, without rebuilding the System. The change takes effect once the
+    System's topology is realized again, e.g., by Model::initializeState(),
+    which is much cheaper than Model::initSystem(). */
+    void updateMobilizedBodyMassProperties();
  protected:
 
     // Model component interface.
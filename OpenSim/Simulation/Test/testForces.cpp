@@ -28,7 +28,7 @@
 //      2. BushingForce
 //      3. ElasticFoundationForce
 //      4. HuntCrossleyForce
-//      5. SmoothSphereHalfSpaceForce
+//      5. SmoothSphereHalfSpaceForce and SmoothSphereHalfSpaceForceGroup
 //      6. CoordinateLimitForce
 //      7. RotationalCoordinateLimitForce
 //      8. ExternalForce
@@ -41,6 +41,7 @@
 //==============================================================================
 #include "SimTKcommon/internal/Xml.h"
 #include <ctime> // clock(), clock_t, CLOCKS_PER_SEC
+#include <thread>
 
 #include <OpenSim/Analyses/osimAnalyses.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
@@ -1325,6 +1326,114 @@ TEST_CASE("testSmoothSphereHalfSpaceForce") {
     ASSERT(isEqual);
 }
 
+// A SmoothSphereHalfSpaceForceGroup should produce the same forces as one
+// SmoothSphereHalfSpaceForce per sphere, and its Jacobians should match finite
+// differences.
+TEST_CASE("testSmoothSphereHalfSpaceForceGroup") {
+    using namespace SimTK;
+
+    Model model;
+    model.setName("SmoothSphereHalfSpaceForceGroup");
+    auto* foot = new OpenSim::Body("foot", 1.0, Vec3(0), Inertia(0.1));
+    model.addBody(foot);
+    model.addJoint(new FreeJoint("free", model.getGround(), *foot));
+    auto* floor = new ContactHalfSpace(Vec3(0), Vec3(0, 0, -0.5 * SimTK::Pi),
+            model.getGround(), "floor");
+    model.addContactGeometry(floor);
+
+    const auto setParameters = [](auto& force) {
+        force.set_stiffness(1e6);
+        force.set_dissipation(2.0);
+        force.set_static_friction(0.8);
+        force.set_dynamic_friction(0.6);
+        force.set_viscous_friction(0.5);
+        force.set_transition_velocity(0.2);
+    };
+    auto* group = new SmoothSphereHalfSpaceForceGroup("group", *floor);
+    setParameters(*group);
+    const std::vector<Vec3> locations{
+            {0.1, -0.02, 0.03}, {-0.08, -0.03, -0.02}, {0.0, -0.01, 0.05}};
+    const std::vector<double> radii{0.03, 0.035, 0.02};
+    std::vector<const SmoothSphereHalfSpaceForce*> forces;
+    for (int i = 0; i < 3; ++i) {
+        const std::string suffix = std::to_string(i);
+        auto* sphere = new ContactSphere(
+                radii[i], locations[i], *foot, "sphere" + suffix);
+        model.addContactGeometry(sphere);
+        auto* force = new SmoothSphereHalfSpaceForce(
+                "force" + suffix, *sphere, *floor);
+        setParameters(*force);
+        model.addForce(force);
+        forces.push_back(force);
+        group->addContactSphere(*sphere);
+    }
+    model.addForce(group);
+
+    SimTK::State state = model.initSystem();
+    CHECK(group->getNumContactSpheres() == 3);
+    state.updQ() = Vector(Vec6(0.1, 0.2, -0.1, 0.01, 0.02, -0.03));
+    state.updU() = Vector(Vec6(0.5, -0.3, 0.2, 0.4, -0.1, 0.3));
+    model.realizeVelocity(state);
+
+    for (int i = 0; i < 3; ++i) {
+        const SpatialVec actual = group->getSphereForce(state, i);
+        const SpatialVec expected = forces[i]->getSphereForce(state);
+        for (int k = 0; k < 2; ++k) {
+            for (int r = 0; r < 3; ++r) {
+                CHECK_THAT(actual[k][r],
+                        Catch::Matchers::WithinAbs(expected[k][r], 1e-8));
+            }
+        }
+    }
+
+    // Compare the Jacobians to central differences.
+    const auto calcForces = [&](SimTK::State& perturbed) {
+        model.realizeVelocity(perturbed);
+        Vector_<Vec3> contactForces;
+        group->calcContactForces(perturbed, contactForces);
+        return contactForces;
+    };
+    const auto checkColumn = [](const Matrix& jacobian, int j,
+            const Vector_<Vec3>& plus, const Vector_<Vec3>& minus, double h) {
+        for (int i = 0; i < plus.size(); ++i) {
+            for (int r = 0; r < 3; ++r) {
+                const double expected = (plus[i][r] - minus[i][r]) / (2 * h);
+                CHECK_THAT(jacobian(3 * i + r, j),
+                        Catch::Matchers::WithinAbs(expected,
+                                1e-5 * std::max(1.0, std::abs(expected))));
+            }
+        }
+    };
+    const double h = 1e-7;
+    const auto checkJacobians = [&](const SimTK::State& s) {
+        Matrix dFdq, dFdu;
+        group->calcContactForceJacobians(s, dFdq, dFdu);
+        REQUIRE(dFdu.nrow() == 9);
+        REQUIRE(dFdu.ncol() == s.getNU());
+        for (int j = 0; j < s.getNU(); ++j) {
+            SimTK::State plus = s;
+            plus.updU()[j] += h;
+            SimTK::State minus = s;
+            minus.updU()[j] -= h;
+            checkColumn(dFdu, j, calcForces(plus), calcForces(minus), h);
+        }
+        REQUIRE(dFdq.nrow() == 9);
+        REQUIRE(dFdq.ncol() == s.getNQ());
+        for (int j = 0; j < s.getNQ(); ++j) {
+            SimTK::State plus = s;
+            plus.updQ()[j] += h;
+            SimTK::State minus = s;
+            minus.updQ()[j] -= h;
+            checkColumn(dFdq, j, calcForces(plus), calcForces(minus), h);
+        }
+    };
+    // With nonzero speeds, the velocities of the contact points depend on q.
+    checkJacobians(state);
+    state.updU() = 0;
+    model.realizeVelocity(state);
+    checkJacobians(state);
+}
+
 TEST_CASE("testCoordinateLimitForce") {
     using namespace SimTK;
 
@@ -2254,3 +2363,195 @@ TEST_CASE("testBlankevoort1991Ligament") {
         "reference state be equal to the strain value input "
         "to setSlackLengthFromReferenceStrain().");
 }
+
+TEST_CASE("Parallel force evaluation") {
+    // Compute accelerations with and without Simbody's parallel force
+    // evaluation; the results must be identical.
+    auto computeUDot = [](bool useParallelForces) {
+        Model model("arm26.osim");
+        model.setUseParallelForces(useParallelForces);
+        model.setParallelForcesThreshold(0);
+        SimTK::State state = model.initSystem();
+        CHECK(model.isParallelForceEvaluationEnabled() == useParallelForces);
+        for (const auto& muscle : model.getComponentList<Muscle>()) {
+            CHECK(muscle.shouldBeParallelized() == useParallelForces);
+            muscle.setActivation(state, 0.3);
+        }
+        model.getCoordinateSet().get("r_elbow_flex").setValue(state, 0.5);
+        model.getCoordinateSet().get("r_elbow_flex").setSpeedValue(state, 1.0);
+        model.setControls(state, SimTK::Vector(model.getNumControls(), 0.4));
+        model.equilibrateMuscles(state);
+        model.realizeAcceleration(state);
+        return SimTK::Vector(state.getUDot());
+    };
+    const SimTK::Vector serial = computeUDot(false);
+    const SimTK::Vector parallel = computeUDot(true);
+    REQUIRE(serial.size() == parallel.size());
+    for (int i = 0; i < serial.size(); ++i) {
+        CHECK_THAT(parallel[i], Catch::Matchers::WithinAbs(serial[i], 1e-12));
+    }
+
+    // Below the threshold, forces are evaluated serially.
+    Model model("arm26.osim");
+    model.setUseParallelForces(true);
+    model.setParallelForcesThreshold(1000);
+    model.initSystem();
+    CHECK_FALSE(model.isParallelForceEvaluationEnabled());
+    CHECK_THROWS(model.setParallelForcesThreshold(-1));
+}
+
+TEST_CASE("CompiledExpressions") {
+    CompiledExpressions expressions;
+    expressions.compile({"x*y+sin(x)", "2.5", "x * y + sin(x)", "exp(-y)"},
+            {"x", "y"});
+    REQUIRE(expressions.getNumExpressions() == 4);
+    REQUIRE(expressions.getNumVariables() == 2);
+
+    const double x = 0.3;
+    const double y = -1.2;
+    const double vars[2] = {x, y};
+    const double expected[4] = {
+            x * y + sin(x), 2.5, x * y + sin(x), exp(-y)};
+    const double expectedDerivatives[8] = {y + cos(x), x, 0, 0, y + cos(x),
+            x, 0, -exp(-y)};
+
+    double derivatives[8];
+
+    // Copies must evaluate their own (rebound) compiled expressions.
+    const CompiledExpressions copy(expressions);
+    for (const auto* compiled : {&expressions, &copy}) {
+        double values[4];
+        compiled->evaluate(vars, values);
+        for (int i = 0; i < 4; ++i) {
+            CHECK_THAT(values[i],
+                    Catch::Matchers::WithinAbs(expected[i], 1e-15));
+        }
+        compiled->evaluateDerivatives(vars, derivatives);
+        for (int i = 0; i < 8; ++i) {
+            CHECK_THAT(derivatives[i],
+                    Catch::Matchers::WithinAbs(expectedDerivatives[i], 1e-15));
+        }
+    }
+
+    // Threads evaluating the same object at once must not see each other's
+    // variable values. The derivatives of this object are compiled by
+    // whichever thread evaluates them first.
+    CompiledExpressions shared;
+    shared.compile({"x*y+sin(x)", "2.5", "x * y + sin(x)", "exp(-y)"},
+            {"x", "y"});
+    const int numThreads = 4;
+    const int numEvaluations = 1000;
+    std::vector<int> numErrors(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            const double threadVars[2] = {x + t, y - t};
+            const double threadExpected =
+                    threadVars[0] * threadVars[1] + sin(threadVars[0]);
+            for (int k = 0; k < numEvaluations; ++k) {
+                double values[4];
+                double threadDerivatives[8];
+                shared.evaluate(threadVars, values);
+                shared.evaluateDerivatives(threadVars, threadDerivatives);
+                if (std::abs(values[0] - threadExpected) > 1e-12 ||
+                        threadDerivatives[1] != threadVars[0]) {
+                    ++numErrors[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int t = 0; t < numThreads; ++t) CHECK(numErrors[t] == 0);
+
+    CHECK_THROWS_AS(expressions.compile({"x*z"}, {"x", "y"}), Exception);
+}
+
+TEST_CASE("Expression-based force derivatives") {
+    using namespace SimTK;
+    using Catch::Matchers::WithinAbs;
+    using Catch::Matchers::WithinRel;
+
+    Model model;
+    model.setGravity(Vec3(0));
+    auto* ball = new OpenSim::Body("ball", 1.0, Vec3(0), Inertia(0.1));
+    model.addBody(ball);
+    auto* free = new FreeJoint("free", model.getGround(), *ball);
+    model.addJoint(free);
+
+    auto* coordForce = new ExpressionBasedCoordinateForce(
+            free->getCoordinate(FreeJoint::Coord::TranslationY).getName(),
+            "-10*q^3-5*qdot*q");
+    model.addForce(coordForce);
+    auto* p2pForce = new ExpressionBasedPointToPointForce(
+            "ground", Vec3(0.1, 0.2, 0), "ball", Vec3(0), "d^2*ddot-3*d");
+    model.addForce(p2pForce);
+    auto* bushing = new ExpressionBasedBushingForce(
+            "bushing", model.getGround(), *ball);
+    bushing->setMxExpression("theta_x*delta_y");
+    bushing->setMyExpression("sin(theta_y)*theta_z");
+    bushing->setMzExpression("2*theta_z");
+    bushing->setFxExpression("delta_x^3-theta_x");
+    bushing->setFyExpression("exp(delta_y)*delta_z");
+    bushing->setFzExpression("delta_x^3-theta_x");
+    model.addForce(bushing);
+
+    State state = model.initSystem();
+    const Vector q(6, std::vector<double>{0.1, -0.2, 0.3, 0.15, 0.4, -0.25}
+                              .data());
+    const Vector u(6, std::vector<double>{0.5, 0.1, -0.3, 1.0, -0.5, 0.2}
+                              .data());
+    state.updQ() = q;
+    state.updU() = u;
+    model.realizeVelocity(state);
+
+    // Coordinate force: compare with the analytical derivatives.
+    const double qy = free->getCoordinate(FreeJoint::Coord::TranslationY)
+                              .getValue(state);
+    const double uy = free->getCoordinate(FreeJoint::Coord::TranslationY)
+                              .getSpeedValue(state);
+    const Vec2 coordDerivs = coordForce->calcForceMagnitudeDerivatives(state);
+    CHECK_THAT(coordDerivs[0], WithinAbs(-30 * qy * qy - 5 * uy, 1e-12));
+    CHECK_THAT(coordDerivs[1], WithinAbs(-5 * qy, 1e-12));
+    CHECK_THAT(coordForce->calcExpressionForce(state),
+            WithinAbs(-10 * qy * qy * qy - 5 * uy * qy, 1e-12));
+
+    // Point-to-point force: the derivative w.r.t. ddot is d^2, and the
+    // derivative w.r.t. d is 2*d*ddot-3, so ddot = (dF/dd + 3)/(2*d).
+    const Vec2 p2pDerivs = p2pForce->calcForceMagnitudeDerivatives(state);
+    const double d = std::sqrt(p2pDerivs[1]);
+    const Vec3 p1 = model.getGround().findStationLocationInGround(
+            state, Vec3(0.1, 0.2, 0));
+    const Vec3 p2 = ball->findStationLocationInGround(state, Vec3(0));
+    CHECK_THAT(d, WithinRel((p2 - p1).norm(), 1e-12));
+    const double ddot = (p2pDerivs[0] + 3) / (2 * d);
+    const Vec3 v2 = ball->findStationVelocityInGround(state, Vec3(0));
+    CHECK_THAT(ddot, WithinAbs(dot(v2, (p2 - p1) / d), 1e-12));
+
+    // Bushing: the stiffness matrix must agree with finite differences of the
+    // stiffness force with respect to the deflection. Use the chain rule with
+    // finite differences with respect to q.
+    const Mat66 K = bushing->calcStiffnessMatrix(state);
+    const double h = 1e-6;
+    Mat66 dFdq, ddqdq;
+    for (int j = 0; j < 6; ++j) {
+        State perturbed = state;
+        perturbed.updQ()[j] = q[j] + h;
+        model.realizePosition(perturbed);
+        const Vec6 fPlus = bushing->calcStiffnessForce(perturbed);
+        const Vec6 dqPlus = bushing->computeDeflection(perturbed);
+        perturbed.updQ()[j] = q[j] - h;
+        model.realizePosition(perturbed);
+        const Vec6 fMinus = bushing->calcStiffnessForce(perturbed);
+        const Vec6 dqMinus = bushing->computeDeflection(perturbed);
+        dFdq(j) = (fPlus - fMinus) / (2 * h);
+        ddqdq(j) = (dqPlus - dqMinus) / (2 * h);
+    }
+    const Mat66 chainRule = K * ddqdq;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            CHECK_THAT(chainRule(i, j), WithinAbs(dFdq(i, j), 1e-6));
+        }
+    }
+    // The expressions of Fx and Fz are identical.
+    CHECK(K[3] == K[5]);
+}
@@ -31,6 +31,7 @@ Tests Include:
     5. PhysicalOffsetFrame on PhysicalOffsetFrame in non-Multibody tree order
     6. Filtering of Frames by their type
     7. Velocity and acceleration methods
+    8. Kinematics of many stations computed together
       
      Add tests here as Frames are added to OpenSim
 
@@ -38,6 +39,7 @@ Tests Include:
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
+#include <OpenSim/Simulation/Model/StationKinematics.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <catch2/catch_all.hpp>
 
@@ -520,3 +522,44 @@ TEST_CASE("VelocityAndAccelerationMethods")
     SimTK_TEST_EQ(rod2.getAccelerationInGround(s)[1],
                   rod2.getLinearAccelerationInGround(s));
 }
+
+TEST_CASE("StationKinematics")
+{
+    Model pendulum("double_pendulum.osim");
+    const OpenSim::Body& rod1 = pendulum.getBodySet().get("rod1");
+    const OpenSim::Body& rod2 = pendulum.getBodySet().get("rod2");
+    auto* offset = new PhysicalOffsetFrame("offset", rod2,
+            Transform(SimTK::Rotation(0.3, SimTK::XAxis), SimTK::Vec3(0.1)));
+    pendulum.addComponent(offset);
+    SimTK::State& s = pendulum.initSystem();
+    pendulum.getCoordinateSet().get("q1").setValue(s, 2.0);
+    pendulum.getCoordinateSet().get("q2").setValue(s, -1.0);
+    pendulum.getCoordinateSet().get("q1").setSpeedValue(s, 0.5);
+    pendulum.getCoordinateSet().get("q2").setSpeedValue(s, -1.5);
+    pendulum.realizeAcceleration(s);
+
+    // Stations on different bodies are added in an interleaved order.
+    std::vector<const Frame*> frames = {&rod2, &rod1, offset,
+            &pendulum.getGround(), &rod2};
+    std::vector<SimTK::Vec3> stations = {SimTK::Vec3(-.2, .1, -.3),
+            SimTK::Vec3(0.5, 0, 0), SimTK::Vec3(0, -0.2, 0.1),
+            SimTK::Vec3(1, 2, 3), SimTK::Vec3(0)};
+    StationKinematics kinematics;
+    for (int i = 0; i < (int)frames.size(); ++i) {
+        CHECK(kinematics.addStation(*frames[i], stations[i]) == i);
+    }
+    CHECK(kinematics.getNumStations() == (int)frames.size());
+
+    SimTK::Vector_<SimTK::Vec3> locations, velocities, accelerations;
+    kinematics.calcLocationsInGround(s, locations);
+    kinematics.calcVelocitiesInGround(s, velocities);
+    kinematics.calcAccelerationsInGround(s, accelerations);
+    for (int i = 0; i < (int)frames.size(); ++i) {
+        SimTK_TEST_EQ(locations[i],
+                frames[i]->findStationLocationInGround(s, stations[i]));
+        SimTK_TEST_EQ(velocities[i],
+                frames[i]->findStationVelocityInGround(s, stations[i]));
+        SimTK_TEST_EQ(accelerations[i],
+                frames[i]->findStationAccelerationInGround(s, stations[i]));
+    }
+}
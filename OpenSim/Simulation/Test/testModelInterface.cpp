@@ -35,6 +35,7 @@ using namespace std;
 void testModelFinalizePropertiesAndConnections();
 void testModelTopologyErrors();
 void testDoesNotSegfaultWithUnusualConnections();
+void testLazyDeserialization();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
@@ -43,6 +44,7 @@ int main() {
         SimTK_SUBTEST(testModelFinalizePropertiesAndConnections);
         SimTK_SUBTEST(testModelTopologyErrors);
         SimTK_SUBTEST(testDoesNotSegfaultWithUnusualConnections);
+        SimTK_SUBTEST(testLazyDeserialization);
     SimTK_END_TEST();
 }
 
@@ -262,3 +264,46 @@ void testDoesNotSegfaultWithUnusualConnections()
         // a runtime exception (for now... ;))
     }
 }
+
+void testLazyDeserialization()
+{
+    Model eagerModel("StationDefinedFrames_Advanced.osim");
+    Object::setLazyDeserialization(true);
+    Model lazyModel("StationDefinedFrames_Advanced.osim");
+    Object::setLazyDeserialization(false);
+
+    // The Appearance of each Geometry has not been read.
+    const auto countDeferred = [](const Model& model) {
+        int numDeferred = 0;
+        for (const auto& geometry : model.getComponentList<Geometry>()) {
+            for (int i = 0; i < geometry.getNumProperties(); ++i) {
+                if (geometry.isPropertyDeferred(i)) ++numDeferred;
+            }
+        }
+        return numDeferred;
+    };
+    ASSERT(countDeferred(lazyModel) > 0);
+    ASSERT(lazyModel.countNumComponents() == eagerModel.countNumComponents());
+
+    // Copies are lazy too, and both give the same model once read.
+    Model copiedModel(lazyModel);
+    ASSERT(countDeferred(copiedModel) > 0);
+    ASSERT(lazyModel == eagerModel);
+    ASSERT(countDeferred(lazyModel) == 0);
+    ASSERT(copiedModel == eagerModel);
+    ASSERT(countDeferred(copiedModel) == 0);
+
+    // The deferred XML refers to the model file's document, which a copy
+    // keeps alive after the model it was read into is gone.
+    std::unique_ptr<Model> survivingCopy;
+    {
+        Object::setLazyDeserialization(true);
+        Model model("StationDefinedFrames_Advanced.osim");
+        Object::setLazyDeserialization(false);
+        survivingCopy.reset(model.clone());
+    }
+    ASSERT(countDeferred(*survivingCopy) > 0);
+    ASSERT(*survivingCopy == eagerModel);
+
+    lazyModel.initSystem();
+}
@@ -0,0 +1,116 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  testTrajectoryAnalyzer.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimulationUtilities.h>
+#include <OpenSim/Simulation/TrajectoryAnalyzer.h>
+
+#include <catch2/catch_all.hpp>
+
+using namespace OpenSim;
+
+namespace {
+// Create states and controls tables for a double pendulum.
+void createTrajectory(const Model& model, TimeSeriesTable& statesTable,
+        TimeSeriesTable& controlsTable) {
+    const int numTimes = 11;
+    std::vector<double> time(numTimes);
+    for (int i = 0; i < numTimes; ++i) { time[i] = 0.1 * i; }
+    statesTable = TimeSeriesTable(time);
+    controlsTable = TimeSeriesTable(time);
+    SimTK::Vector q0(numTimes), u0(numTimes), q1(numTimes), u1(numTimes);
+    SimTK::Vector tau0(numTimes), tau1(numTimes);
+    for (int i = 0; i < numTimes; ++i) {
+        q0[i] = std::sin(time[i]);
+        u0[i] = std::cos(time[i]);
+        q1[i] = 0.5 * time[i];
+        u1[i] = 0.5;
+        tau0[i] = time[i];
+        tau1[i] = -2.0 * time[i];
+    }
+    statesTable.appendColumn("/jointset/j0/q0/value", q0);
+    statesTable.appendColumn("/jointset/j0/q0/speed", u0);
+    statesTable.appendColumn("/jointset/j1/q1/value", q1);
+    statesTable.appendColumn("/jointset/j1/q1/speed", u1);
+    controlsTable.appendColumn("/tau0", tau0);
+    controlsTable.appendColumn("/tau1", tau1);
+}
+} // anonymous namespace
+
+TEST_CASE("TrajectoryAnalyzer matches analyze()") {
+    Model model = ModelFactory::createDoublePendulum();
+    model.initSystem();
+    TimeSeriesTable statesTable;
+    TimeSeriesTable controlsTable;
+    createTrajectory(model, statesTable, controlsTable);
+
+    const std::vector<std::string> scalarPaths = {
+            ".*\\|actuation", "/jointset/j1/q1\\|value"};
+    const std::vector<std::string> vec3Paths = {"/bodyset/b1\\|position"};
+    const auto expectedScalars = analyze<double>(
+            model, statesTable, controlsTable, scalarPaths);
+    const auto expectedVec3s = analyze<SimTK::Vec3>(
+            model, statesTable, controlsTable, vec3Paths);
+
+    const int numThreads = GENERATE(1, 3);
+    TrajectoryAnalyzer analyzer(
+            model, statesTable, controlsTable, {}, numThreads);
+    CHECK(analyzer.getNumTimes() == (int)statesTable.getNumRows());
+    CHECK(analyzer.getNumThreads() == numThreads);
+
+    std::vector<std::string> allPaths(scalarPaths);
+    allPaths.insert(allPaths.end(), vec3Paths.begin(), vec3Paths.end());
+    const auto results = analyzer.analyze(allPaths);
+    CHECK(results.spatialVecs.getNumColumns() == 0);
+
+    REQUIRE(results.scalars.getNumRows() == expectedScalars.getNumRows());
+    REQUIRE(results.scalars.getNumColumns() ==
+            expectedScalars.getNumColumns());
+    for (const auto& label : expectedScalars.getColumnLabels()) {
+        const auto actual = results.scalars.getDependentColumn(label);
+        const auto expected = expectedScalars.getDependentColumn(label);
+        for (int i = 0; i < expected.size(); ++i) {
+            CHECK_THAT(actual[i],
+                    Catch::Matchers::WithinAbs(expected[i], 1e-12));
+        }
+    }
+
+    REQUIRE(results.vec3s.getNumColumns() == expectedVec3s.getNumColumns());
+    const auto actualPos =
+            results.vec3s.getDependentColumn("/bodyset/b1|position");
+    const auto expectedPos =
+            expectedVec3s.getDependentColumn("/bodyset/b1|position");
+    for (int i = 0; i < expectedPos.size(); ++i) {
+        for (int j = 0; j < 3; ++j) {
+            CHECK_THAT(actualPos[i][j],
+                    Catch::Matchers::WithinAbs(expectedPos[i][j], 1e-12));
+        }
+    }
+
+    // A second call reuses the stored states.
+    const auto speeds = analyzer.analyze({".*\\|speed"}).scalars;
+    CHECK(speeds.getNumColumns() == 2);
+    CHECK_THAT(speeds.getDependentColumn("/jointset/j1/q1|speed")[3],
+            Catch::Matchers::WithinAbs(0.5, 1e-15));
+}
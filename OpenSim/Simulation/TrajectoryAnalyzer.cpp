@@ -0,0 +1,319 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  TrajectoryAnalyzer.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TrajectoryAnalyzer.h"
+
+#include "SimulationUtilities.h"
+#include "StatesTrajectory.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <future>
+#include <regex>
+#include <thread>
+#include <unordered_set>
+
+using namespace OpenSim;
+
+namespace {
+// Invoke the provided function on every Output of the model (including the
+// Outputs of the model itself), always in the same order.
+template <typename F>
+void forEachOutput(const Model& model, F function) {
+    for (const auto& comp : model.getComponentList()) {
+        for (const auto& outputName : comp.getOutputNames()) {
+            function(comp.getOutput(outputName));
+        }
+    }
+    for (const auto& outputName : model.getOutputNames()) {
+        function(model.getOutput(outputName));
+    }
+}
+
+// Collect the channels of the output if it has type T.
+template <typename T>
+bool appendChannels(const AbstractOutput& output,
+        std::vector<const typename Output<T>::Channel*>& channels) {
+    const auto* typedOutput = dynamic_cast<const Output<T>*>(&output);
+    if (!typedOutput) return false;
+    for (const auto& kv : typedOutput->getChannels()) {
+        channels.push_back(&kv.second);
+    }
+    return true;
+}
+
+template <typename T>
+std::vector<std::string> createLabels(
+        const std::vector<const typename Output<T>::Channel*>& channels) {
+    std::vector<std::string> labels;
+    labels.reserve(channels.size());
+    for (const auto* channel : channels) {
+        labels.push_back(channel->getPathName());
+    }
+    return labels;
+}
+} // anonymous namespace
+
+/// Each Worker owns a copy of the model and the (pre-constructed) states for
+/// a contiguous block of time points.
+class TrajectoryAnalyzer::Worker {
+public:
+    Worker(Model modelCopy, const TimeSeriesTable& statesTable,
+            const TimeSeriesTable& controlsTable,
+            const TimeSeriesTable& discreteVariablesTable, int begin, int end)
+            : model(std::move(modelCopy)), begin(begin) {
+        model.initSystem();
+
+        TimeSeriesTable blockStatesTable(statesTable);
+        blockStatesTable.trimToIndices(begin, end - 1);
+        const auto statesTraj =
+                StatesTrajectory::createFromStatesTable(model, blockStatesTable);
+
+        // Precompute the mapping from the controls table to the model's
+        // control vector.
+        const auto controlMap = createSystemControlIndexMap(model);
+        const auto& controlNames = controlsTable.getColumnLabels();
+        std::vector<int> controlIndices;
+        controlIndices.reserve(controlNames.size());
+        for (const auto& name : controlNames) {
+            OPENSIM_THROW_IF(controlMap.find(name) == controlMap.end(),
+                    Exception,
+                    "Control '{}' from the controls table does not exist in "
+                    "the model.", name);
+            controlIndices.push_back(controlMap.at(name));
+        }
+        SimTK::Vector controls((int)controlMap.size(), 0.0);
+
+        // The labels for each discrete variable are in the following format:
+        //      <path_to_component>/<discrete_var_name>
+        std::vector<std::pair<std::string, SimTK::ReferencePtr<const Component>>>
+                discreteComponentRefs;
+        for (const auto& label : discreteVariablesTable.getColumnLabels()) {
+            ComponentPath discreteVarPath(label);
+            const auto& component = model.getComponent(
+                    discreteVarPath.getParentPathString());
+            discreteComponentRefs.emplace_back(
+                    discreteVarPath.getComponentName(), &component);
+        }
+
+        states.reserve(statesTraj.getSize());
+        for (int i = 0; i < (int)statesTraj.getSize(); ++i) {
+            const int itime = begin + i;
+            SimTK::State state = statesTraj[i];
+
+            // Enforce any SimTK::Motion's included in the model.
+            model.getSystem().prescribe(state);
+
+            if (!controlIndices.empty()) {
+                const auto& controlsRow = controlsTable.getRowAtIndex(itime);
+                for (int ic = 0; ic < (int)controlIndices.size(); ++ic) {
+                    controls[controlIndices[ic]] = controlsRow[ic];
+                }
+            }
+            model.realizeVelocity(state);
+            model.setControls(state, controls);
+
+            // Apply discrete variables to the state.
+            if (!discreteComponentRefs.empty()) {
+                const auto& discreteRow =
+                        discreteVariablesTable.getRowAtIndex(itime);
+                for (int idv = 0; idv < (int)discreteComponentRefs.size();
+                        ++idv) {
+                    const auto& component =
+                            discreteComponentRefs[idv].second.getRef();
+                    component.setDiscreteVariableValue(state,
+                            discreteComponentRefs[idv].first,
+                            discreteRow[idv]);
+                }
+            }
+            states.push_back(std::move(state));
+        }
+    }
+
+    // Find the channels for all Outputs whose path names are in the provided
+    // set.
+    void resolve(const std::unordered_set<std::string>& outputPathNames) {
+        scalars.clear();
+        vec3s.clear();
+        spatialVecs.clear();
+        stage = SimTK::Stage::Topology;
+        forEachOutput(model, [&](const AbstractOutput& output) {
+            if (!outputPathNames.count(output.getPathName())) return;
+            stage = std::max(stage, output.getDependsOnStage());
+            if (!appendChannels<double>(output, scalars) &&
+                    !appendChannels<SimTK::Vec3>(output, vec3s)) {
+                appendChannels<SimTK::SpatialVec>(output, spatialVecs);
+            }
+        });
+    }
+
+    // Evaluate the Outputs, filling the rows of the provided matrices
+    // starting at row 'begin'.
+    void evaluate(SimTK::Matrix& scalarValues,
+            SimTK::Matrix_<SimTK::Vec3>& vec3Values,
+            SimTK::Matrix_<SimTK::SpatialVec>& spatialVecValues) {
+        for (int i = 0; i < (int)states.size(); ++i) {
+            auto& state = states[i];
+            // This has no effect if the state was already realized to this
+            // stage in a previous call.
+            model.getSystem().realize(state, stage);
+            const int row = begin + i;
+            for (int j = 0; j < (int)scalars.size(); ++j) {
+                scalarValues(row, j) = scalars[j]->getValue(state);
+            }
+            for (int j = 0; j < (int)vec3s.size(); ++j) {
+                vec3Values(row, j) = vec3s[j]->getValue(state);
+            }
+            for (int j = 0; j < (int)spatialVecs.size(); ++j) {
+                spatialVecValues(row, j) = spatialVecs[j]->getValue(state);
+            }
+        }
+    }
+
+    Model model;
+    int begin;
+    std::vector<SimTK::State> states;
+    SimTK::Stage stage = SimTK::Stage::Topology;
+    std::vector<const Output<double>::Channel*> scalars;
+    std::vector<const Output<SimTK::Vec3>::Channel*> vec3s;
+    std::vector<const Output<SimTK::SpatialVec>::Channel*> spatialVecs;
+};
+
+TrajectoryAnalyzer::TrajectoryAnalyzer(const Model& model,
+        const TimeSeriesTable& statesTable,
+        const TimeSeriesTable& controlsTable,
+        const TimeSeriesTable& discreteVariablesTable, int numThreads) {
+    const int numTimes = (int)statesTable.getNumRows();
+    OPENSIM_THROW_IF(numTimes == 0, Exception,
+            "Expected statesTable to contain at least one row.");
+    OPENSIM_THROW_IF(controlsTable.getNumColumns() &&
+                             (int)controlsTable.getNumRows() != numTimes,
+            Exception,
+            "Expected statesTable and controlsTable to contain the "
+            "same number of rows, but statesTable contains {} rows "
+            "and controlsTable contains {} rows.",
+            numTimes, controlsTable.getNumRows());
+    OPENSIM_THROW_IF(discreteVariablesTable.getNumColumns() &&
+                             (int)discreteVariablesTable.getNumRows() !=
+                                     numTimes,
+            Exception,
+            "Expected discreteVariablesTable to contain the "
+            "same number of rows as statesTable, "
+            "but discreteVariablesTable contains {} rows "
+            "and statesTable contains {} rows.",
+            discreteVariablesTable.getNumRows(), numTimes);
+    OPENSIM_THROW_IF(numThreads < 1, Exception,
+            "Expected numThreads to be at least 1, but got {}.", numThreads);
+
+    m_times = statesTable.getIndependentColumn();
+
+    // Divide the time points into contiguous blocks, one per thread.
+    numThreads = std::min(numThreads, numTimes);
+    const int blockSize = numTimes / numThreads;
+    std::vector<std::future<std::unique_ptr<Worker>>> futures;
+    for (int thread = 0; thread < numThreads; ++thread) {
+        const int begin = thread * blockSize;
+        const int end = (thread == numThreads - 1) ? numTimes
+                                                   : begin + blockSize;
+        // Copy the model on this thread; each worker initializes its own copy.
+        futures.push_back(std::async(std::launch::async,
+                [&, begin, end](Model modelCopy) {
+                    return std::unique_ptr<Worker>(new Worker(
+                            std::move(modelCopy), statesTable, controlsTable,
+                            discreteVariablesTable, begin, end));
+                },
+                model));
+    }
+    for (auto& future : futures) {
+        m_workers.push_back(future.get());
+    }
+}
+
+TrajectoryAnalyzer::~TrajectoryAnalyzer() = default;
+TrajectoryAnalyzer::TrajectoryAnalyzer(TrajectoryAnalyzer&&) = default;
+TrajectoryAnalyzer& TrajectoryAnalyzer::operator=(
+        TrajectoryAnalyzer&&) = default;
+
+int TrajectoryAnalyzer::getNumThreads() const {
+    return (int)m_workers.size();
+}
+
+TrajectoryAnalyzer::Results TrajectoryAnalyzer::analyze(
+        const std::vector<std::string>& outputPaths) {
+
+    // Compile the regular expressions once, and find the path names of all
+    // matching Outputs whose type is supported.
+    std::vector<std::regex> regexes;
+    regexes.reserve(outputPaths.size());
+    for (const auto& path : outputPaths) { regexes.emplace_back(path); }
+    std::unordered_set<std::string> outputPathNames;
+    forEachOutput(m_workers[0]->model, [&](const AbstractOutput& output) {
+        const std::string pathName = output.getPathName();
+        for (const auto& regex : regexes) {
+            if (!std::regex_match(pathName, regex)) continue;
+            if (dynamic_cast<const Output<double>*>(&output) ||
+                    dynamic_cast<const Output<SimTK::Vec3>*>(&output) ||
+                    dynamic_cast<const Output<SimTK::SpatialVec>*>(&output)) {
+                log_debug("Adding output {} of type {}.", pathName,
+                        output.getTypeName());
+                outputPathNames.insert(pathName);
+            } else {
+                log_warn("Ignoring output {} of type {}.", pathName,
+                        output.getTypeName());
+            }
+            break;
+        }
+    });
+    for (auto& worker : m_workers) { worker->resolve(outputPathNames); }
+
+    const auto& first = *m_workers[0];
+    const int numTimes = getNumTimes();
+    SimTK::Matrix scalarValues(numTimes, (int)first.scalars.size());
+    SimTK::Matrix_<SimTK::Vec3> vec3Values(numTimes, (int)first.vec3s.size());
+    SimTK::Matrix_<SimTK::SpatialVec> spatialVecValues(
+            numTimes, (int)first.spatialVecs.size());
+
+    if (m_workers.size() == 1) {
+        m_workers[0]->evaluate(scalarValues, vec3Values, spatialVecValues);
+    } else {
+        // Each worker fills a separate block of rows.
+        std::vector<std::future<void>> futures;
+        for (auto& worker : m_workers) {
+            Worker* w = worker.get();
+            futures.push_back(std::async(std::launch::async, [&, w]() {
+                w->evaluate(scalarValues, vec3Values, spatialVecValues);
+            }));
+        }
+        for (auto& future : futures) { future.get(); }
+    }
+
+    Results results;
+    results.scalars = TimeSeriesTable(m_times, scalarValues,
+            createLabels<double>(first.scalars));
+    results.vec3s = TimeSeriesTableVec3(m_times, vec3Values,
+            createLabels<SimTK::Vec3>(first.vec3s));
+    results.spatialVecs = TimeSeriesTable_<SimTK::SpatialVec>(m_times,
+            spatialVecValues, createLabels<SimTK::SpatialVec>(
+                                      first.spatialVecs));
+    return results;
+}
@@ -0,0 +1,118 @@
+#ifndef OPENSIM_TRAJECTORY_ANALYZER_H_
+#define OPENSIM_TRAJECTORY_ANALYZER_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  TrajectoryAnalyzer.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+
+#include <OpenSim/Common/TimeSeriesTable.h>
+
+#include <memory>
+
+namespace OpenSim {
+
+class Model;
+
+/** Compute the values of model Output%s along a trajectory of states and
+controls. This class provides the same results as analyze(), but is intended
+for computing many different Output%s along the same trajectory: the model
+is copied, initialized, and the states, controls, and discrete variables for
+every time point are constructed only once, when the analyzer is
+constructed. Each call to analyze() then only realizes each time point to the
+highest stage required by the requested Output%s and evaluates them.
+Realization results are kept in the stored states, so subsequent calls that
+require the same (or a lower) stage do not realize the model again.
+
+A single call to analyze() evaluates Output%s of type double, SimTK::Vec3,
+and SimTK::SpatialVec (including all channels of list Output%s), and returns a
+table for each type. Output%s of other types are ignored with a warning.
+
+@code{.cpp}
+TrajectoryAnalyzer analyzer(model, statesTable, controlsTable);
+auto results = analyzer.analyze({".*\\|tendon_force", ".*\\|com_position"});
+TimeSeriesTable tendonForces = results.scalars;
+TimeSeriesTableVec3 comPositions = results.vec3s;
+auto fiberLengths = analyzer.analyze({".*\\|fiber_length"}).scalars;
+@endcode
+
+Parallelization
+---------------
+If `numThreads` is greater than 1, the time points are divided into
+contiguous blocks, one per thread, and each thread owns a separate copy of
+the model. The rows of the resulting tables are always in the same order as
+the rows of the states table. Make sure custom components are threadsafe if
+you use more than one thread.
+
+@ingroup simulationutil */
+class OSIMSIMULATION_API TrajectoryAnalyzer {
+public:
+    /// The results of analyze(), one table per Output type.
+    struct Results {
+        TimeSeriesTable scalars;
+        TimeSeriesTableVec3 vec3s;
+        TimeSeriesTable_<SimTK::SpatialVec> spatialVecs;
+    };
+
+    /// @param model The model is copied, so later changes to the provided
+    ///     model do not affect this analyzer.
+    /// @param statesTable The state variable trajectories (see
+    ///     StatesTrajectory::createFromStatesTable()).
+    /// @param controlsTable The control trajectories, with column labels
+    ///     that are control names (see createSystemControlIndexMap()). This
+    ///     table must have the same number of rows as `statesTable`, or have
+    ///     no columns, in which case all controls are zero.
+    /// @param discreteVariablesTable Optional discrete variable values with
+    ///     column labels of the form `<path_to_component>/<discrete_var_name>`.
+    /// @param numThreads The number of threads to use when evaluating
+    ///     Output%s.
+    TrajectoryAnalyzer(const Model& model, const TimeSeriesTable& statesTable,
+            const TimeSeriesTable& controlsTable = {},
+            const TimeSeriesTable& discreteVariablesTable = {},
+            int numThreads = 1);
+    ~TrajectoryAnalyzer();
+
+    TrajectoryAnalyzer(const TrajectoryAnalyzer&) = delete;
+    TrajectoryAnalyzer& operator=(const TrajectoryAnalyzer&) = delete;
+    TrajectoryAnalyzer(TrajectoryAnalyzer&&);
+    TrajectoryAnalyzer& operator=(TrajectoryAnalyzer&&);
+
+    /// The number of time points in the trajectory.
+    int getNumTimes() const { return (int)m_times.size(); }
+
+    /// The number of threads used to evaluate Output%s.
+    int getNumThreads() const;
+
+    /// Compute the values of all Output%s whose path names (e.g.,
+    /// `/forceset/soleus|tendon_force`) match one of the provided regular
+    /// expressions. Each regular expression is compiled once.
+    Results analyze(const std::vector<std::string>& outputPaths);
+
+private:
+    class Worker;
+    std::vector<double> m_times;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TRAJECTORY_ANALYZER_H_
@@ -42,11 +42,13 @@
 #include "Model/ElasticFoundationForce.h"
 #include "Model/HuntCrossleyForce.h"
 #include "Model/SmoothSphereHalfSpaceForce.h"
+#include "Model/SmoothSphereHalfSpaceForceGroup.h"
 #include "Model/Ligament.h"
 #include "Model/Blankevoort1991Ligament.h"
 #include "Model/JointSet.h"
 #include "Model/Marker.h"
 #include "Model/Station.h"
+#include "Model/StationKinematics.h"
 #include "Model/MarkerSet.h"
 #include "Model/PathPoint.h"
 #include "Model/PathPointSet.h"
@@ -65,6 +67,7 @@
 #include "Model/CoordinateLimitForce.h"
 #include "Model/ExternalLoads.h"
 #include "Model/PathActuator.h"
+#include "Model/MuscleBank.h"
 #include "Model/ActuatorPowerProbe.h"
 #include "Model/JointInternalPowerProbe.h"
 #include "Model/MuscleActiveFiberPowerProbe.h"
@@ -132,6 +135,7 @@
 #include "OpenSense/OpenSenseUtilities.h"
 #include "OpenSense/IMU.h"
 #include "SimulationUtilities.h"
+#include "TrajectoryAnalyzer.h"
 
 #include "RegisterTypes_osimSimulation.h"   // to expose RegisterTypes_osimSimulation
 
@@ -29,6 +29,7 @@
 // INCLUDES
 //==============================================================================
 #include "ActuatorForceTargetFast.h"
+#include "CMC_Joint.h"
 #include "CMC_TaskSet.h"
 #include "CMC.h"
 #include "StateTrackingTask.h"
@@ -132,11 +133,18 @@ prepareToOptimize(SimTK::State& s, double *x)
 
     computeConstraintVector(s, f, _constraintVector);
 
-    for (int j = 0; j < na; j++) {
-        f[j] = 1;
-        computeConstraintVector(s, f, c);
-        _constraintMatrix(j) = (c - _constraintVector);
-        f[j] = 0;
+    // The constraints are linear in the actuator forces. If possible, compute
+    // the constraint matrix from the accelerations due to each actuator
+    // alone, which does not require realizing the whole system for each
+    // actuator.
+    if (!_useOnePassConstraintMatrix ||
+            !computeConstraintMatrixFromCoordinateTasks(s)) {
+        for (int j = 0; j < na; j++) {
+            f[j] = 1;
+            computeConstraintVector(s, f, c);
+            _constraintMatrix(j) = (c - _constraintVector);
+            f[j] = 0;
+        }
     }
 #endif
 
@@ -166,11 +174,222 @@ prepareToOptimize(SimTK::State& s, double *x)
 
         _recipOptForceSquared[i] = 1.0 / (fOpt*fOpt);   
     }
-    
+
+#ifdef USE_LINEAR_CONSTRAINT_MATRIX
+    if (_useActiveSetSolver && solveWithActiveSet(x)) return true;
+#endif
+
+    // Warm start the optimizer from the previous solution, within the new
+    // bounds.
+    if (getHasLimits()) {
+        double *lowerBounds, *upperBounds;
+        getParameterLimits(&lowerBounds, &upperBounds);
+        for (int i = 0; i < na; ++i) {
+            x[i] = SimTK::clamp(lowerBounds[i], x[i], upperBounds[i]);
+        }
+    }
+
     // return false to indicate that we still need to proceed with optimization (did not do a lapack direct solve)
     return false;
 }
 
+//______________________________________________________________________________
+/**
+ * Compute the constraint matrix from the generalized accelerations caused by
+ * a unit force of each actuator, if all active tasks track coordinates.
+ * The actuator forces are computed from a single realization of the system,
+ * and the accelerations are computed with the forward dynamics operator of
+ * the matter subsystem, which ignores all other forces. That operator also
+ * ignores constraints (including locked and prescribed coordinates), so this
+ * is only done if the model has no enabled constraints.
+ *
+ * @return False if the constraint matrix could not be computed this way.
+ */
+bool ActuatorForceTargetFast::
+computeConstraintMatrixFromCoordinateTasks(const SimTK::State& s)
+{
+    const Model& model = _controller->getModel();
+    const SimTK::SimbodyMatterSubsystem& matter = model.getMatterSubsystem();
+    CMC_TaskSet& taskSet = _controller->updTaskSet();
+
+    for (SimTK::ConstraintIndex c(0); c < matter.getNumConstraints(); ++c) {
+        if (!matter.getConstraint(c).isDisabled(s)) return false;
+    }
+
+    // Index of the generalized speed whose acceleration is each constraint.
+    std::vector<int> uIndices;
+    for (int i = 0; i < taskSet.getSize(); ++i) {
+        const auto* task = dynamic_cast<const CMC_Task*>(&taskSet.get(i));
+        if (!task) continue;
+        for (int j = 0; j < 3; ++j) {
+            if (!task->getActive(j)) continue;
+            const auto* joint = dynamic_cast<const CMC_Joint*>(task);
+            if (!joint || j != 0) return false;
+            const Coordinate& coord =
+                    model.getCoordinateSet().get(joint->getCoordinateName());
+            uIndices.push_back(matter.getMobilizedBody(coord.getBodyIndex())
+                                       .getFirstUIndex(s) +
+                               coord.getMobilizerQIndex());
+        }
+    }
+    if ((int)uIndices.size() != getNumConstraints()) return false;
+
+    // Realize a state in which every actuator applies a unit force.
+    const int na = _controller->getNumActuators();
+    const auto& socket = _controller->getSocket<Actuator>("actuators");
+    SimTK::State unitState = s;
+    for (int j = 0; j < na; ++j) {
+        auto act = dynamic_cast<const ScalarActuator*>(&socket.getConnectee(j));
+        act->overrideActuation(unitState, true);
+        act->setOverrideActuation(unitState, 1.0);
+    }
+    model.getMultibodySystem().realize(unitState, SimTK::Stage::Dynamics);
+
+    const SimTK::GeneralForceSubsystem& forces = model.getForceSubsystem();
+    Vector mobilityForces(unitState.getNU(), 0.0);
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies(),
+            SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0)));
+    SimTK::Vector_<SimTK::Vec3> particleForces;
+    Vector udot0, udot;
+    SimTK::Vector_<SimTK::SpatialVec> bodyAccelerations;
+    matter.calcAcceleration(unitState, mobilityForces, bodyForces, udot0,
+            bodyAccelerations);
+
+    const Array<double>& w = taskSet.getWeights();
+    for (int j = 0; j < na; ++j) {
+        forces.getForce(socket.getConnectee(j).getForceIndex())
+                .calcForceContribution(unitState, bodyForces, particleForces,
+                        mobilityForces);
+        matter.calcAcceleration(unitState, mobilityForces, bodyForces, udot,
+                bodyAccelerations);
+        for (int i = 0; i < (int)uIndices.size(); ++i) {
+            _constraintMatrix(i, j) = -w[i] * (udot[uIndices[i]] -
+                                               udot0[uIndices[i]]);
+        }
+    }
+    return true;
+}
+
+//______________________________________________________________________________
+/**
+ * Solve the quadratic program (minimize the weighted sum of squared actuator
+ * forces subject to the linear acceleration constraints and the force bounds)
+ * with a primal active-set method. The method starts from the bounds that
+ * were active in the previous solution, so that usually only a few
+ * iterations are needed from one time window to the next.
+ *
+ * @param x Solution, if successful.
+ * @return False if the method did not converge to a feasible solution.
+ */
+bool ActuatorForceTargetFast::
+solveWithActiveSet(double *x)
+{
+    // The objective must be the sum of squared (weighted) forces.
+    const CMC_TaskSet& taskSet = _controller->getTaskSet();
+    for (int t = 0; t < taskSet.getSize(); ++t) {
+        if (dynamic_cast<const StateTrackingTask*>(&taskSet.get(t))) {
+            return false;
+        }
+    }
+
+    if (!getHasLimits()) return false;
+
+    const int na = _controller->getNumActuators();
+    const int nc = getNumConstraints();
+    double *lower, *upper;
+    getParameterLimits(&lower, &upper);
+
+    // Objective: 0.5 * sum_i h_i f_i^2.
+    const auto& socket = _controller->getSocket<Actuator>("actuators");
+    Vector h(na);
+    for (int i = 0; i < na; ++i) {
+        const bool isMuscle =
+                dynamic_cast<const Muscle*>(&socket.getConnectee(i)) != nullptr;
+        h[i] = 2.0 * (isMuscle ? _recipOptForceSquared[i]
+                               : _recipAreaSquared[i]);
+    }
+    // Constraints: A f = b.
+    const Matrix& A = _constraintMatrix;
+    const Vector b = -_constraintVector;
+
+    if ((int)_activeSet.size() != na) _activeSet.assign(na, 0);
+    std::vector<int>& active = _activeSet;
+    for (int i = 0; i < na; ++i) {
+        if (lower[i] >= upper[i]) active[i] = -1;
+    }
+
+    Vector f(na), lambda(nc), AtLambda(na);
+    const int maxIterations = 3 * na + 10;
+    for (int iter = 0; iter < maxIterations; ++iter) {
+        // Solve for the multipliers of the equality constraints with the
+        // forces that are not at a bound:
+        //     (A_F H_F^-1 A_F^T) lambda = b - A_X f_X.
+        Vector rhs = b;
+        Matrix M(nc, nc, 0.0);
+        for (int i = 0; i < na; ++i) {
+            if (active[i] == 0) {
+                for (int r = 0; r < nc; ++r) {
+                    const double Ari = A(r, i) / h[i];
+                    for (int c = 0; c < nc; ++c) M(r, c) += Ari * A(c, i);
+                }
+            } else {
+                f[i] = active[i] < 0 ? lower[i] : upper[i];
+                for (int r = 0; r < nc; ++r) rhs[r] -= A(r, i) * f[i];
+            }
+        }
+        SimTK::FactorLU lu(M);
+        if (lu.isSingular()) break;
+        lu.solve(rhs, lambda);
+        AtLambda = ~A * lambda;
+
+        // Fix the free force that violates its bounds the most.
+        int worst = -1;
+        double worstViolation = 0;
+        for (int i = 0; i < na; ++i) {
+            if (active[i] != 0) continue;
+            f[i] = AtLambda[i] / h[i];
+            const double tol = 1e-10 * (1.0 + std::abs(f[i]));
+            const double violation = std::max(lower[i] - f[i], f[i] - upper[i]);
+            if (violation > tol && violation > worstViolation) {
+                worst = i;
+                worstViolation = violation;
+            }
+        }
+        if (worst >= 0) {
+            active[worst] = f[worst] < lower[worst] ? -1 : 1;
+            continue;
+        }
+
+        // Release the bound whose multiplier has the wrong sign the most.
+        double worstMultiplier = 0;
+        for (int i = 0; i < na; ++i) {
+            if (active[i] == 0 || lower[i] >= upper[i]) continue;
+            const double hf = h[i] * f[i];
+            const double multiplier =
+                    active[i] < 0 ? hf - AtLambda[i] : AtLambda[i] - hf;
+            const double tol = 1e-10 * (std::abs(hf) + std::abs(AtLambda[i]));
+            if (multiplier < -tol && multiplier < worstMultiplier) {
+                worst = i;
+                worstMultiplier = multiplier;
+            }
+        }
+        if (worst >= 0) {
+            active[worst] = 0;
+            continue;
+        }
+
+        // Optimal; check that the accelerations are achieved.
+        const Vector residual = A * f - b;
+        if (residual.normInf() > 1e-6 * (1.0 + b.normInf())) break;
+        for (int i = 0; i < na; ++i) x[i] = f[i];
+        return true;
+    }
+
+    // Start from scratch in the next time window.
+    _activeSet.assign(na, 0);
+    return false;
+}
+
 //==============================================================================
 // SET AND GET
 //==============================================================================
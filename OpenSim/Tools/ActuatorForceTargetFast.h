@@ -34,6 +34,7 @@
 //==============================================================================
 #include "osimToolsDLL.h"
 #include <OpenSim/Common/OptimizationTarget.h>
+#include <vector>
 
 namespace OpenSim {
 
@@ -90,6 +91,17 @@ private:
 
     SimTK::Matrix _constraintMatrix;
     SimTK::Vector _constraintVector;
+
+    /** Whether to solve the quadratic program directly with an active-set
+    method instead of with the optimizer. */
+    bool _useActiveSetSolver{false};
+    /** Whether to compute the constraint matrix from a single realization of
+    the system when possible. */
+    bool _useOnePassConstraintMatrix{true};
+    /** Bounds at which the actuator forces were in the previous solution
+    (-1: lower bound, 0: between the bounds, 1: upper bound). Used to warm
+    start the active-set method. */
+    std::vector<int> _activeSet;
     
     // Save a (copy) of the state for state tracking purposes
     SimTK::State    _saveState;
@@ -110,6 +122,24 @@ public:
 
     bool prepareToOptimize(SimTK::State& s, double *x) override;
 
+    /** Solve for the actuator forces directly with an active-set method for
+    the quadratic program, warm-started from the bounds that were active in
+    the previous time window. prepareToOptimize() falls back to the
+    optimizer if the active-set method fails or if there are state tracking
+    tasks. */
+    void setUseActiveSetSolver(bool useActiveSetSolver)
+    {   _useActiveSetSolver = useActiveSetSolver; }
+    bool getUseActiveSetSolver() const { return _useActiveSetSolver; }
+
+    /** Compute the constraint matrix from a single realization of the system
+    if all active tasks track coordinate accelerations and the model has no
+    enabled constraints (default: true). Otherwise, the system is realized
+    once per actuator. The results are the same. */
+    void setUseOnePassConstraintMatrix(bool useOnePassConstraintMatrix)
+    {   _useOnePassConstraintMatrix = useOnePassConstraintMatrix; }
+    bool getUseOnePassConstraintMatrix() const
+    {   return _useOnePassConstraintMatrix; }
+
     //--------------------------------------------------------------------------
     // REQUIRED OPTIMIZATION TARGET METHODS
     //--------------------------------------------------------------------------
@@ -120,6 +150,8 @@ public:
     CMC* getController() {return (_controller); }
 private:
     void computeConstraintVector(SimTK::State& s, const SimTK::Vector &x, SimTK::Vector &c) const;
+    bool computeConstraintMatrixFromCoordinateTasks(const SimTK::State& s);
+    bool solveWithActiveSet(double *x);
 
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 };  // END class ActuatorForceTargetFast
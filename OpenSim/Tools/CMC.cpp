@@ -32,6 +32,7 @@
 #include "CMC.h"
 #include "VectorFunctionForActuators.h"
 #include <OpenSim/Common/RootSolver.h>
+#include <OpenSim/Common/Stopwatch.h>
 #include <OpenSim/Simulation/Control/ControlConstant.h>
 #include <OpenSim/Simulation/Control/ControlLinear.h>
 #include <OpenSim/Tools/CMC_Joint.h>
@@ -50,6 +51,20 @@ using namespace SimTK;
 #define MAX_CMC_CONTROL_VALUE 1.00
 
 #define MAX_CONTROLS_FOR_RRA 10000
+
+namespace {
+    /// Column labels of the storage of timings of CMC::computeControls().
+    Array<string> getTimingLabels() {
+        Array<string> labels;
+        labels.append("time");
+        labels.append("tasks");
+        labels.append("force_bounds");
+        labels.append("optimization");
+        labels.append("root_solve");
+        labels.append("total");
+        return labels;
+    }
+}
 // Excluding this from Doxygen until it has better documentation! -Sam Hamner
     /// @cond
 class ComputeControlsEventHandler : public PeriodicEventHandler {
@@ -138,6 +153,8 @@ CMC::CMC(Model *aModel,CMC_TaskSet *aTaskSet) :
     _vErrStore.reset(new Storage(1000,"VelocityErrors"));
     _pErrStore->setColumnLabels(labels);
     _stressTermWeightStore.reset(new Storage(1000,"StressTermWeight"));
+    _timingStore.reset(new Storage(1000,"Timing"));
+    _timingStore->setColumnLabels(getTimingLabels());
 }
 
 void CMC::copyData( const CMC &aCmc ) 
@@ -150,6 +167,7 @@ void CMC::copyData( const CMC &aCmc )
    _pErrStore             = aCmc._pErrStore;
    _vErrStore             = aCmc._vErrStore;
    _stressTermWeightStore = aCmc._stressTermWeightStore;
+   _timingStore           = aCmc._timingStore;
    _controlSet            = aCmc._controlSet;
    _taskSet               = aCmc._taskSet;
    _paramList             = aCmc._paramList;
@@ -201,6 +219,7 @@ setNull()
     _pErrStore.reset();
     _vErrStore.reset();
     _stressTermWeightStore.reset();
+    _timingStore.reset();
     _useCurvatureFilter = false;
     _verbose = false;
     _paramList.setSize(0);
@@ -486,6 +505,20 @@ getStressTermWeightStorage() const
 {
     return(_stressTermWeightStore.get());
 }
+//_____________________________________________________________________________
+/**
+ * Get the storage object for the wall-clock time (in seconds) spent in each
+ * phase of computing the controls for a time window: computing the task
+ * errors and desired accelerations, computing the bounds on the actuator
+ * forces, solving for the actuator forces, and solving for the controls.
+ *
+ * @return Storage of timings.
+ */
+Storage* CMC::
+getTimingStorage() const
+{
+    return(_timingStore.get());
+}
 
 
 //=============================================================================
@@ -711,6 +744,11 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
 
     int i,j;
 
+    // Wall-clock time spent in each phase, in seconds.
+    Stopwatch totalWatch;
+    Stopwatch phaseWatch;
+    double timing[5];
+
     // TURN ANALYSES OFF
     _model->updAnalysisSet().setOn(false);
 
@@ -830,6 +868,8 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
         for(i=0;i<vErr.getSize();i++) err[i] = vErr[i];
         _stressTermWeightStore->append(tiReal,1,&stressTermWeight);
     }
+    timing[0] = phaseWatch.getElapsedTime();
+    phaseWatch.reset();
 
     // SET BOUNDS ON CONTROLS
     int N = _predictor->getNX();
@@ -900,6 +940,8 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
     }
 
     _target->setParameterLimits(lowerBounds, upperBounds);
+    timing[1] = phaseWatch.getElapsedTime();
+    phaseWatch.reset();
 
     // OPTIMIZER ERROR TRAP
     _f.setSize(N);
@@ -931,6 +973,8 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
     } else {
         // Got a direct solution, don't need to run optimizer
     }
+    timing[2] = phaseWatch.getElapsedTime();
+    phaseWatch.reset();
 
     if(_verbose) _target->printPerformance(&_f[0]);
 
@@ -947,6 +991,7 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
     Array<double> fErrors(0.0,N);
     Array<double> controls(0.0,N);
     controls = rootSolver.solve(s, xmin,xmax,tol);
+    timing[3] = phaseWatch.getElapsedTime();
     if(_verbose) {
         log_info("CMC::computeControls, root solve (tFinal = {}):", _tf);
         log_info(" -- controls = {}", _tf, controls);
@@ -959,6 +1004,12 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
     // SET EXCITATIONS
     controlSet.setControlValues(_tf,&controls[0]);
 
+    timing[4] = totalWatch.getElapsedTime();
+    _timingStore->append(tiReal,5,timing);
+    log_debug("CMC::computeControls, t = {}: tasks {} s, force bounds {} s, "
+            "optimization {} s, root solve {} s, total {} s.", tiReal,
+            timing[0], timing[1], timing[2], timing[3], timing[4]);
+
     _model->updAnalysisSet().setOn(true);
 }
 
@@ -1126,6 +1177,8 @@ void CMC::extendConnectToModel(Model& model)
     _vErrStore.reset(new Storage(1000,"VelocityErrors"));
     _pErrStore->setColumnLabels(labels);
     _stressTermWeightStore.reset(new Storage(1000,"StressTermWeight"));
+    _timingStore.reset(new Storage(1000,"Timing"));
+    _timingStore->setColumnLabels(getTimingLabels());
 
 }
 // for adding any components to the model
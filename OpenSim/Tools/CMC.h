@@ -118,6 +118,9 @@ protected:
     std::shared_ptr<Storage> _vErrStore;
     /** Storage object for the stress term weight. */
     std::shared_ptr<Storage> _stressTermWeightStore;
+    /** Storage object for the wall-clock time spent in each phase of
+    computing the controls for a time window. */
+    std::shared_ptr<Storage> _timingStore;
 
     ControlSet _controlSet;
     /** List of parameters in the control set that are serving as the
@@ -176,6 +179,7 @@ public:
     Storage* getPositionErrorStorage() const;
     Storage* getVelocityErrorStorage() const;
     Storage* getStressTermWeightStorage() const;
+    Storage* getTimingStorage() const;
     bool getUseReflexes() const;
     void setUseVerbosePrinting(bool aTrueFalse);
     bool getUseVerbosePrinting() const;
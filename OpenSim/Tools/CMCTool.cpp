@@ -71,6 +71,8 @@ CMCTool::CMCTool() :
     _targetDT(_targetDTProp.getValueDbl()),          
     //_useCurvatureFilter(_useCurvatureFilterProp.getValueBool()),
     _useFastTarget(_useFastTargetProp.getValueBool()),
+    _useActiveSetSolver(_useActiveSetSolverProp.getValueBool()),
+    _useOnePassConstraintMatrix(_useOnePassConstraintMatrixProp.getValueBool()),
     _optimizerAlgorithm(_optimizerAlgorithmProp.getValueStr()),
     _numericalDerivativeStepSize(_numericalDerivativeStepSizeProp.getValueDbl()),
     _optimizationConvergenceTolerance(_optimizationConvergenceToleranceProp.getValueDbl()),
@@ -101,6 +103,8 @@ CMCTool::CMCTool(const string &aFileName, bool aLoadModel) :
     _targetDT(_targetDTProp.getValueDbl()),          
     //_useCurvatureFilter(_useCurvatureFilterProp.getValueBool()),
     _useFastTarget(_useFastTargetProp.getValueBool()),
+    _useActiveSetSolver(_useActiveSetSolverProp.getValueBool()),
+    _useOnePassConstraintMatrix(_useOnePassConstraintMatrixProp.getValueBool()),
     _optimizerAlgorithm(_optimizerAlgorithmProp.getValueStr()),
     _numericalDerivativeStepSize(_numericalDerivativeStepSizeProp.getValueDbl()),
     _optimizationConvergenceTolerance(_optimizationConvergenceToleranceProp.getValueDbl()),
@@ -171,6 +175,8 @@ CMCTool(const CMCTool &aTool) :
     _targetDT(_targetDTProp.getValueDbl()),          
     //_useCurvatureFilter(_useCurvatureFilterProp.getValueBool()),
     _useFastTarget(_useFastTargetProp.getValueBool()),
+    _useActiveSetSolver(_useActiveSetSolverProp.getValueBool()),
+    _useOnePassConstraintMatrix(_useOnePassConstraintMatrixProp.getValueBool()),
     _optimizerAlgorithm(_optimizerAlgorithmProp.getValueStr()),
     _numericalDerivativeStepSize(_numericalDerivativeStepSizeProp.getValueDbl()),
     _optimizationConvergenceTolerance(_optimizationConvergenceToleranceProp.getValueDbl()),
@@ -203,6 +209,8 @@ setNull()
     _targetDT = 0.010;           
     //_useCurvatureFilter = false;       
     _useFastTarget = true;
+    _useActiveSetSolver = false;
+    _useOnePassConstraintMatrix = true;
     _optimizerAlgorithm = "ipopt";
     _numericalDerivativeStepSize = 1.0e-4;
     _optimizationConvergenceTolerance = 1.0e-4;
@@ -295,6 +303,24 @@ void CMCTool::setupProperties()
     _useFastTargetProp.setName("use_fast_optimization_target");          
     _propertySet.append( &_useFastTargetProp );
 
+    comment = "Flag (true or false) indicating whether the fast optimization target ";
+    comment += "solves for the actuator forces directly with an active-set method ";
+    comment += "that is warm started from the previous time window. If the method ";
+    comment += "fails, the optimizer is used. Ignored if use_fast_optimization_target ";
+    comment += "is false or if there are state tracking tasks.";
+    _useActiveSetSolverProp.setComment(comment);
+    _useActiveSetSolverProp.setName("use_active_set_solver");
+    _propertySet.append( &_useActiveSetSolverProp );
+
+    comment = "Flag (true or false) indicating whether the fast optimization target ";
+    comment += "computes its constraint matrix from a single realization of the ";
+    comment += "system when all tasks track coordinate accelerations and the model ";
+    comment += "has no enabled constraints. If false, the system is realized once per ";
+    comment += "actuator. Ignored if use_fast_optimization_target is false.";
+    _useOnePassConstraintMatrixProp.setComment(comment);
+    _useOnePassConstraintMatrixProp.setName("use_one_pass_constraint_matrix");
+    _propertySet.append( &_useOnePassConstraintMatrixProp );
+
     comment = "Preferred optimizer algorithm (currently support \"ipopt\" or \"cfsqp\", "
                  "the latter requiring the osimCFSQP library.";
     _optimizerAlgorithmProp.setComment(comment);
@@ -362,6 +388,8 @@ operator=(const CMCTool &aTool)
     _numericalDerivativeStepSize = aTool._numericalDerivativeStepSize;
     _optimizationConvergenceTolerance = aTool._optimizationConvergenceTolerance;
     _useFastTarget = aTool._useFastTarget;
+    _useActiveSetSolver = aTool._useActiveSetSolver;
+    _useOnePassConstraintMatrix = aTool._useOnePassConstraintMatrix;
     _optimizerAlgorithm = aTool._optimizerAlgorithm;
     _maxIterations = aTool._maxIterations;
     _printLevel = aTool._printLevel;
@@ -701,7 +729,10 @@ bool CMCTool::run()
     // Optimization target
     OptimizationTarget *target = NULL;
     if(_useFastTarget) {
-        target = new ActuatorForceTargetFast(s, na,controller);
+        auto fastTarget = new ActuatorForceTargetFast(s, na,controller);
+        fastTarget->setUseActiveSetSolver(_useActiveSetSolver);
+        fastTarget->setUseOnePassConstraintMatrix(_useOnePassConstraintMatrix);
+        target = fastTarget;
     } else {
         target = new ActuatorForceTarget(na,controller);
     }
@@ -882,6 +913,7 @@ bool CMCTool::run()
     statesDegrees.print(getResultsDir() + "/" + getName() + "_states_degrees.mot");
     */
     controller->getPositionErrorStorage()->print(getResultsDir() + "/" + getName() + "_pErr.sto");
+    controller->getTimingStorage()->print(getResultsDir() + "/" + getName() + "_timing.sto");
 
     //_model->removeController(controller); // So that if this model is from GUI it doesn't double-delete it.
 
@@ -103,6 +103,18 @@ private:
     PropertyBool _useFastTargetProp;         
     bool &_useFastTarget;
 
+    /** Flag indicating whether the fast target should solve for the
+    actuator forces directly with an active-set method, warm started from
+    the previous time window, before falling back to the optimizer. */
+    PropertyBool _useActiveSetSolverProp;
+    bool &_useActiveSetSolver;
+
+    /** Flag indicating whether the fast target computes its constraint
+    matrix from a single realization of the system when possible, instead of
+    realizing the system once per actuator. */
+    PropertyBool _useOnePassConstraintMatrixProp;
+    bool &_useOnePassConstraintMatrix;
+
     /** Preferred optimizer algorithm. */
     PropertyStr _optimizerAlgorithmProp;
     std::string &_optimizerAlgorithm;
@@ -193,6 +205,10 @@ public:
     // Target selection
     bool getUseFastTarget() const { return _useFastTarget;};         
     void setUseFastTarget(bool useFastTarget) const {  _useFastTarget=useFastTarget; };
+    bool getUseActiveSetSolver() const { return _useActiveSetSolver; }
+    void setUseActiveSetSolver(bool useActiveSetSolver) const { _useActiveSetSolver = useActiveSetSolver; }
+    bool getUseOnePassConstraintMatrix() const { return _useOnePassConstraintMatrix; }
+    void setUseOnePassConstraintMatrix(bool useOnePassConstraintMatrix) const { _useOnePassConstraintMatrix = useOnePassConstraintMatrix; }
 
     // Verbosity
     bool getUseVerbosePrinting() const {return _verbose;};
@@ -86,6 +86,7 @@ void InverseKinematicsTool::constructProperties()
     constructProperty_marker_file("");
     constructProperty_coordinate_file("");
     constructProperty_report_marker_locations(false);
+    constructProperty_use_sparse_tracking(false);
 }
 
 //=============================================================================
@@ -169,6 +170,7 @@ bool InverseKinematicsTool::run()
         InverseKinematicsSolver ikSolver(*_model, make_shared<MarkersReference>(markersReference),
             coordinateReferences, get_constraint_weight());
         ikSolver.setAccuracy(get_accuracy());
+        ikSolver.setUseSparseTracking(get_use_sparse_tracking());
         s.updTime() = times[start_ix];
         ikSolver.assemble(s);
         kinematicsReporter->begin(s);
@@ -71,6 +71,13 @@ public:
             "Flag indicating whether or not to report model marker locations. "
             "Note, model marker locations are expressed in Ground.");
 
+    OpenSim_DECLARE_PROPERTY(use_sparse_tracking, bool,
+            "Flag indicating whether to solve frames after the first with a "
+            "solver that exploits the sparsity of the kinematic tree, instead "
+            "of the SimTK::Assembler (see "
+            "InverseKinematicsSolver::setUseSparseTracking()). Default is "
+            "false.");
+
 //=============================================================================
 // METHODS
 //=============================================================================
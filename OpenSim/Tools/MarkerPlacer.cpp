@@ -25,11 +25,12 @@
 // INCLUDES
 //=============================================================================
 #include "MarkerPlacer.h"
+#include "ScaleTool.h"
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/Constant.h>
-#include <OpenSim/Common/MarkerData.h>
+#include <OpenSim/Common/TimeSeriesTable.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/MarkersReference.h>
@@ -38,12 +39,122 @@
 #include "IKTaskSet.h"
 #include <OpenSim/Analyses/StatesReporter.h>
 #include <OpenSim/Common/IO.h>
+
+#include <algorithm>
+#include <future>
+#include <thread>
 //=============================================================================
 // STATICS
 //=============================================================================
 using namespace std;
 using namespace OpenSim;
 using SimTK::Vec3;
+
+namespace {
+// The static pose, averaged over the frames in a time range.
+struct StaticPoseAverage {
+    // The average of all frames in the time range, as computed by
+    // TimeSeriesTable::averageRow(); used to solve for the pose.
+    SimTK::RowVector_<Vec3> allFrames;
+    // For each marker, the average of the frames in which the marker is
+    // present, as computed by MarkerData::averageFrames(); the model markers
+    // are moved to these locations.
+    SimTK::RowVector_<Vec3> presentFrames;
+    // For each marker, the largest extent of its motion along any axis.
+    std::vector<double> movement;
+    // The first and last frames averaged for presentFrames.
+    int firstFrame;
+    int lastFrame;
+};
+
+// Average the frames of the table in [startTime, endTime] in a single pass
+// over the data, with each thread averaging a contiguous range of markers.
+StaticPoseAverage averageStaticPose(const TimeSeriesTableVec3& table,
+        double startTime, double endTime, int numThreads) {
+    const auto& times = table.getIndependentColumn();
+    const auto& data = table.getMatrix();
+    const int numFrames = (int)times.size();
+    const int numMarkers = (int)table.getNumColumns();
+    OPENSIM_THROW_IF(endTime <= startTime, InvalidTimeRange, startTime,
+            endTime);
+
+    StaticPoseAverage average;
+    average.allFrames.resize(numMarkers);
+    average.presentFrames.resize(numMarkers);
+    average.movement.resize(numMarkers);
+    // Select the frames as in MarkerData::findFrameRange().
+    average.firstFrame = 0;
+    average.lastFrame = numFrames - 1;
+    for (int i = numFrames - 1; i >= 0; --i) {
+        if (times[i] <= startTime) {
+            average.firstFrame = i;
+            break;
+        }
+    }
+    for (int i = average.firstFrame; i < numFrames; ++i) {
+        if (times[i] >= endTime) {
+            average.lastFrame = i;
+            break;
+        }
+    }
+
+    auto averageMarkers = [&](int begin, int end) {
+        for (int j = begin; j < end; ++j) {
+            Vec3 sumAll(0);
+            int numAll = 0;
+            for (int i = 0; i < numFrames; ++i) {
+                if (times[i] >= startTime && times[i] <= endTime) {
+                    sumAll += data(i, j);
+                    ++numAll;
+                }
+            }
+            average.allFrames[j] = sumAll / numAll;
+
+            Vec3 sumPresent(0);
+            Vec3 min(SimTK::Infinity);
+            Vec3 max(-SimTK::Infinity);
+            int numPresent = 0;
+            for (int i = average.firstFrame; i <= average.lastFrame; ++i) {
+                const Vec3& point = data(i, j);
+                if (point.isNaN()) continue;
+                sumPresent += point;
+                ++numPresent;
+                for (int k = 0; k < 3; ++k) {
+                    min[k] = std::min(min[k], point[k]);
+                    max[k] = std::max(max[k], point[k]);
+                }
+            }
+            average.presentFrames[j] = numPresent
+                    ? sumPresent / numPresent : Vec3(SimTK::NaN);
+            average.movement[j] = numPresent
+                    ? std::max({max[0] - min[0], max[1] - min[1],
+                              max[2] - min[2]})
+                    : 0;
+        }
+    };
+
+    if (numThreads <= 0) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    numThreads = std::max(1, std::min(numThreads, numMarkers));
+    std::vector<std::future<void>> futures;
+    const int blockSize = numMarkers / numThreads;
+    const int remainder = numMarkers % numThreads;
+    int begin = 0;
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        const int end = begin + blockSize + (ithread < remainder ? 1 : 0);
+        if (ithread == numThreads - 1) {
+            averageMarkers(begin, end);
+        } else {
+            futures.push_back(std::async(
+                    std::launch::async, averageMarkers, begin, end));
+        }
+        begin = end;
+    }
+    for (auto& future : futures) future.get();
+    return average;
+}
+} // anonymous namespace
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -121,6 +232,7 @@ void MarkerPlacer::copyData(const MarkerPlacer &aMarkerPlacer)
     _outputMotionFileName = aMarkerPlacer._outputMotionFileName;
     _maxMarkerMovement = aMarkerPlacer._maxMarkerMovement;
     _printResultFiles = aMarkerPlacer._printResultFiles;
+    _numThreads = aMarkerPlacer._numThreads;
 }
 
 //_____________________________________________________________________________
@@ -134,6 +246,7 @@ void MarkerPlacer::setNull()
 
     _printResultFiles = true;
     _moveModelMarkers = true;
+    _numThreads = 1;
 }
 
 //_____________________________________________________________________________
@@ -257,12 +370,32 @@ bool MarkerPlacer::processModel(Model* aModel,
     if (_timeRange[1] > timeCol.back())
         _timeRange[1] = timeCol.back();
 
-    const auto avgRow = staticPoseTable.averageRow(_timeRange[0],
-                                                   _timeRange[1]);
-    for(size_t r = staticPoseTable.getNumRows(); r-- > 0; )
-        staticPoseTable.removeRowAtIndex(r);
-    staticPoseTable.appendRow(_timeRange[0], avgRow);
-    
+    // Read the file once, and average its frames for both solving for the
+    // pose and moving the model markers.
+    const auto average = averageStaticPose(staticPoseTable, _timeRange[0],
+            _timeRange[1], _numThreads);
+    const auto& markerNames = staticPoseTable.getColumnLabels();
+    if (average.lastFrame > average.firstFrame) {
+        if (_maxMarkerMovement > 0.0) {
+            for (int i = 0; i < (int)markerNames.size(); ++i) {
+                if (average.presentFrames[i].isNaN()) {
+                    log_warn("Marker {} is missing in frames {} to {}. "
+                             "Coordinate will be set to NAN.",
+                            markerNames[i], average.firstFrame + 1,
+                            average.lastFrame + 1);
+                } else if (average.movement[i] > _maxMarkerMovement) {
+                    log_warn("Movement of marker {} in {} is {} "
+                             "(threshold = {})",
+                            markerNames[i], _markerFileName,
+                            average.movement[i], _maxMarkerMovement);
+                }
+            }
+        }
+        log_info("Averaged frames from time {} to {} in {} (frames {} to {})",
+                _timeRange[0], _timeRange[1], _markerFileName,
+                average.firstFrame + 1, average.lastFrame + 1);
+    }
+
     OPENSIM_THROW_IF(!staticPoseTable.hasTableMetaDataKey("Units"),
                      Exception,
                      "MarkerPlacer::processModel -- Marker file does not have "
@@ -273,24 +406,30 @@ bool MarkerPlacer::processModel(Model* aModel,
     OPENSIM_THROW_IF(SimTK::isNaN(scaleFactor),
                      Exception,
                      "Model has unspecified units.");
+
+    // Replace the frames of the table with their average.
+    SimTK::Matrix_<Vec3> averageData(1, (int)markerNames.size());
+    averageData.updRow(0) = average.allFrames;
+    TimeSeriesTableVec3 averagedTable(
+            std::vector<double>{_timeRange[0]}, averageData, markerNames);
+    averagedTable.updTableMetaData() = staticPoseTable.getTableMetaData();
+    SimTK::RowVector_<Vec3> staticPose = average.presentFrames;
     if(std::fabs(scaleFactor - 1) >= SimTK::Eps) {
-        for(unsigned r = 0; r < staticPoseTable.getNumRows(); ++r)
-            staticPoseTable.updRowAtIndex(r) *= scaleFactor;
+        averagedTable.updRowAtIndex(0) *= scaleFactor;
+        staticPose *= scaleFactor;
 
         staticPoseUnits = aModel->getLengthUnits();
-        staticPoseTable.removeTableMetaDataKey("Units");
-        staticPoseTable.addTableMetaData("Units",
-                                         staticPoseUnits.getAbbreviation());
+        averagedTable.removeTableMetaDataKey("Units");
+        averagedTable.addTableMetaData("Units",
+                                       staticPoseUnits.getAbbreviation());
     }
-    
-    MarkerData* staticPose = new MarkerData(aPathToSubject + _markerFileName);
-    staticPose->averageFrames(_maxMarkerMovement, _timeRange[0], _timeRange[1]);
-    staticPose->convertToUnits(aModel->getLengthUnits());
 
     /* Delete any markers from the model that are not in the static
      * pose marker file.
      */
-    aModel->deleteUnusedMarkers(staticPose->getMarkerNames());
+    Array<std::string> staticPoseMarkerNames;
+    for (const auto& name : markerNames) staticPoseMarkerNames.append(name);
+    aModel->deleteUnusedMarkers(staticPoseMarkerNames);
 
     // Construct the system and get the working state when done changing the model
     SimTK::State& s = aModel->initSystem();
@@ -299,8 +438,8 @@ bool MarkerPlacer::processModel(Model* aModel,
     // Create references and WeightSets needed to initialize InverseKinemaicsSolver
     Set<MarkerWeight> markerWeightSet;
     _ikTaskSet.createMarkerWeightSet(markerWeightSet); // order in tasks file
-    // MarkersReference takes ownership of marker data (staticPose)
-    std::shared_ptr<MarkersReference> markersReference(new MarkersReference(staticPoseTable, markerWeightSet));
+    // MarkersReference keeps a copy of the averaged static pose
+    std::shared_ptr<MarkersReference> markersReference(new MarkersReference(averagedTable, markerWeightSet));
     SimTK::Array_<CoordinateReference> coordinateReferences;
 
     // Load the coordinate data
@@ -377,7 +516,9 @@ bool MarkerPlacer::processModel(Model* aModel,
      * with the measured markers in the static pose. The model is already in
      * the proper configuration so the coordinates do not need to be changed.
      */
-    if(_moveModelMarkers) moveModelMarkersToPose(s, *aModel, *staticPose);
+    if(_moveModelMarkers) {
+        moveModelMarkersToPose(s, *aModel, markerNames, staticPose);
+    }
 
     _outputStorage.reset();
     // Make a storage file containing the solved states and markers for display in GUI.
@@ -390,6 +531,8 @@ bool MarkerPlacer::processModel(Model* aModel,
     _outputStorage->getStateVector(0)->setTime(s.getTime());
 
     if(_printResultFiles) {
+        std::lock_guard<std::mutex> lock(
+                ScaleTool::getResultFilesMutex());
         auto cwd = IO::CwdChanger::changeTo(aPathToSubject);
 
         if (_outputModelFileNameProp.isValidFileName()) {
@@ -418,19 +561,16 @@ bool MarkerPlacer::processModel(Model* aModel,
 /**
  * Set the local offset of each non-fixed marker so that in the model's
  * current pose the marker coincides with the marker's global position
- * in the passed-in MarkerData.
+ * in the passed-in static pose.
  *
  * @param aModel the model to use
- * @param aPose the static-pose marker cloud to get the marker locations from
+ * @param aMarkerNames the names of the markers in the static pose
+ * @param aPose the averaged static-pose marker locations, in the model's units
  */
 void MarkerPlacer::moveModelMarkersToPose(SimTK::State& s, Model& aModel,
-        MarkerData& aPose) const
+        const std::vector<std::string>& aMarkerNames,
+        const SimTK::RowVector_<Vec3>& aPose) const
 {
-    aPose.averageFrames(0.01);
-    const MarkerFrame &frame = aPose.getFrame(0);
-
-    // const SimbodyEngine& engine = aModel.getSimbodyEngine();
-
     MarkerSet& markerSet = aModel.updMarkerSet();
 
     int i;
@@ -440,17 +580,14 @@ void MarkerPlacer::moveModelMarkersToPose(SimTK::State& s, Model& aModel,
 
         if (!modelMarker.get_fixed())
         {
-            int index = aPose.getMarkerIndex(modelMarker.getName());
-            if (index >= 0)
+            const auto it = std::find(aMarkerNames.begin(), aMarkerNames.end(),
+                    modelMarker.getName());
+            if (it != aMarkerNames.end())
             {
-                Vec3 globalMarker = frame.getMarker(index);
+                const Vec3& globalMarker = aPose[int(it - aMarkerNames.begin())];
                 if (!globalMarker.isNaN())
                 {
-                    Vec3 pt, pt2;
-                    Vec3 globalPt = globalMarker;
-                    double conversionFactor = aPose.getUnits().convertTo(aModel.getLengthUnits());
-                    pt = conversionFactor*globalPt;
-                    pt2 = aModel.getGround().findStationLocationInAnotherFrame(s, pt, modelMarker.getParentFrame());
+                    Vec3 pt2 = aModel.getGround().findStationLocationInAnotherFrame(s, globalMarker, modelMarker.getParentFrame());
                     modelMarker.set_location(pt2);
                 }
                 else
@@ -458,14 +595,14 @@ void MarkerPlacer::moveModelMarkersToPose(SimTK::State& s, Model& aModel,
                     log_warn("Marker {} does not have valid coordinates in "
                              "'{}'. It will not be moved to match location in "
                              "marker file.", 
-                        modelMarker.getName(), aPose.getFileName());
+                        modelMarker.getName(), _markerFileName);
                 }
             }
         }
     }
 
     log_info("Moved markers in model {} to match locations in marker file "
-             "'{}'.", aModel.getName(), aPose.getFileName());
+             "'{}'.", aModel.getName(), _markerFileName);
 }
 
 Storage* MarkerPlacer::getOutputStorage() 
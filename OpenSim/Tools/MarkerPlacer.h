@@ -106,6 +106,8 @@ protected:
     bool _printResultFiles;
     // Whether to move the model markers (set to false if you just want to preview the static pose)
     bool _moveModelMarkers;
+    // Number of threads used to average the frames of the static pose
+    int _numThreads;
 
     // This is cached during processModel() so the GUI can access it.
     mutable SimTK::ResetOnCopy<std::unique_ptr<Storage>> _outputStorage;
@@ -202,6 +204,13 @@ public:
     bool getMoveModelMarkers() { return _moveModelMarkers; }
     void setMoveModelMarkers(bool aMove) { _moveModelMarkers = aMove; }
 
+    /** Set the number of threads used to average the frames of the static
+     * pose (by default, 1). Each thread averages the frames of a subset of
+     * the markers, so this only helps for long static trials. If not
+     * positive, the number of hardware threads is used. */
+    void setNumThreads(int aNumThreads) { _numThreads = aNumThreads; }
+    int getNumThreads() const { return _numThreads; }
+
     Storage *getOutputStorage();
 
 
@@ -209,7 +218,8 @@ private:
     void setNull();
     void setupProperties();
     void moveModelMarkersToPose(SimTK::State& s, Model& aModel,
-            MarkerData& aPose) const;
+            const std::vector<std::string>& aMarkerNames,
+            const SimTK::RowVector_<SimTK::Vec3>& aPose) const;
 //=============================================================================
 };  // END of class MarkerPlacer
 //=============================================================================
@@ -25,6 +25,7 @@
 // INCLUDES
 //=============================================================================
 #include "ModelScaler.h"
+#include "ScaleTool.h"
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Common/MarkerData.h>
 #include <OpenSim/Common/IO.h>
@@ -314,6 +315,8 @@ bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
         aModel->scale(s, theScaleSet, _preserveMassDist, aSubjectMass);
 
         if(_printResultFiles) {
+            std::lock_guard<std::mutex> lock(
+                    ScaleTool::getResultFilesMutex());
             auto cwd = IO::CwdChanger::changeTo(aPathToSubject);
 
             if (_outputModelFileNameProp.isValidFileName()) {
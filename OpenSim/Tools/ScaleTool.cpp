@@ -26,9 +26,15 @@
 //=============================================================================
 #include "ScaleTool.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/Stopwatch.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include "GenericModelMaker.h"
 
+#include <atomic>
+#include <future>
+#include <map>
+#include <thread>
+
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -260,10 +266,14 @@ bool ScaleTool::run() const {
         throw Exception(msg, __FILE__, __LINE__);
     }
 
+    return processModel(model.get());
+}
+
+bool ScaleTool::processModel(Model* model) const {
     if (!isDefaultModelScaler() && getModelScaler().getApply())
     {
         const ModelScaler& scaler = getModelScaler();
-        if(!scaler.processModel(model.get(), getPathToSubject(), getSubjectMass())) {
+        if(!scaler.processModel(model, getPathToSubject(), getSubjectMass())) {
             return false;
         }
     }
@@ -276,7 +286,7 @@ bool ScaleTool::run() const {
     if (!isDefaultMarkerPlacer())
     {
         const MarkerPlacer& placer = getMarkerPlacer();
-        if(!placer.processModel(model.get(), getPathToSubject())) {
+        if(!placer.processModel(model, getPathToSubject())) {
             return false;
         }
     }
@@ -287,3 +297,104 @@ bool ScaleTool::run() const {
     }
     return true;
 }
+
+std::vector<ScaleTool::BatchResult> ScaleTool::runBatch(
+        const std::vector<std::string>& setupFiles, int numThreads) {
+    std::vector<BatchResult> results(setupFiles.size());
+
+    // Read all setup files, and load each generic model once.
+    // -------------------------------------------------------
+    // The subjects are scaled concurrently, so their files must not depend
+    // on the current working directory.
+    std::vector<std::unique_ptr<ScaleTool>> tools(setupFiles.size());
+    std::vector<const Model*> genericModels(setupFiles.size(), nullptr);
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<Model>>
+            loadedModels;
+    for (size_t i = 0; i < setupFiles.size(); ++i) {
+        results[i].setupFile = setupFiles[i];
+        try {
+            tools[i].reset(new ScaleTool(
+                    SimTK::Pathname::getAbsolutePathname(setupFiles[i])));
+            const ScaleTool& tool = *tools[i];
+            const GenericModelMaker& maker = tool.getGenericModelMaker();
+            std::string markerSetFile = maker.getMarkerSetFileName();
+            if (!markerSetFile.empty() && markerSetFile != "Unassigned") {
+                markerSetFile = SimTK::Pathname::
+                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                                tool.getPathToSubject(), markerSetFile);
+            }
+            const auto key = std::make_pair(
+                    SimTK::Pathname::
+                            getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                                    tool.getPathToSubject(),
+                                    maker.getModelFileName()),
+                    markerSetFile);
+            if (!loadedModels.count(key)) {
+                loadedModels[key].reset(tool.createModel());
+            }
+            genericModels[i] = loadedModels[key].get();
+        } catch (const std::exception& e) {
+            log_error("ScaleTool::runBatch: could not read '{}': {}",
+                    setupFiles[i], e.what());
+        }
+        if (tools[i] && !genericModels[i]) {
+            log_error("ScaleTool::runBatch: could not create the generic "
+                      "model for '{}'.", setupFiles[i]);
+        }
+    }
+    log_info("Scaling {} subject(s) with {} generic model(s).",
+            setupFiles.size(), loadedModels.size());
+
+    // Scale the subjects.
+    // -------------------
+    if (numThreads <= 0) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    numThreads = std::max(1, std::min(numThreads, (int)setupFiles.size()));
+    std::mutex cloneMutex;
+    std::atomic<size_t> next{0};
+    auto scale = [&]() {
+        for (size_t i = next++; i < setupFiles.size(); i = next++) {
+            if (!genericModels[i]) continue;
+            const ScaleTool& tool = *tools[i];
+            Stopwatch watch;
+            try {
+                std::unique_ptr<Model> model;
+                {
+                    std::lock_guard<std::mutex> lock(cloneMutex);
+                    model.reset(genericModels[i]->clone());
+                }
+                model->setName(tool.getName());
+                results[i].success = tool.processModel(model.get());
+            } catch (const std::exception& e) {
+                log_error("ScaleTool::runBatch: could not scale '{}': {}",
+                        setupFiles[i], e.what());
+            }
+            results[i].wallTime = watch.getElapsedTime();
+            log_info("Subject {} ({}) {} in {:.2f} s.", tool.getName(),
+                    setupFiles[i],
+                    results[i].success ? "scaled" : "failed",
+                    results[i].wallTime);
+        }
+    };
+    Stopwatch watch;
+    std::vector<std::future<void>> futures;
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        futures.push_back(std::async(std::launch::async, scale));
+    }
+    scale();
+    for (auto& future : futures) future.get();
+
+    int numSucceeded = 0;
+    for (const auto& result : results) {
+        if (result.success) ++numSucceeded;
+    }
+    log_info("Scaled {} of {} subject(s) in {:.2f} s.", numSucceeded,
+            results.size(), watch.getElapsedTime());
+    return results;
+}
+
+std::mutex& ScaleTool::getResultFilesMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
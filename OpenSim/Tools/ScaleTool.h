@@ -32,6 +32,11 @@
 #include "ModelScaler.h"
 #include "MarkerPlacer.h"
 
+#ifndef SWIG
+#include <mutex>
+#include <vector>
+#endif
+
 namespace OpenSim {
 
 class GenericModelMaker;
@@ -109,12 +114,53 @@ public:
     const MarkerPlacer& getMarkerPlacer() const
     { return _markerPlacer; }
 
+    ModelScaler& updModelScaler()
+    { return _modelScaler; }
+
+    MarkerPlacer& updMarkerPlacer()
+    { return _markerPlacer; }
+
     /** Run the scale tool. This first runs the ModelScaler, then runs the
      * MarkerPlacer. This is the method called by the command line `scale`
      * executable. 
      * @returns whether or not the scale procedure was successful. */
     bool run() const;
 
+    /** Run the ModelScaler and then the MarkerPlacer on `model`, which is
+     * modified in place. `model` should be the generic model created by
+     * createModel(); this allows scaling several subjects with copies of a
+     * generic model that is loaded only once (see runBatch()).
+     * @returns whether or not the scale procedure was successful. */
+    bool processModel(Model* model) const;
+
+#ifndef SWIG
+    /** The outcome of scaling one subject with runBatch(). */
+    struct BatchResult {
+        std::string setupFile;
+        bool success = false;
+        /** Wall time (seconds) spent scaling the subject, not including
+         * loading the generic model. */
+        double wallTime = SimTK::NaN;
+    };
+
+    /** Scale the subjects described by the ScaleTool setup files
+     * `setupFiles`, using up to `numThreads` threads (the number of hardware
+     * threads if not positive). Setup files that use the same generic model
+     * and marker set files share a single generic model, which is loaded
+     * once and copied for each subject. Each thread scales one subject at a
+     * time, reading all of the subject's files relative to the directory of
+     * its setup file. A subject that fails is logged and does not stop the
+     * other subjects. The wall time of each subject is logged.
+     * @returns the outcome of each subject, in the order of `setupFiles`. */
+    static std::vector<BatchResult> runBatch(
+            const std::vector<std::string>& setupFiles, int numThreads = 0);
+
+    /** ModelScaler and MarkerPlacer hold this mutex while writing their
+     * result files, because writing files may temporarily change the current
+     * working directory. */
+    static std::mutex& getResultFilesMutex();
+#endif
+
     bool isDefaultGenericModelMaker() const
     { return _genericModelMakerProp.getValueIsDefault(); }
     bool isDefaultModelScaler() const
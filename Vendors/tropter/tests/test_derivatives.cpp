@@ -876,4 +876,68 @@ TEST_CASE("ProblemDecorator sparsity_detection") {
     SparsityDetectionProblem<adouble>::run_test();
 }
 
+template<typename T>
+class ConcurrentSparseJacobian : public SparseJacobian<T> {
+public:
+    std::unique_ptr<Problem<T>> make_concurrent_copy() const override {
+        return std::unique_ptr<Problem<T>>(new ConcurrentSparseJacobian<T>());
+    }
+};
+
+TEST_CASE("Finite differences computed in parallel match serial") {
+    ConcurrentSparseJacobian<double> problem;
+    const unsigned num_vars = problem.get_num_variables();
+    const unsigned num_constr = problem.get_num_constraints();
+    VectorXd x(num_vars);
+    x << 3.1, -1.5, -0.25, 5.3;
+    VectorXd lambda(num_constr);
+    lambda << 0.5, 1.5, 2.5, 3.0, 0.19;
+    const double obj_factor = 0.7;
+
+    auto calc_derivatives = [&](int num_threads, VectorXd& gradient,
+                                    VectorXd& jacobian, VectorXd& hessian) {
+        auto decorator = problem.make_decorator();
+        decorator->set_findiff_num_threads(num_threads);
+        REQUIRE(decorator->get_findiff_num_threads() == num_threads);
+        SparsityCoordinates jac_sparsity, hes_sparsity;
+        decorator->calc_sparsity(decorator->make_initial_guess_from_bounds(),
+                jac_sparsity, true, hes_sparsity);
+        gradient.resize(num_vars);
+        decorator->calc_gradient(num_vars, x.data(), true, gradient.data());
+        jacobian.resize(jac_sparsity.row.size());
+        decorator->calc_jacobian(num_vars, x.data(), true,
+                (unsigned)jacobian.size(), jacobian.data());
+        hessian.resize(hes_sparsity.row.size());
+        decorator->calc_hessian_lagrangian(num_vars, x.data(), true,
+                obj_factor, num_constr, lambda.data(), true,
+                (unsigned)hessian.size(), hessian.data());
+    };
+
+    VectorXd serial_gradient, serial_jacobian, serial_hessian;
+    calc_derivatives(1, serial_gradient, serial_jacobian, serial_hessian);
+    for (int num_threads : {2, 3, 16}) {
+        INFO("num_threads: " << num_threads);
+        VectorXd gradient, jacobian, hessian;
+        calc_derivatives(num_threads, gradient, jacobian, hessian);
+        // The results must be identical, not just close.
+        REQUIRE(gradient == serial_gradient);
+        REQUIRE(jacobian == serial_jacobian);
+        REQUIRE(hessian == serial_hessian);
+    }
+
+    // Problems that cannot be copied are differentiated serially.
+    SparseJacobian<double> problem_without_copy;
+    auto decorator = problem_without_copy.make_decorator();
+    decorator->set_verbosity(0);
+    decorator->set_findiff_num_threads(3);
+    SparsityCoordinates jac_sparsity, hes_sparsity;
+    decorator->calc_sparsity(decorator->make_initial_guess_from_bounds(),
+            jac_sparsity, true, hes_sparsity);
+    VectorXd gradient(num_vars);
+    decorator->calc_gradient(num_vars, x.data(), true, gradient.data());
+    REQUIRE(gradient == serial_gradient);
+
+    REQUIRE_THROWS(decorator->set_findiff_num_threads(0));
+}
+
 // TODO add test_derivatives_optimal_control
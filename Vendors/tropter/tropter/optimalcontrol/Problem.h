@@ -19,6 +19,7 @@
 #include "Iterate.h"
 #include <tropter/common.h>
 #include <Eigen/Dense>
+#include <memory>
 
 namespace tropter {
 
@@ -407,6 +408,15 @@ public:
     /// to ensure determine which cost to compute.
     virtual void calc_cost_integrand(
             int cost_index, const Input<T>& in, T& integrand) const;
+    /// Create an independent copy of this problem that can be evaluated
+    /// concurrently with this problem (the copy must not share any working
+    /// memory with this problem). Implementing this function allows the
+    /// finite difference derivatives of the transcribed problem to be computed
+    /// in parallel; see
+    /// optimization::ProblemDecorator::set_findiff_num_threads(). The default
+    /// implementation returns nullptr.
+    virtual std::shared_ptr<const Problem<T>> make_concurrent_copy() const
+    {   return nullptr; }
     /// @}
 
     /// @name Helpers for setting an initial guess
@@ -80,6 +80,12 @@ public:
 
     void set_ocproblem(std::shared_ptr<const OCProblem> ocproblem);
 
+    /// The copy transcribes a concurrent copy of the optimal control problem
+    /// on the same mesh, or is nullptr if the optimal control problem does
+    /// not support concurrent evaluation.
+    std::unique_ptr<optimization::Problem<T>> make_concurrent_copy()
+            const override;
+
     void calc_objective(const VectorX<T>& x, T& obj_value) const override;
     void calc_constraints(const VectorX<T>& x,
         Eigen::Ref<VectorX<T>> constr) const override;
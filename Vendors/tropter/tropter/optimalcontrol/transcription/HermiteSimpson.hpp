@@ -318,6 +318,16 @@ void HermiteSimpson<T>::set_ocproblem(
     m_ocproblem->initialize_on_mesh(m_mesh_and_midpoints);
 }
 
+template <typename T>
+std::unique_ptr<optimization::Problem<T>>
+HermiteSimpson<T>::make_concurrent_copy() const {
+    auto ocproblem = m_ocproblem->make_concurrent_copy();
+    if (!ocproblem) return nullptr;
+    return std::unique_ptr<optimization::Problem<T>>(
+            new HermiteSimpson<T>(
+                    ocproblem, m_interpolate_control_midpoints, m_mesh));
+}
+
 template <typename T>
 void HermiteSimpson<T>::calc_objective(
         const VectorX<T>& x, T& obj_value) const {
@@ -215,6 +215,15 @@ void Trapezoidal<T>::set_ocproblem(std::shared_ptr<const OCProblem> ocproblem) {
     m_ocproblem->initialize_on_mesh(m_mesh_eigen);
 }
 
+template <typename T>
+std::unique_ptr<optimization::Problem<T>>
+Trapezoidal<T>::make_concurrent_copy() const {
+    auto ocproblem = m_ocproblem->make_concurrent_copy();
+    if (!ocproblem) return nullptr;
+    return std::unique_ptr<optimization::Problem<T>>(
+            new Trapezoidal<T>(ocproblem, m_mesh));
+}
+
 template <typename T>
 void Trapezoidal<T>::calc_objective(const VectorX<T>& x, T& obj_value) const {
     // TODO move this to a "make_variables_view()"
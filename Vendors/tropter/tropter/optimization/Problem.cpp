@@ -38,6 +38,11 @@ void ProblemDecorator::set_findiff_hessian_mode(std::string value) {
     m_findiff_hessian_mode = std::move(value);
 }
 
+void ProblemDecorator::set_findiff_num_threads(int value) {
+    TROPTER_VALUECHECK(value > 0, "findiff_num_threads", value, "positive");
+    m_findiff_num_threads = value;
+}
+
 // Explicit instantiation.
 
 template class Problem<double>;
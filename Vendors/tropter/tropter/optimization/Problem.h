@@ -71,6 +71,16 @@ public:
     std::unique_ptr<ProblemDecorator> make_decorator()
             const override final;
 
+    /// Create an independent copy of this problem whose objective and
+    /// constraint functions can be evaluated concurrently with those of this
+    /// problem (that is, the copy must not share any working memory with this
+    /// problem). The Decorator uses these copies to compute finite difference
+    /// derivatives in parallel; see
+    /// ProblemDecorator::set_findiff_num_threads(). The default implementation
+    /// returns nullptr, which means the derivatives are computed serially.
+    virtual std::unique_ptr<Problem<T>> make_concurrent_copy() const
+    {   return nullptr; }
+
     // TODO can override to provide custom derivatives.
     //virtual void gradient(const std::vector<T>& x, std::vector<T>& grad) const;
     //virtual void jacobian(const std::vector<T>& x, TODO) const;
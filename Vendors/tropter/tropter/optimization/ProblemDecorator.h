@@ -114,10 +114,19 @@ public:
     ///  - "slow": Slower mode to be used only for debugging. Each nonzero of
     ///    the Hessian of the Lagrangian is computed separately.
     void set_findiff_hessian_mode(std::string value);
+    /// The number of threads used to compute the gradient, Jacobian, and
+    /// Hessian with finite differences (default: 1). Each thread perturbs its
+    /// own copy of the problem, so this only takes effect if the problem
+    /// implements Problem::make_concurrent_copy(); otherwise, the derivatives
+    /// are computed serially. The derivatives do not depend on the number of
+    /// threads.
+    void set_findiff_num_threads(int value);
     /// @copydoc set_findiff_hessian_step_size()
     double get_findiff_hessian_step_size() const;
     /// @copydoc set_findiff_hessian_mode()
     const std::string& get_findiff_hessian_mode() const;
+    /// @copydoc set_findiff_num_threads()
+    int get_findiff_num_threads() const;
     /// @}
 
 protected:
@@ -128,6 +137,7 @@ private:
     int m_verbosity = 1;
     double m_findiff_hessian_step_size = 1e-5;
     std::string m_findiff_hessian_mode = "fast";
+    int m_findiff_num_threads = 1;
 };
 
 inline int ProblemDecorator::get_verbosity() const
@@ -136,6 +146,8 @@ inline double ProblemDecorator::get_findiff_hessian_step_size() const
 {   return m_findiff_hessian_step_size; }
 inline const std::string& ProblemDecorator::get_findiff_hessian_mode() const
 {   return m_findiff_hessian_mode; }
+inline int ProblemDecorator::get_findiff_num_threads() const
+{   return m_findiff_num_threads; }
 template<typename ...Types>
 inline void ProblemDecorator::print(
         const std::string& format_string, Types... args) const {
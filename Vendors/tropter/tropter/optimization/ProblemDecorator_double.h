@@ -21,6 +21,8 @@
 
 #include <tropter/SparsityPattern.h>
 
+#include <mutex>
+
 namespace tropter {
 
 namespace optimization {
@@ -83,8 +85,25 @@ private:
             const Eigen::Map<const Eigen::VectorXd>& lambda,
             double& lagrangian_value) const;
 
+    /// The number of threads to use for a loop with num_items iterations.
+    /// This creates the concurrent copies of the problem, if necessary.
+    int get_num_workers(int num_items) const;
+    /// Split [0, num_items) into contiguous ranges, one for each worker, and
+    /// invoke func(problem, begin, end) for each range. The first range is
+    /// evaluated on the calling thread with the original problem, and the
+    /// other ranges are evaluated on their own threads with the concurrent
+    /// copies of the problem.
+    template <typename F>
+    void for_each_range(int num_items, F&& func) const;
+
     const Problem<double>& m_problem;
 
+    // Copies of the problem used by the additional threads when computing
+    // finite differences in parallel (see set_findiff_num_threads()).
+    mutable std::vector<std::unique_ptr<Problem<double>>>
+            m_concurrent_problems;
+    mutable bool m_concurrent_copy_unavailable = false;
+
     // Working memory shared by multiple functions.
     mutable Eigen::VectorXd m_x_working;
 
@@ -105,9 +124,6 @@ private:
     // differences.
     mutable std::unique_ptr<JacobianColoring> m_jacobian_coloring;
     // Working memory.
-    // TODO this could be a column vector unless we are using parallelization.
-    mutable Eigen::VectorXd m_constr_pos;
-    mutable Eigen::VectorXd m_constr_neg;
     mutable Eigen::MatrixXd m_jacobian_compressed;
 
     // Hessian/Lagrangian.
@@ -119,11 +135,14 @@ private:
     mutable SparsityCoordinates m_hesobj_indices;
     // Only set if using the slow Hessian approximation.
     mutable SparsityCoordinates m_hessian_indices;
+    // The variables that are perturbed individually when computing the
+    // Hessian of the objective.
+    mutable std::vector<unsigned int> m_hesobj_perturbed_indices;
     // Working memory.
     // mutable Eigen::VectorXd m_constr_working;
-    mutable Eigen::Matrix<bool, Eigen::Dynamic, 1>
-            m_perturbed_objective_is_cached;
     mutable Eigen::VectorXd m_perturbed_objective_cache;
+    // JacobianColoring::recover() uses working memory.
+    mutable std::mutex m_jacobian_recover_mutex;
 
     // Deprecated.
     void calc_hessian_lagrangian_slow(unsigned num_variables,
@@ -104,6 +104,8 @@ public:
     void set_findiff_hessian_mode(std::string v);
     /// @copydoc ProblemDecorator::set_findiff_hessian_step_size()
     void set_findiff_hessian_step_size(double value);
+    /// @copydoc ProblemDecorator::set_findiff_num_threads()
+    void set_findiff_num_threads(int value);
     /// @}
 
     /// @name Set solver-specific advanced options.